@@ -0,0 +1,35 @@
+#!/bin/bash
+# Run Nomad twice on the same problem: the first run writes a binary history
+# file, the second run a text history file. The binary history file is
+# converted with nomad_history and compared to the text history file.
+
+# Argument #1: path to Nomad install dir
+
+$1/bin/nomad param.txt || exit 1
+$1/bin/nomad param_text.txt > /dev/null || exit 1
+
+$1/bin/nomad_history history.bin --info || exit 1
+$1/bin/nomad_history history.bin > history_from_bin.txt || exit 1
+
+# Same records, same values
+awk 'NR == FNR { line[FNR] = $0; n = FNR; next }
+     {
+         if (FNR > n) { print "Extra record " FNR; exit 1 }
+         nb = split(line[FNR], v, " ");
+         if (nb != NF) { print "Record " FNR ": " nb " values instead of " NF; exit 1 }
+         for (i = 1; i <= NF; i++)
+         {
+             d = v[i] - $i; if (d < 0) d = -d;
+             a = $i; if (a < 0) a = -a; if (a < 1) a = 1;
+             if (d > 1e-12 * a) { print "Record " FNR ": " v[i] " instead of " $i; exit 1 }
+         }
+         nbRecords = FNR
+     }
+     END { if (nbRecords != n) { print nbRecords " records instead of " n; exit 1 } }' history_from_bin.txt history.txt || exit 1
+
+# A slice: records 10 to 14, first coordinate and objective, in CSV
+$1/bin/nomad_history history.bin --csv --first 10 --count 5 --columns 0,3 || exit 1
+
+rm -f history.bin history.txt history_from_bin.txt
+echo "The binary history file matches the text history file."
+exit 0
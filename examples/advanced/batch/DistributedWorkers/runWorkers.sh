@@ -0,0 +1,24 @@
+#!/bin/bash
+# Run Nomad with evaluations distributed on three nomad_worker daemons.
+# One worker is killed during the optimization: its evaluations are sent
+# to the other workers.
+
+# Argument #1: path to Nomad install dir
+
+for i in 1 2 3
+do
+    $1/bin/nomad_worker unix:/tmp/nomad_example_worker.$i.sock --bb-exe ./bb_worker.exe &
+    workers[$i]=$!
+done
+sleep 1
+
+# Lose worker 1 after a while
+( sleep 1; kill -9 ${workers[1]} 2> /dev/null ) &
+
+$1/bin/nomad param.txt
+status=$?
+
+kill ${workers[1]} ${workers[2]} ${workers[3]} 2> /dev/null
+{ wait; } 2> /dev/null
+rm -f /tmp/nomad_example_worker.[1-3].sock
+exit $status
@@ -0,0 +1,36 @@
+#!/bin/bash
+# Run Nomad with a metrics file, and check the latency histograms and the
+# queue depth in the metrics file and in the detailed stats.
+
+# Argument #1: path to Nomad install dir
+
+rm -f metrics.txt detailedStats.txt
+$1/bin/nomad param.txt || exit 1
+
+if [ ! -f metrics.txt ] || [ ! -f detailedStats.txt ]
+then
+    echo "The metrics file or the detailed stats file is not written."
+    exit 1
+fi
+
+# Last metrics of the blackbox evaluations
+last=`grep "eval_type=BB main_thread=0" metrics.txt | tail -1`
+echo "$last"
+for key in evals latency_p50 latency_p99 queue_wait_p50 block_size_mean queue_depth_max
+do
+    echo "$last" | grep -q " $key=" || { echo "No $key in the metrics file."; exit 1; }
+done
+evals=`echo "$last" | sed -e 's/.* evals=\([0-9]*\) .*/\1/'`
+if [ "$evals" -lt 200 ]
+then
+    echo "$evals blackbox evaluations in the metrics file instead of at least 200."
+    exit 1
+fi
+grep -q "eval_thread=1 utilization=" metrics.txt || { echo "No utilization of evaluation thread 1."; exit 1; }
+
+grep "Evaluation latency per point (BB, main thread 0)" detailedStats.txt || { echo "No latency in the detailed stats."; exit 1; }
+grep "Evaluation thread utilization" detailedStats.txt || { echo "No utilization in the detailed stats."; exit 1; }
+
+rm -f metrics.txt detailedStats.txt
+echo "The metrics are complete."
+exit 0
@@ -0,0 +1,25 @@
+#!/bin/bash
+# Run Nomad with the lock contention report, and check that the main locks
+# are in the report.
+
+# Argument #1: path to Nomad install dir
+
+$1/bin/nomad param.txt > runLog.txt 2>&1 || { cat runLog.txt; exit 1; }
+
+grep -A100 "Lock contention report" runLog.txt > report.txt
+if [ ! -s report.txt ]
+then
+    echo "No lock contention report."
+    rm -f runLog.txt report.txt
+    exit 1
+fi
+cat report.txt
+
+for lock in evalQueueLock cacheLock s_queue_lock "critical(evalBlockOutput)"
+do
+    grep -q -F "$lock" report.txt || { echo "No $lock in the report."; rm -f runLog.txt report.txt; exit 1; }
+done
+
+rm -f runLog.txt report.txt
+echo "The lock contention report is complete."
+exit 0
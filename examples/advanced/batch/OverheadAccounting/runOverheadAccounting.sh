@@ -0,0 +1,41 @@
+#!/bin/bash
+# Run Nomad with the overhead accounting, and check the report, the stats file
+# and the detailed stats.
+
+# Argument #1: path to Nomad install dir
+
+cleanup()
+{
+    rm -f runLog.txt report.txt stats.0.txt detailedStats.0.txt
+}
+
+$1/bin/nomad param.txt > runLog.txt 2>&1 || { cat runLog.txt; cleanup; exit 1; }
+
+grep -A100 "Overhead accounting report" runLog.txt > report.txt
+if [ ! -s report.txt ]
+then
+    echo "No overhead accounting report."
+    cleanup
+    exit 1
+fi
+cat report.txt
+
+for step in "Overhead per evaluation" "Evaluator control" "Poll"
+do
+    grep -q -F "$step" report.txt || { echo "No $step in the report."; cleanup; exit 1; }
+done
+
+# The second column of the stats file is the overhead per evaluation.
+if ! awk '{ if ($2 !~ /^[0-9.eE+-]+$/) exit 1 }' stats.0.txt
+then
+    echo "The overhead is not a number in the stats file."
+    head stats.0.txt
+    cleanup
+    exit 1
+fi
+
+grep -q "Algorithmic overhead per evaluation" detailedStats.0.txt || { echo "No overhead in the detailed stats."; cleanup; exit 1; }
+
+cleanup
+echo "The overhead accounting is reported."
+exit 0
@@ -0,0 +1,41 @@
+#!/bin/bash
+# Run Nomad with a trace file, and check that the trace holds the steps, the
+# evaluations, the cache operations and the model builds.
+
+# Argument #1: path to Nomad install dir
+
+rm -f trace.json
+$1/bin/nomad param.txt || exit 1
+
+if [ ! -f trace.json ]
+then
+    echo "The trace file is not written."
+    exit 1
+fi
+
+head -c 16 trace.json | grep -q '{"traceEvents":\[' || { echo "Not a Chrome trace file."; exit 1; }
+
+# Number of events of each kind
+for name in '"name":"MADS"' '"name":"Evaluation of a block"' '"name":"Cache insert"' '"name":"Quad model build"' '"name":"thread_name"'
+do
+    nb=`grep -c "$name" trace.json`
+    echo "$name: $nb"
+    if [ $nb -eq 0 ]
+    then
+        echo "No event $name in the trace file."
+        exit 1
+    fi
+done
+
+# Each begin has its end
+nbBegin=`grep -c '"ph":"B"' trace.json`
+nbEnd=`grep -c '"ph":"E"' trace.json`
+if [ $nbBegin -ne $nbEnd ]
+then
+    echo "$nbBegin begin events and $nbEnd end events."
+    exit 1
+fi
+
+rm -f trace.json
+echo "The trace file is complete."
+exit 0
@@ -0,0 +1,194 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*  Example of asynchronous display (DISPLAY_ASYNC)                          */
+/*                                                                          */
+/*  The same problem is solved with the usual display and with the          */
+/*  asynchronous display. The display is verbose and the queue is small:    */
+/*  some messages are dropped. The stats lines are never dropped: the two   */
+/*  stats files must be the same.                                           */
+/*--------------------------------------------------------------------------*/
+#include "Nomad/nomad.hpp"
+
+#include <fstream>
+#include <sstream>
+
+
+/*----------------------------------------*/
+/*               The problem              */
+/*----------------------------------------*/
+class My_Evaluator : public NOMAD::Evaluator
+{
+public:
+    explicit My_Evaluator(const std::shared_ptr<NOMAD::EvalParameters>& evalParams)
+    : NOMAD::Evaluator(evalParams, NOMAD::EvalType::BB)
+    {}
+
+    ~My_Evaluator() override = default;
+
+    bool eval_x(NOMAD::EvalPoint &x, const NOMAD::Double &hMax, bool &countEval) const override;
+};
+
+
+/*----------------------------------------*/
+/*           user-defined eval_x          */
+/*----------------------------------------*/
+bool My_Evaluator::eval_x(NOMAD::EvalPoint &x,
+                          const NOMAD::Double &hMax,
+                          bool &countEval) const
+{
+    NOMAD::Double f = 0.0, c = -2.0;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        f += (x[i] - 1).pow2() + 0.5 * x[i] * (i + 1);
+        c += x[i];
+    }
+    x.setBBO(f.tostring() + " " + c.tostring());
+
+    countEval = true; // count a black-box evaluation
+
+    return true;       // the evaluation succeeded
+}
+
+
+void initAllParams(const std::shared_ptr<NOMAD::AllParameters>& allParams, const bool async, const std::string& statsFile)
+{
+    const size_t n = 4;
+
+    allParams->setAttributeValue("DIMENSION", n);
+    allParams->setAttributeValue("X0", NOMAD::Point(n, 0.0));
+    allParams->setAttributeValue("LOWER_BOUND", NOMAD::ArrayOfDouble(n, -5.0));
+    allParams->setAttributeValue("UPPER_BOUND", NOMAD::ArrayOfDouble(n, 5.0));
+
+    NOMAD::BBOutputTypeList bbOutputTypes;
+    bbOutputTypes.push_back(NOMAD::BBOutputType::OBJ);
+    bbOutputTypes.push_back(NOMAD::BBOutputType::PB);
+    allParams->setAttributeValue("BB_OUTPUT_TYPE", bbOutputTypes);
+
+    allParams->setAttributeValue("MAX_BB_EVAL", 100);
+
+    allParams->setAttributeValue("DISPLAY_STATS", NOMAD::ArrayOfString("BBE ( SOL ) OBJ CONS_H"));
+    allParams->setAttributeValue("STATS_FILE", NOMAD::ArrayOfString(statsFile + " BBE SOL OBJ CONS_H"));
+    allParams->setAttributeValue("DISPLAY_ALL_EVAL", true);
+    allParams->setAttributeValue("ADD_SEED_TO_FILE_NAMES", false);
+
+    // Verbose display
+    allParams->setAttributeValue("DISPLAY_DEGREE", 3);
+    allParams->setAttributeValue("DISPLAY_MAX_STEP_LEVEL", 3);
+
+    if (async)
+    {
+        // Small queue: the information messages that do not fit in the queue
+        // are dropped.
+        allParams->setAttributeValue("DISPLAY_ASYNC", true);
+        allParams->setAttributeValue("DISPLAY_ASYNC_BUFFER_SIZE", 16);
+    }
+
+    allParams->checkAndComply();
+}
+
+
+void solve(const bool async, const std::string& statsFile)
+{
+    auto TheMainStep = std::make_unique<NOMAD::MainStep>();
+
+    auto params = std::make_shared<NOMAD::AllParameters>();
+    initAllParams(params, async, statsFile);
+    TheMainStep->setAllParameters(params);
+
+    auto ev = std::make_unique<My_Evaluator>(params->getEvalParams());
+    TheMainStep->addEvaluator(std::move(ev));
+
+    TheMainStep->start();
+    TheMainStep->run();
+    TheMainStep->end();
+
+    // Start the next run with an empty cache and new counters.
+    NOMAD::MainStep::resetComponentsBetweenOptimization();
+}
+
+
+std::string readFile(const std::string& fileName)
+{
+    std::ifstream in(fileName);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+
+/*------------------------------------------*/
+/*            NOMAD main function           */
+/*------------------------------------------*/
+int main(int argc, char ** argv)
+{
+    try
+    {
+        solve(false, "statsSync.txt");
+        solve(true, "statsAsync.txt");
+
+        // Close the stats file of the last run.
+        NOMAD::OutputQueue::getInstance()->reset();
+
+        const std::string statsSync = readFile("statsSync.txt");
+        const std::string statsAsync = readFile("statsAsync.txt");
+        if (statsSync.empty() || statsSync != statsAsync)
+        {
+            std::cout << "Error: the stats files are different." << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "The stats files are the same." << std::endl;
+    }
+
+    catch(std::exception &e)
+    {
+        std::cerr << "\nNOMAD has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,195 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*  Example of deterministic parallel evaluations (DETERMINISTIC_PARALLEL)  */
+/*                                                                          */
+/*  The evaluation time of the blackbox is random, so the evaluations      */
+/*  complete in a different order at each run. The same problem is solved  */
+/*  with 1 and with NB_THREADS evaluation threads. The trajectories must be */
+/*  the same: same number of evaluations and same best point.               */
+/*--------------------------------------------------------------------------*/
+#include "Nomad/nomad.hpp"
+#include "Algos/EvcInterface.hpp"
+#include "Cache/CacheBase.hpp"
+
+#include <chrono>
+#include <random>
+#include <thread>
+
+#define NB_THREADS 4
+
+
+/*----------------------------------------*/
+/*               The problem              */
+/*----------------------------------------*/
+class My_Evaluator : public NOMAD::Evaluator
+{
+public:
+    explicit My_Evaluator(const std::shared_ptr<NOMAD::EvalParameters>& evalParams)
+    : NOMAD::Evaluator(evalParams, NOMAD::EvalType::BB)
+    {}
+
+    ~My_Evaluator() override = default;
+
+    bool eval_x(NOMAD::EvalPoint &x, const NOMAD::Double &hMax, bool &countEval) const override;
+};
+
+
+/*----------------------------------------*/
+/*           user-defined eval_x          */
+/*----------------------------------------*/
+bool My_Evaluator::eval_x(NOMAD::EvalPoint &x,
+                          const NOMAD::Double &hMax,
+                          bool &countEval) const
+{
+    // Random evaluation time between 0 and 10 ms.
+    thread_local std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<int> dist(0, 10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(dist(gen)));
+
+    NOMAD::Double f = 0.0, c = -2.0;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        f += (x[i] - 1).pow2() + 0.5 * x[i] * (i + 1);
+        c += x[i];
+    }
+    x.setBBO(f.tostring() + " " + c.tostring());
+
+    countEval = true; // count a black-box evaluation
+
+    return true;       // the evaluation succeeded
+}
+
+
+void initAllParams(const std::shared_ptr<NOMAD::AllParameters>& allParams, const int nbThreads)
+{
+    const size_t n = 4;
+
+    allParams->setAttributeValue("DIMENSION", n);
+    allParams->setAttributeValue("X0", NOMAD::Point(n, 0.0));
+    allParams->setAttributeValue("LOWER_BOUND", NOMAD::ArrayOfDouble(n, -5.0));
+    allParams->setAttributeValue("UPPER_BOUND", NOMAD::ArrayOfDouble(n, 5.0));
+
+    NOMAD::BBOutputTypeList bbOutputTypes;
+    bbOutputTypes.push_back(NOMAD::BBOutputType::OBJ);
+    bbOutputTypes.push_back(NOMAD::BBOutputType::PB);
+    allParams->setAttributeValue("BB_OUTPUT_TYPE", bbOutputTypes);
+
+    allParams->setAttributeValue("MAX_BB_EVAL", 150);
+
+    // Opportunistic evaluations: with several threads, the points evaluated
+    // after a success are discarded.
+    allParams->setAttributeValue("NB_THREADS_PARALLEL_EVAL", nbThreads);
+    allParams->setAttributeValue("DETERMINISTIC_PARALLEL", true);
+
+    allParams->setAttributeValue("DISPLAY_DEGREE", 2);
+    allParams->setAttributeValue("DISPLAY_STATS", NOMAD::ArrayOfString("BBE ( SOL ) OBJ CONS_H"));
+
+    allParams->checkAndComply();
+}
+
+
+/// Solve the problem with the given number of threads. Get the number of evaluations and the best point.
+void solve(const int nbThreads, size_t& bbe, NOMAD::EvalPoint& bestPoint)
+{
+    auto TheMainStep = std::make_unique<NOMAD::MainStep>();
+
+    auto params = std::make_shared<NOMAD::AllParameters>();
+    initAllParams(params, nbThreads);
+    TheMainStep->setAllParameters(params);
+
+    auto ev = std::make_unique<My_Evaluator>(params->getEvalParams());
+    TheMainStep->addEvaluator(std::move(ev));
+
+    TheMainStep->start();
+    TheMainStep->run();
+
+    bbe = NOMAD::EvcInterface::getEvaluatorControl()->getBbEval();
+    std::vector<NOMAD::EvalPoint> bestFeasList;
+    NOMAD::CacheBase::getInstance()->findBestFeas(bestFeasList);
+    if (!bestFeasList.empty())
+    {
+        bestPoint = bestFeasList[0];
+    }
+
+    TheMainStep->end();
+
+    // Start the next run with an empty cache and new counters.
+    NOMAD::MainStep::resetComponentsBetweenOptimization();
+}
+
+
+/*------------------------------------------*/
+/*            NOMAD main function           */
+/*------------------------------------------*/
+int main(int argc, char ** argv)
+{
+    try
+    {
+        size_t bbe1 = 0, bbeN = 0;
+        NOMAD::EvalPoint best1, bestN;
+        solve(1, bbe1, best1);
+        solve(NB_THREADS, bbeN, bestN);
+
+        std::cout << "1 thread:  " << bbe1 << " evaluations, best point " << best1.display() << std::endl;
+        std::cout << NB_THREADS << " threads: " << bbeN << " evaluations, best point " << bestN.display() << std::endl;
+
+        if (bbe1 != bbeN || best1.getX() == nullptr || bestN.getX() == nullptr || *best1.getX() != *bestN.getX())
+        {
+            std::cout << "Error: the trajectories are different." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    catch(std::exception &e)
+    {
+        std::cerr << "\nNOMAD has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
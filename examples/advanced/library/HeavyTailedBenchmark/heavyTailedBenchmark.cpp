@@ -0,0 +1,210 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*  Benchmark of the parallel evaluation with heavy-tailed evaluation times */
+/*                                                                          */
+/*  The evaluation time of a point is drawn from a Pareto distribution: most*/
+/*  evaluations are short, a few are very long. The same problem is solved  */
+/*  with 1 and with NB_THREADS evaluation threads. The parallel efficiency  */
+/*  is the sequential time divided by NB_THREADS times the parallel time.   */
+/*--------------------------------------------------------------------------*/
+#include "Nomad/nomad.hpp"
+#include "Algos/EvcInterface.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+
+#define NB_THREADS 4
+
+
+/*----------------------------------------*/
+/*               The problem              */
+/*----------------------------------------*/
+class My_Evaluator : public NOMAD::Evaluator
+{
+private:
+    mutable std::atomic<double> _totalEvalTime;     ///< Sum of the evaluation times, in seconds
+
+public:
+    explicit My_Evaluator(const std::shared_ptr<NOMAD::EvalParameters>& evalParams)
+    : NOMAD::Evaluator(evalParams, NOMAD::EvalType::BB),
+      _totalEvalTime(0.0)
+    {}
+
+    ~My_Evaluator() override = default;
+
+    bool eval_x(NOMAD::EvalPoint &x, const NOMAD::Double &hMax, bool &countEval) const override;
+
+    double getTotalEvalTime() const { return _totalEvalTime; }
+};
+
+
+/*----------------------------------------*/
+/*           user-defined eval_x          */
+/*----------------------------------------*/
+bool My_Evaluator::eval_x(NOMAD::EvalPoint &x,
+                          const NOMAD::Double &hMax,
+                          bool &countEval) const
+{
+    const size_t n = x.size();
+
+    // The evaluation time depends on the point only, for reproducibility.
+    // Pareto distribution with scale 5 ms and shape 1.2, capped to 1 s.
+    size_t seed = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        seed = seed * 31 + std::hash<double>()(x[i].todouble());
+    }
+    std::mt19937 gen(static_cast<unsigned int>(seed));
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const double u = uniform(gen);
+    const double evalTime = std::min(1.0, 0.005 / std::pow(1.0 - u, 1.0 / 1.2));
+    std::this_thread::sleep_for(std::chrono::duration<double>(evalTime));
+
+    double oldTotal = _totalEvalTime;
+    while (!_totalEvalTime.compare_exchange_weak(oldTotal, oldTotal + evalTime));
+
+    // Rosenbrock function
+    NOMAD::Double f = 0.0;
+    for (size_t i = 0; i < n - 1; i++)
+    {
+        f += 100 * (x[i+1] - x[i].pow2()).pow2() + (1 - x[i]).pow2();
+    }
+    x.setBBO(f.tostring());
+
+    countEval = true; // count a black-box evaluation
+
+    return true;       // the evaluation succeeded
+}
+
+
+void initAllParams(const std::shared_ptr<NOMAD::AllParameters>& allParams, const int nbThreads)
+{
+    const size_t n = 4;
+
+    allParams->setAttributeValue("DIMENSION", n);
+    allParams->setAttributeValue("X0", NOMAD::Point(n, 0.5));
+    allParams->setAttributeValue("LOWER_BOUND", NOMAD::ArrayOfDouble(n, -2.0));
+    allParams->setAttributeValue("UPPER_BOUND", NOMAD::ArrayOfDouble(n, 2.0));
+
+    NOMAD::BBOutputTypeList bbOutputTypes;
+    bbOutputTypes.push_back(NOMAD::BBOutputType::OBJ);
+    allParams->setAttributeValue("BB_OUTPUT_TYPE", bbOutputTypes);
+
+    allParams->setAttributeValue("MAX_BB_EVAL", 200);
+
+    // All the poll points are evaluated: 2n points per iteration,
+    // two per evaluation thread.
+    allParams->setAttributeValue("DIRECTION_TYPE", NOMAD::DirectionType::ORTHO_2N);
+    allParams->setAttributeValue("EVAL_OPPORTUNISTIC", false);
+    allParams->setAttributeValue("SPECULATIVE_SEARCH", false);
+    allParams->setAttributeValue("NM_SEARCH", false);
+    allParams->setAttributeValue("QUAD_MODEL_SEARCH", false);
+
+    allParams->setAttributeValue("NB_THREADS_PARALLEL_EVAL", nbThreads);
+
+    allParams->setAttributeValue("DISPLAY_DEGREE", 0);
+
+    allParams->checkAndComply();
+}
+
+
+/// Solve the problem with the given number of threads. Return the wall-clock time in seconds.
+double solve(const int nbThreads, double& totalEvalTime)
+{
+    auto TheMainStep = std::make_unique<NOMAD::MainStep>();
+
+    auto params = std::make_shared<NOMAD::AllParameters>();
+    initAllParams(params, nbThreads);
+    TheMainStep->setAllParameters(params);
+
+    auto ev = std::make_unique<My_Evaluator>(params->getEvalParams());
+    const My_Evaluator* evPtr = ev.get();
+    TheMainStep->addEvaluator(std::move(ev));
+
+    const auto start = std::chrono::steady_clock::now();
+    TheMainStep->start();
+    TheMainStep->run();
+    const std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - start;
+
+    totalEvalTime = evPtr->getTotalEvalTime();
+    TheMainStep->end();
+
+    // Start the next run with an empty cache and new counters.
+    NOMAD::MainStep::resetComponentsBetweenOptimization();
+
+    return wallTime.count();
+}
+
+
+/*------------------------------------------*/
+/*            NOMAD main function           */
+/*------------------------------------------*/
+int main(int argc, char ** argv)
+{
+    try
+    {
+        double totalEvalTime = 0.0;
+        const double seqTime = solve(1, totalEvalTime);
+        std::cout << "1 thread:   wall-clock time " << seqTime << " s, evaluation time " << totalEvalTime << " s" << std::endl;
+
+        const double parTime = solve(NB_THREADS, totalEvalTime);
+        std::cout << NB_THREADS << " threads:  wall-clock time " << parTime << " s, evaluation time " << totalEvalTime << " s" << std::endl;
+
+        std::cout << "Parallel efficiency: " << seqTime / (NB_THREADS * parTime) << std::endl;
+    }
+
+    catch(std::exception &e)
+    {
+        std::cerr << "\nNOMAD has been interrupted (" << e.what() << ")\n\n";
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*  Example of a blackbox evaluated on blocks given as matrices             */
+/*                                                                          */
+/*  The evaluator derives from NOMAD::MatrixEvaluator: the points of a      */
+/*  block are a contiguous row-major matrix, and the outputs are written    */
+/*  in a contiguous row-major matrix. The loops below work on whole         */
+/*  columns and can be vectorized by the compiler.                          */
+/*--------------------------------------------------------------------------*/
+#include "Nomad/nomad.hpp"
+#include "Eval/MatrixEvaluator.hpp"
+
+#include <vector>
+
+
+/*----------------------------------------*/
+/*               The problem              */
+/*----------------------------------------*/
+class My_Evaluator : public NOMAD::MatrixEvaluator
+{
+public:
+    explicit My_Evaluator(const std::shared_ptr<NOMAD::EvalParameters>& evalParams)
+    : NOMAD::MatrixEvaluator(evalParams, NOMAD::EvalType::BB)
+    {}
+
+    ~My_Evaluator() override = default;
+
+    void eval_matrix(const size_t nbPoints,
+                     const size_t nbInputs,
+                     const double *inputs,
+                     const size_t nbOutputs,
+                     double *outputs,
+                     bool *evalOk,
+                     bool *countEval) const override;
+};
+
+
+/*----------------------------------------*/
+/*        user-defined eval_matrix        */
+/*----------------------------------------*/
+// f = sum_i (x_i - 1)^2 + 0.5 (i+1) x_i, c = sum_i x_i - 2 <= 0
+void My_Evaluator::eval_matrix(const size_t nbPoints,
+                               const size_t nbInputs,
+                               const double *inputs,
+                               const size_t nbOutputs,
+                               double *outputs,
+                               bool *evalOk,
+                               bool *countEval) const
+{
+    std::vector<double> f(nbPoints, 0.0), c(nbPoints, -2.0);
+    for (size_t i = 0; i < nbInputs; i++)
+    {
+        const double w = 0.5 * static_cast<double>(i + 1);
+        for (size_t k = 0; k < nbPoints; k++)
+        {
+            const double xi = inputs[k * nbInputs + i];
+            f[k] += (xi - 1.0) * (xi - 1.0) + w * xi;
+            c[k] += xi;
+        }
+    }
+
+    for (size_t k = 0; k < nbPoints; k++)
+    {
+        outputs[k * nbOutputs]     = f[k];
+        outputs[k * nbOutputs + 1] = c[k];
+        evalOk[k] = true;       // the evaluation succeeded
+        countEval[k] = true;    // count a black-box evaluation
+    }
+}
+
+
+void initAllParams(const std::shared_ptr<NOMAD::AllParameters>& allParams)
+{
+    const size_t n = 4;
+
+    allParams->setAttributeValue("DIMENSION", n);
+    allParams->setAttributeValue("X0", NOMAD::Point(n, 0.0));
+    allParams->setAttributeValue("LOWER_BOUND", NOMAD::ArrayOfDouble(n, -5.0));
+    allParams->setAttributeValue("UPPER_BOUND", NOMAD::ArrayOfDouble(n, 5.0));
+
+    NOMAD::BBOutputTypeList bbOutputTypes;
+    bbOutputTypes.push_back(NOMAD::BBOutputType::OBJ);
+    bbOutputTypes.push_back(NOMAD::BBOutputType::PB);
+    allParams->setAttributeValue("BB_OUTPUT_TYPE", bbOutputTypes);
+
+    allParams->setAttributeValue("MAX_BB_EVAL", 500);
+
+    // The poll points are evaluated in blocks of 8.
+    allParams->setAttributeValue("BB_MAX_BLOCK_SIZE", 8);
+
+    allParams->setAttributeValue("DISPLAY_DEGREE", 2);
+    allParams->setAttributeValue("DISPLAY_STATS", NOMAD::ArrayOfString("BBE ( SOL ) OBJ CONS_H"));
+
+    allParams->checkAndComply();
+}
+
+
+/*------------------------------------------*/
+/*            NOMAD main function           */
+/*------------------------------------------*/
+int main(int argc, char ** argv)
+{
+    auto TheMainStep = std::make_unique<NOMAD::MainStep>();
+
+    auto params = std::make_shared<NOMAD::AllParameters>();
+    initAllParams(params);
+    TheMainStep->setAllParameters(params);
+
+    auto ev = std::make_unique<My_Evaluator>(params->getEvalParams());
+    TheMainStep->addEvaluator(std::move(ev));
+
+    try
+    {
+        TheMainStep->start();
+        TheMainStep->run();
+        TheMainStep->end();
+    }
+
+    catch(std::exception &e)
+    {
+        std::cerr << "\nNOMAD has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -48,6 +48,7 @@
 
 #include "Algos/EvcInterface.hpp"
 #include "Cache/CacheBase.hpp"
+#include "Eval/MatrixEvaluator.hpp"
 #include "Math/RNG.hpp"
 #include "Nomad/nomad.hpp"
 #include "Param/AllParameters.hpp"
@@ -470,7 +471,7 @@ public:
     }
 };
 
-class CInterfaceEvalBlock : public NOMAD::Evaluator
+class CInterfaceEvalBlock : public NOMAD::MatrixEvaluator
 {
 private:
     Callback_BB_single _bb_single;
@@ -489,7 +490,7 @@ public:
                         const int nbOutputs,
                         const bool hasSgte,
                         NomadUserDataPtr user_data_ptr)
-            : NOMAD::Evaluator(evalParams, NOMAD::EvalType::BB),
+            : NOMAD::MatrixEvaluator(evalParams, NOMAD::EvalType::BB),
               _bb_single(bb_single),
               _bb_block(bb_block),
               _nbInputs(nbInputs),
@@ -546,54 +547,22 @@ public:
         return eval_ok;
     }
 
-    std::vector<bool> eval_block(std::vector<std::shared_ptr<NOMAD::EvalPoint>> &block,
-                                 const NOMAD::Double& hMax,
-                                 std::vector<bool> &countEval) const override
+    // The matrices of the block are passed to the callback without copies.
+    void eval_matrix(const size_t nbPoints,
+                     const size_t nbInputs,
+                     const double *inputs,
+                     const size_t nbOutputs,
+                     double *outputs,
+                     bool *evalOk,
+                     bool *countEval) const override
     {
-        const int block_size = (int)block.size();
-        std::vector<bool> evalOk(block_size, false);
-
-        auto bb_inputs = new double[_nbInputs * block_size];
-        auto bb_outputs = new double[_nbOutputs * block_size];
-
-        // collect the inputs parameters
-        for (size_t index = 0; index < block_size; ++index)
-        {
-            const auto& x = block[index];
-            for (size_t i = 0; i < (size_t)_nbInputs; ++i)
-            {
-                bb_inputs[index * _nbInputs + i] = x->operator[](i).todouble();
-            }
-        }
-
-        auto eval_ok = new bool[block_size];
-        auto count_eval = new bool[block_size];
-
         try
         {
             // call function
-            _bb_block(block_size, _nbInputs, bb_inputs,
-                      _nbOutputs, bb_outputs,
-                      count_eval, eval_ok,
+            _bb_block((int)nbPoints, (int)nbInputs, const_cast<double*>(inputs),
+                      (int)nbOutputs, outputs,
+                      countEval, evalOk,
                       _data_user_ptr);
-
-            // collect outputs parameters
-            for (size_t index = 0; index < block_size; ++index)
-            {
-                std::string bbo;
-                for (size_t i = 0; i < (size_t)_nbOutputs; ++i)
-                {
-                    bbo += std::to_string(bb_outputs[index * _nbOutputs + i]) + " ";
-                }
-                block[index]->setBBO(bbo, _bbOutputTypeList, _evalType);
-            }
-
-            // Set evalOk and countEval
-            for (size_t index = 0; index < block_size; ++index)
-            {
-                evalOk[index] = eval_ok[index];
-                countEval[index] = count_eval[index];
-            }
         }
         catch (std::exception &e)
         {
@@ -601,14 +570,6 @@ public:
             err += e.what();
             throw std::logic_error(err);
         }
-
-
-        delete[] bb_inputs;
-        delete[] bb_outputs;
-        delete[] eval_ok;
-        delete[] count_eval;
-
-        return evalOk;
     }
 };
 
@@ -52,6 +52,7 @@
 #include "../Algos/SubproblemManager.hpp"
 #include "../Cache/CacheBase.hpp"
 #include "../Output/OutputQueue.hpp"
+#include "../Util/InstrumentedLock.hpp"
 
 /*-----------------------------------*/
 /*   static members initialization   */
@@ -464,10 +465,8 @@ std::vector<NOMAD::EvalPoint> NOMAD::EvcInterface::retrieveAllEvaluatedPoints()
 {
     std::vector<NOMAD::EvalPoint> evaluatedPoints;
 
-#ifdef _OPENMP
-#pragma omp critical
-#endif
     {
+        NOMAD_CRITICAL(unnamed);
         for (auto evalPoint : _evaluatorControl->retrieveAllEvaluatedPoints())
         {
             // Convert from full to subspace dimension
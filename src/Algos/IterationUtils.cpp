@@ -52,6 +52,7 @@
 #include "../Output/OutputQueue.hpp"
 #include "../Type/EvalSortType.hpp"
 #include "../Algos/MainStep.hpp"
+#include "../Util/InstrumentedLock.hpp"
 
 void NOMAD::IterationUtils::init()
 {
@@ -491,10 +492,8 @@ void NOMAD::IterationUtils::updateStepSuccessStats(const Step* step)
     // Important: For steps directly generating/evaluating trial points, each evaluated trial point is counted (UNSUCCESSFUL, PARTIAL_SUCCESS, FULL_SUCCESS). Unevaluated trial points are not counted.
     if (NOMAD::EvalType::BB == evalType)
     {
-#ifdef _OPENMP
-#pragma omp critical
-#endif
         {
+            NOMAD_CRITICAL(unnamed);
             const SuccessStats & evcSuccessStats= evc->getSuccessStats();
             
             if (evcSuccessStats.hasStatsForPropagation())
@@ -626,10 +625,12 @@ void NOMAD::IterationUtils::completeTrialPointsInformation()
     }
     // If sort type is SURROGATE, but Evaluator type is not SURROGATE,
     // start by evaluating points using the surrogate Evaluator.
+    // With NB_THREADS_SURROGATE_EVAL, the surrogate evaluations are done during the BB evaluations.
     else if ( NOMAD::EvalSortType::SURROGATE == evc->getEvalSortType()
         && NOMAD::EvalType::SURROGATE != evc->getCurrentEvalType()
         && _trialPoints.size() > 1
-        && evc->getOpportunisticEval())
+        && evc->getOpportunisticEval()
+        && !evc->useSurrogatePipeline())
     {
         surrogateEvaluation = std::make_unique<NOMAD::SurrogateEvaluation>(_parentStep,_trialPoints, NOMAD::EvalType::SURROGATE);
     }
@@ -115,6 +115,20 @@ bool NOMAD::MadsInitialization::eval_x0s()
 
         evalPointSet.insert(evalPointX0);
     }
+
+    // Points not completed by a previous run that stopped before its end
+    // (EVAL_QUEUE_CHECKPOINT_FILE). They are evaluated again with the X0s.
+    std::vector<NOMAD::Point> checkpointPoints;
+    if (nullptr != evc)
+    {
+        checkpointPoints = evc->popCheckpointPoints(NOMAD::SubproblemManager::getInstance()->getSubFixedVariable(this));
+        for (const auto& x : checkpointPoints)
+        {
+            NOMAD::EvalPoint evalPoint(x);
+            evalPoint.updateTag();
+            evalPointSet.insert(evalPoint);
+        }
+    }
     _trialPointStats.incrementTrialPointsGenerated(evalPointSet.size(), evalType);
 
     // Add points to the eval queue.
@@ -269,6 +283,22 @@ bool NOMAD::MadsInitialization::eval_x0s()
                                                     _barrierInitializedFromCache);
         }
 
+        // The points of the checkpoint may improve the incumbents.
+        if (!checkpointPoints.empty())
+        {
+            std::vector<NOMAD::EvalPoint> evalPointCheckpoints;
+            for (const auto& x : checkpointPoints)
+            {
+                NOMAD::EvalPoint evalPoint(x);
+                if (   (findInList(x, evaluatedPoints, evalPoint) || cacheInterface.find(x, evalPoint, evalType) > 0)
+                    && evalPoint.isEvalOk(evalType))
+                {
+                    evalPointCheckpoints.push_back(evalPoint);
+                }
+            }
+            _barrier->updateWithPoints(evalPointCheckpoints, false, true /* true: update barrier incumbents and hMax */);
+        }
+
         // Case where x0 evaluation does not satisfy an extreme barrier constraint
         if (nullptr == _barrier->getCurrentIncumbentFeas() && nullptr == _barrier->getCurrentIncumbentInf())
         {
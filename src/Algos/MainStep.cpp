@@ -58,14 +58,18 @@
 #include "../Algos/SubproblemManager.hpp"
 #include "../Cache/CacheSet.hpp"
 #include "../Eval/ProgressiveBarrier.hpp"
+#include "../Eval/SocketEvaluator.hpp"
 #include "../Math/LHS.hpp"
 #include "../Math/RNG.hpp"
 #include "../Output/OutputQueue.hpp"
 #include "../Output/OutputDirectToFile.hpp"
+#include "../Output/OverheadAccounting.hpp"
+#include "../Output/Trace.hpp"
 #include "../Util/Clock.hpp"
 #include "../Type/EvalSortType.hpp"
 #include "../Util/Clock.hpp"
 #include "../Util/fileutils.hpp"
+#include "../Util/InstrumentedLock.hpp"
 
 // Specific algos
 #include "../Algos/LatinHypercubeSampling/LH.hpp"
@@ -127,7 +131,7 @@ NOMAD::MainStep::~MainStep()
 NOMAD::ArrayOfPoint NOMAD::MainStep::suggest()
 {
     NOMAD::ArrayOfPoint suggestedPoints;
-    AddOutputInfo("Start step " + getName(), true, false);
+    AddOutputInfoDeferred([this]() { return "Start step " + getName(); }, true, false);
 
     // No X0 should be provided
     auto x0s = _allParams->getAttributeValue<NOMAD::ArrayOfPoint>("X0");
@@ -232,7 +236,7 @@ NOMAD::ArrayOfPoint NOMAD::MainStep::suggest()
             throw NOMAD::StepException(__FILE__,__LINE__, err, this);
     }
 
-    AddOutputInfo("End step " + getName(), false, true);
+    AddOutputInfoDeferred([this]() { return "End step " + getName(); }, false, true);
 
     return suggestedPoints;
 }
@@ -240,7 +244,7 @@ NOMAD::ArrayOfPoint NOMAD::MainStep::suggest()
 
 void NOMAD::MainStep::observe(const std::vector<NOMAD::EvalPoint>& evalPointList)
 {
-    AddOutputInfo("Start step " + getName() , true, false);
+    AddOutputInfoDeferred([this]() { return "Start step " + getName(); }, true, false);
 
     // Display attributes and check attribute consistency
     if (_allParams->getAttributeValue<int>("DISPLAY_DEGREE") >= (int)NOMAD::OutputLevel::LEVEL_DEBUG)
@@ -269,7 +273,7 @@ void NOMAD::MainStep::observe(const std::vector<NOMAD::EvalPoint>& evalPointList
         _allParams->checkAndComply();
     }
 
-    AddOutputInfo("End step " + getName(), false, true);
+    AddOutputInfoDeferred([this]() { return "End step " + getName(); }, false, true);
 }
 
 
@@ -366,6 +370,22 @@ void NOMAD::MainStep::startImp()
         NOMAD::OutputDirectToFile::getInstance()->disableSolutionFile();
     }
 
+    // Tracing of the steps, until the end of the run
+    const auto traceFileName = _allParams->getAttributeValue<std::string>("TRACE_FILE");
+    if (!traceFileName.empty())
+    {
+        NOMAD::Trace::start(traceFileName);
+    }
+
+    // Profile of the locks, until the end of the run
+    NOMAD::InstrumentedLock::enableProfile(_allParams->getAttributeValue<bool>("LOCK_CONTENTION_REPORT"));
+
+    // Overhead accounting, until the end of the run
+    if (isOverheadAccounted())
+    {
+        NOMAD::OverheadAccounting::start();
+    }
+
     createCache(_allParams->getAttributeValue<bool>("USE_CACHE_FILE_FOR_RERUN"));
     updateX0sFromCacheAndFromLHSInit();
     auto x0s = _allParams->getPbParams()->getAttributeValue<NOMAD::ArrayOfPoint>("X0");
@@ -390,9 +410,18 @@ void NOMAD::MainStep::startImp()
 
         // Batch mode. Create Evaluator on the go.
         auto evalType = (surrogateAsBB) ? NOMAD::EvalType::SURROGATE : NOMAD::EvalType::BB;
-        _evaluators.push_back(std::make_shared<NOMAD::Evaluator>(_allParams->getEvalParams(),
-                                                          evalType,
-                                                          NOMAD::EvalXDefined::USE_BB_EVAL));
+        if (!surrogateAsBB && !_allParams->getAttributeValue<NOMAD::ArrayOfString>("BB_WORKERS").empty())
+        {
+            // Distributed evaluations on nomad_worker daemons.
+            _evaluators.push_back(std::make_shared<NOMAD::SocketEvaluator>(_allParams->getEvalParams(),
+                                                                           evalType));
+        }
+        else
+        {
+            _evaluators.push_back(std::make_shared<NOMAD::Evaluator>(_allParams->getEvalParams(),
+                                                                     evalType,
+                                                                     NOMAD::EvalXDefined::USE_BB_EVAL));
+        }
         if (!surrogateAsBB)
         {
             auto evalSortType = _allParams->getAttributeValue<NOMAD::EvalSortType>("EVAL_QUEUE_SORT");
@@ -729,9 +758,52 @@ void NOMAD::MainStep::endImp()
    _totalCPUTime += NOMAD::Clock::getCPUTime() - _startTime;
 #endif // TIME_STATS
 
+    // The end of the main step is not accounted.
+    if (isOverheadAccounted())
+    {
+        NOMAD::OverheadAccounting::stop();
+    }
+
     displayDetailedStats();
 
     writeFinalSolutionFile();
+    NOMAD::OutputDirectToFile::getInstance()->flushHistoryFile();
+
+    if (NOMAD::Trace::isEnabled() && !NOMAD::Trace::stop())
+    {
+        AddOutputInfo("Warning: Cannot write trace file " + NOMAD::Trace::getFileName(), NOMAD::OutputLevel::LEVEL_WARNING);
+    }
+
+    if (NOMAD::InstrumentedLock::isProfileEnabled())
+    {
+        NOMAD::InstrumentedLock::enableProfile(false);
+        AddOutputInfo("Lock contention report:", NOMAD::OutputLevel::LEVEL_NORMAL);
+        for (const auto& line : NOMAD::InstrumentedLock::getContentionReport())
+        {
+            AddOutputInfo(line, NOMAD::OutputLevel::LEVEL_NORMAL);
+        }
+    }
+
+    if (_allParams->getAttributeValue<bool>("OVERHEAD_ACCOUNTING"))
+    {
+        AddOutputInfo("Overhead accounting report:", NOMAD::OutputLevel::LEVEL_NORMAL);
+        for (const auto& line : NOMAD::OverheadAccounting::getReport())
+        {
+            AddOutputInfo(line, NOMAD::OutputLevel::LEVEL_NORMAL);
+        }
+    }
+
+    // The run is complete: there is nothing to restart from. After a Ctrl-C,
+    // the last checkpoint is kept.
+    auto evc = NOMAD::EvcInterface::getEvaluatorControl();
+    if (nullptr != evc && !NOMAD::AllStopReasons::testIf(NOMAD::BaseStopType::CTRL_C))
+    {
+        evc->removeCheckpoint();
+    }
+    if (nullptr != evc)
+    {
+        evc->writeEvalMetrics();
+    }
 
     _algos.clear();
 
@@ -1102,6 +1174,13 @@ void NOMAD::MainStep::resetEvaluatorControl()
 }
 
 
+bool NOMAD::MainStep::isOverheadAccounted() const
+{
+    return _allParams->getAttributeValue<bool>("OVERHEAD_ACCOUNTING")
+           || NOMAD::OutputQueue::getInstance()->usesStatsType(NOMAD::DisplayStatsType::DS_OVERHEAD);
+}
+
+
 void NOMAD::MainStep::displayDetailedStats() const
 {
     // Display detailed stats
@@ -1155,6 +1234,82 @@ void NOMAD::MainStep::displayDetailedStats() const
     size_t blkEval = NOMAD::EvcInterface::getEvaluatorControl()->getBlockEval();
     s2.add(NOMAD::itos(blkEval));
 
+    if (_allParams->getAttributeValue<int>("NB_THREADS_PARALLEL_EVAL") > 1)
+    {
+        s1.add("Blocks stolen by idle evaluation threads:");
+        size_t nbBlockSteals = NOMAD::EvcInterface::getEvaluatorControl()->getNbBlockSteals();
+        s2.add(NOMAD::itos(nbBlockSteals));
+    }
+
+    if (_allParams->getAttributeValue<size_t>("NB_THREADS_SURROGATE_EVAL") > 0)
+    {
+        s1.add("Blocks moved ahead by static surrogate screening:");
+        size_t nbBlocksReprioritized = NOMAD::EvcInterface::getEvaluatorControl()->getNbBlocksReprioritized();
+        s2.add(NOMAD::itos(nbBlocksReprioritized));
+    }
+
+    if (_allParams->getAttributeValue<bool>("BB_EVAL_STAGED"))
+    {
+        s1.add("Blackbox evaluations rejected early from staged outputs:");
+        size_t nbEvalRejectedEarly = NOMAD::EvcInterface::getEvaluatorControl()->getNbEvalRejectedEarly();
+        s2.add(NOMAD::itos(nbEvalRejectedEarly));
+    }
+
+    if (_allParams->getAttributeValue<bool>("BB_EVAL_MULTI_FIDELITY"))
+    {
+        s1.add("Blackbox evaluations truncated from intermediate outputs:");
+        size_t nbEvalTruncated = NOMAD::EvcInterface::getEvaluatorControl()->getNbEvalTruncated();
+        s2.add(NOMAD::itos(nbEvalTruncated));
+    }
+
+    if (_allParams->getAttributeValue<bool>("EVAL_OPPORTUNISTIC_CANCEL"))
+    {
+        s1.add("Blackbox evaluations cancelled after an opportunistic success:");
+        size_t nbEvalCancelled = NOMAD::EvcInterface::getEvaluatorControl()->getNbEvalCancelled();
+        s2.add(NOMAD::itos(nbEvalCancelled));
+    }
+
+    if (_allParams->getAttributeValue<bool>("BB_ADAPTIVE_BLOCK_SIZE"))
+    {
+        const auto& blockSizeAdapter = NOMAD::EvcInterface::getEvaluatorControl()->getBlockSizeAdapter();
+        s1.add("Adaptive block sizes (size:number of blocks):");
+        s2.add(blockSizeAdapter.displayBlockSizeCount());
+
+        s1.add("Estimated blackbox launch overhead (s):");
+        s2.add(std::to_string(blockSizeAdapter.getLaunchOverhead()));
+
+        s1.add("Estimated blackbox time per point (s):");
+        s2.add(std::to_string(blockSizeAdapter.getTimePerPoint()));
+    }
+
+    if (isOverheadAccounted() && NOMAD::OverheadAccounting::getNbEval() > 0)
+    {
+        s1.add("Algorithmic overhead per evaluation (s):");
+        s2.add(NOMAD::OverheadAccounting::getOverheadPerEval().tostring());
+
+        s1.add("Evaluation time per evaluation (s):");
+        s2.add(std::to_string(NOMAD::OverheadAccounting::getEvalTime() / static_cast<double>(NOMAD::OverheadAccounting::getNbEval())));
+
+        for (const auto& scopeOverhead : NOMAD::OverheadAccounting::getScopeOverheads())
+        {
+            s1.add("Overhead per evaluation in " + scopeOverhead._name + " (s):");
+            s2.add(std::to_string(scopeOverhead._time / static_cast<double>(NOMAD::OverheadAccounting::getNbEval())));
+        }
+    }
+
+    // Latencies and queue depths, per evaluator type and main thread
+    NOMAD::EvcInterface::getEvaluatorControl()->getEvalTelemetry().display(s1, s2);
+
+    if (NOMAD::INF_SIZE_T != _allParams->getAttributeValue<size_t>("BB_HEDGING_PERCENTILE"))
+    {
+        const auto& evalHedging = NOMAD::EvcInterface::getEvaluatorControl()->getEvalHedging();
+        s1.add("Hedged blackbox evaluations (duplicates started):");
+        s2.add(NOMAD::itos(evalHedging.getNbDuplicates()));
+
+        s1.add("Hedged blackbox evaluations (duplicates completed first):");
+        s2.add(NOMAD::itos(evalHedging.getNbDuplicateWins()));
+    }
+
     s1.add("Total surrogate evaluations:");
     size_t totalSurrogateEval = NOMAD::EvcInterface::getEvaluatorControl()->getSurrogateEval();
     s2.add(NOMAD::itos(totalSurrogateEval));
@@ -264,6 +264,9 @@ private:
     /// Final solution file
     void writeFinalSolutionFile() const;
 
+    /// Overhead accounting, by parameter OVERHEAD_ACCOUNTING or for the OVERHEAD stats field
+    bool isOverheadAccounted() const;
+
 };
 
 
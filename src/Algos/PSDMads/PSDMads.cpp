@@ -132,9 +132,7 @@ bool NOMAD::PSDMads::runImp()
     size_t t = _runParams->getAttributeValue<size_t>("PSD_MADS_NB_SUBPROBLEM");
 
     ///< Lock access to some elements when they are updated.
-    omp_lock_t psdMadsLock;
-    // Initialize lock.
-    omp_init_lock(&psdMadsLock);
+    NOMAD::InstrumentedLock psdMadsLock("psdMadsLock");
 
     // Parallel section
 #pragma omp parallel num_threads(t) default(none) shared(k, psdMadsLock, terminateAll)
@@ -146,7 +144,7 @@ bool NOMAD::PSDMads::runImp()
 
             // Create a PSDMadsMegaIteration to manage the pollster worker and the regular workers.
             // Lock psd mads before accessing barrier.
-            omp_set_lock(&psdMadsLock);
+            psdMadsLock.set();
             auto bestEvalPoint = _barrier->getAllPoints()[0];
             auto barrier = _barrier->clone();                      // Barrier points are not transferred during clone.
             auto success = _masterMegaIteration->getSuccessType(); 
@@ -157,7 +155,7 @@ bool NOMAD::PSDMads::runImp()
                 fixedVariable = *(bestEvalPoint.getX());
                 generateSubproblem(fixedVariable);
             }
-            omp_unset_lock(&psdMadsLock);
+            psdMadsLock.unset();
 
             NOMAD::PSDMadsMegaIteration psdMegaIteration(this, k, barrier,
                                                          _psdMainMesh, success,
@@ -167,7 +165,7 @@ bool NOMAD::PSDMads::runImp()
             bool madsSuccessful = psdMegaIteration.run(); // One Mads (on pollster or subproblem) is run per PSDMadsMegaIteration.
 
             //  Update the reference barrier
-            omp_set_lock(&psdMadsLock);
+            psdMadsLock.set();
             if (madsSuccessful)
             {
                 auto madsOnSubPb = psdMegaIteration.getMads();
@@ -184,13 +182,13 @@ bool NOMAD::PSDMads::runImp()
                                            false /* not used by progressive barrier*/,
                                            true /* true: update incumbents and hMax*/);
             }
-            omp_unset_lock(&psdMadsLock);
+            psdMadsLock.unset();
 
             psdMegaIteration.end();
 
             if (isPollster)
             {
-                omp_set_lock(&psdMadsLock);
+                psdMadsLock.set();
                 if (doUpdateMesh())
                 {
 
@@ -211,7 +209,7 @@ bool NOMAD::PSDMads::runImp()
 
                     _psdMainMesh->checkMeshForStopping(_stopReasons);
                 }
-                omp_unset_lock(&psdMadsLock);
+                psdMadsLock.unset();
 
                 // Update master mega iteration counter. Flush to all threads. Used by psdMadsMegaIteration.
                 k++;
@@ -229,13 +227,12 @@ bool NOMAD::PSDMads::runImp()
                 }
 
                 // Safeguard lock. Only the pollster (unique) accesses the _masterMegaIteration.
-                omp_set_lock(&psdMadsLock);
+                psdMadsLock.set();
                 _masterMegaIteration->setK(k);
-                omp_unset_lock(&psdMadsLock);
+                psdMadsLock.unset();
             }
         }
     }
-    omp_destroy_lock(&psdMadsLock);
 
     return true;
 }
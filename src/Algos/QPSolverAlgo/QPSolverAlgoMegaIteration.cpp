@@ -91,7 +91,7 @@ void NOMAD::QPSolverAlgoMegaIteration::startImp()
         size_t nbIter = _iterList.size();
 
 
-        AddOutputInfo(getName() + " has " + NOMAD::itos(nbIter) + " iteration" + ((nbIter > 1)? "s" : "") + ".");
+        AddOutputInfoDeferred([this, nbIter]() { return getName() + " has " + NOMAD::itos(nbIter) + " iteration" + ((nbIter > 1)? "s" : "") + "."; });
     
         AddOutputDebug("Iterations generated:");
         for (size_t i = 0; i < nbIter; i++)
@@ -102,6 +102,7 @@ void NOMAD::QPSolverAlgoMegaIteration::startImp()
                 throw NOMAD::Exception(__FILE__, __LINE__, "Invalid shared pointer");
             }
 
+            OUTPUT_DEBUG_START
             AddOutputDebug( _iterList[i]->getName());
             // Ensure we get frame center from a QuadModelIteration.
             auto frameCenter = sqmIteration->getRefCenter();
@@ -117,6 +118,7 @@ void NOMAD::QPSolverAlgoMegaIteration::startImp()
                 AddOutputDebug("Mesh size:  " + meshSize.display());
                 AddOutputDebug("Frame size: " + frameSize.display());
             }
+            OUTPUT_DEBUG_END
 
             NOMAD::OutputQueue::Flush();
         }
@@ -153,8 +155,10 @@ bool NOMAD::QPSolverAlgoMegaIteration::runImp()
 
             if (iterSuccessful)
             {
+                OUTPUT_DEBUG_START
                 s = getName() + ": new success " + NOMAD::enumStr(getSuccessType());
                 AddOutputDebug(s);
+                OUTPUT_DEBUG_END
             }
 
             if (getUserInterrupt())
@@ -165,7 +169,8 @@ bool NOMAD::QPSolverAlgoMegaIteration::runImp()
     }
 
     // Display MegaIteration's stop reason
-    AddOutputDebug(getName() + " stop reason set to: " + _stopReasons->getStopReasonAsString());
+    AddOutputInfoDeferred([this]() { return getName() + " stop reason set to: " + _stopReasons->getStopReasonAsString(); },
+                          NOMAD::OutputLevel::LEVEL_DEBUG);
 
     // return true if we have a partial or full success.
     return successful;
@@ -63,6 +63,7 @@
 #include "../../Cache/CacheBase.hpp"
 #include "../../Math/MathUtils.hpp"
 #include "../../Math/MatrixUtils.hpp"
+#include "../../Util/InstrumentedLock.hpp"
 
 #include "../../../ext/sgtelib/src/Surrogate_PRS.hpp"
 
@@ -5205,8 +5206,7 @@ SGTELIB::Matrix NOMAD::QPSolverOptimize::getModelOut(const NOMAD::Point & x) con
     SGTELIB::Matrix Mpredict (  "M_predict", 1, static_cast<int>(_m));
     SGTELIB::Matrix Xpredict("X_predict", 1, static_cast<int>(_n));
     
-    std::string s = "X =" + x.display();
-    NOMAD::OutputQueue::Add(s, _displayLevel);
+    NOMAD::OutputQueue::AddDeferred([&x]() { return "X =" + x.display(); }, _displayLevel);
     
     // Set the input matrix
     for (int i = 0; i < _n; i++)
@@ -5222,10 +5222,8 @@ SGTELIB::Matrix NOMAD::QPSolverOptimize::getModelOut(const NOMAD::Point & x) con
     
     // Unfortunately, Sgtelib is not thread-safe.
     // For this reason we have to set part of the eval_x code to critical.
-#ifdef _OPENMP
-#pragma omp critical(SgtelibEvalBlock)
-#endif // _OPENMP
     {
+        NOMAD_CRITICAL(SgtelibEvalBlock);
         _model->check_ready(__FILE__,__FUNCTION__,__LINE__);
         
         _model->predict(Xpredict, &Mpredict);
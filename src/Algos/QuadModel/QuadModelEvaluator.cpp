@@ -47,6 +47,7 @@
 
 #include "../../Algos/QuadModel/QuadModelEvaluator.hpp"
 #include "../../Output/OutputQueue.hpp"
+#include "../../Util/InstrumentedLock.hpp"
 
 // Destructor
 NOMAD::QuadModelEvaluator::~QuadModelEvaluator() = default;
@@ -130,8 +131,7 @@ std::vector<bool> NOMAD::QuadModelEvaluator::eval_block(NOMAD::Block &block,
             throw NOMAD::Exception(__FILE__, __LINE__, "Evaluator: Incomplete point " + (*it)->display());
         }
 
-        std::string s = "X" + itos(j) +" =" + (*it)->display();
-        NOMAD::OutputQueue::Add(s, _displayLevel);
+        NOMAD::OutputQueue::AddDeferred([&it, j]() { return "X" + NOMAD::itos(j) + " =" + (*it)->display(); }, _displayLevel);
 
         // Set the input matrix
         for (size_t i = 0; i < (*it)->size(); i++)
@@ -148,10 +148,8 @@ std::vector<bool> NOMAD::QuadModelEvaluator::eval_block(NOMAD::Block &block,
 
     // Unfortunately, Sgtelib is not thread-safe.
     // For this reason we have to set part of the eval_x code to critical.
-#ifdef _OPENMP
-#pragma omp critical(SgtelibEvalBlock)
-#endif // _OPENMP
     {
+        NOMAD_CRITICAL(SgtelibEvalBlock);
         _model->check_ready(__FILE__,__FUNCTION__,__LINE__);
 
         _model->predict(X_predict, &M_predict);
@@ -162,22 +160,23 @@ std::vector<bool> NOMAD::QuadModelEvaluator::eval_block(NOMAD::Block &block,
     // Verify all points are completely defined
     for (auto it = block.begin(); it != block.end(); it++, j++)
     {
-        std::string s = "X" + itos(j) +": " + (*it)->display();
-        NOMAD::OutputQueue::Add(s, _displayLevel);
+        NOMAD::OutputQueue::AddDeferred([&it, j]() { return "X" + NOMAD::itos(j) + ": " + (*it)->display(); }, _displayLevel);
         // ====================================== //
         // Output display                    //
         // ====================================== //
-        std::string sObj = "F = ";
-        std::string sCons = "C = [ ";
-        for (size_t i = 0; i < _nbModels; i++)
+        NOMAD::OutputQueue::AddDeferred([&]()
         {
-            if (_bbOutputTypeList[i] != NOMAD::BBOutputType::OBJ)
-                sCons += std::to_string(M_predict.get(j,static_cast<int>(i))) + " ";
-            else
-                sObj  += std::to_string(M_predict.get(j,static_cast<int>(i))) + " ";
-        }
-        s = sObj + ((_nbConstraints>0 ) ? sCons+" ]":"") ;
-        NOMAD::OutputQueue::Add(s, _displayLevel);
+            std::string sObj = "F = ";
+            std::string sCons = "C = [ ";
+            for (size_t i = 0; i < _nbModels; i++)
+            {
+                if (_bbOutputTypeList[i] != NOMAD::BBOutputType::OBJ)
+                    sCons += std::to_string(M_predict.get(j,static_cast<int>(i))) + " ";
+                else
+                    sObj  += std::to_string(M_predict.get(j,static_cast<int>(i))) + " ";
+            }
+            return sObj + ((_nbConstraints>0 ) ? sCons+" ]":"");
+        }, _displayLevel);
 
         // ====================================== //
         // Application of the formulation         //
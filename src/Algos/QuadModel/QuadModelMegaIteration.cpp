@@ -91,7 +91,7 @@ void NOMAD::QuadModelMegaIteration::startImp()
 
         size_t nbIter = _iterList.size();
 
-        AddOutputInfo(getName() + " has " + NOMAD::itos(nbIter) + " iteration" + ((nbIter > 1)? "s" : "") + ".");
+        AddOutputInfoDeferred([this, nbIter]() { return getName() + " has " + NOMAD::itos(nbIter) + " iteration" + ((nbIter > 1)? "s" : "") + "."; });
 
         AddOutputDebug("Iterations generated:");
         for (size_t i = 0; i < nbIter; i++)
@@ -102,6 +102,7 @@ void NOMAD::QuadModelMegaIteration::startImp()
                 throw NOMAD::Exception(__FILE__, __LINE__, "Invalid shared pointer");
             }
 
+            OUTPUT_DEBUG_START
             AddOutputDebug( _iterList[i]->getName());
             // Ensure we get frame center from a QuadModelIteration.
             auto frameCenter = sqmIteration->getRefCenter();
@@ -117,6 +118,7 @@ void NOMAD::QuadModelMegaIteration::startImp()
                 AddOutputDebug("Mesh size:  " + meshSize.display());
                 AddOutputDebug("Frame size: " + frameSize.display());
             }
+            OUTPUT_DEBUG_END
 
             NOMAD::OutputQueue::Flush();
         }
@@ -155,8 +157,10 @@ bool NOMAD::QuadModelMegaIteration::runImp()
 
             if (iterSuccessful)
             {
+                OUTPUT_DEBUG_START
                 s = getName() + ": new success " + NOMAD::enumStr(getSuccessType());
                 AddOutputDebug(s);
+                OUTPUT_DEBUG_END
             }
 
             if (getUserInterrupt())
@@ -166,7 +170,8 @@ bool NOMAD::QuadModelMegaIteration::runImp()
         }
     }
     // Display MegaIteration's stop reason
-    AddOutputDebug(getName() + " stop reason set to: " + _stopReasons->getStopReasonAsString());
+    AddOutputInfoDeferred([this]() { return getName() + " stop reason set to: " + _stopReasons->getStopReasonAsString(); },
+                          NOMAD::OutputLevel::LEVEL_DEBUG);
 
 
     // MegaIteration is a success if either a better xFeas or
@@ -52,6 +52,7 @@
 #include "../../Algos/QuadModel/QuadModelUpdate.hpp"
 #include "../../Cache/CacheBase.hpp"
 #include "../../Output/OutputQueue.hpp"
+#include "../../Output/Trace.hpp"
 
 #include "../../../ext/sgtelib/src/Surrogate_PRS.hpp"
 
@@ -456,7 +457,12 @@ bool NOMAD::QuadModelUpdate::runImp()
         AddOutputInfo("Build model from training set...", _displayLevel);
         OUTPUT_INFO_END
 
-        if (model->build())
+        bool modelBuilt = false;
+        {
+            NOMAD::TraceScope traceScope("Quad model build", "model");
+            modelBuilt = model->build();
+        }
+        if (modelBuilt)
         {
             OUTPUT_INFO_START
             AddOutputInfo("OK.", _displayLevel);
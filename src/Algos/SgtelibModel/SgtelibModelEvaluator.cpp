@@ -49,6 +49,7 @@
 #include "../../Algos/SgtelibModel/SgtelibModelEvaluator.hpp"
 #include "../../Output/OutputQueue.hpp"
 #include "../../Type/SgtelibModelFormulationType.hpp"
+#include "../../Util/InstrumentedLock.hpp"
 
 #include "../../../ext/sgtelib/src/Surrogate.hpp"
 
@@ -140,10 +141,8 @@ bool NOMAD::SgtelibModelEvaluator::eval_x(NOMAD::EvalPoint &x,
 
     // Unfortunately, Sgtelib is not thread-safe.
     // For this reason we have to set part of the eval_x code to critical.
-#ifdef _OPENMP
-    #pragma omp critical(SgtelibEvalX)
-#endif // _OPENMP
     {
+        NOMAD_CRITICAL(SgtelibEvalX);
         // Set the input matrix
         for (size_t i = 0; i < n; i++)
         {
@@ -346,7 +345,7 @@ bool NOMAD::SgtelibModelEvaluator::eval_x(NOMAD::EvalPoint &x,
             mu = 4*pf*(1-pf);
         }
 
-    } // pragma omp critical
+    } // critical section
 
     // ====================================== //
     // Application of the formulation         //
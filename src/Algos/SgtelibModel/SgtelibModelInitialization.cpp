@@ -197,7 +197,7 @@ bool NOMAD::SgtelibModelInitialization::eval_x0s()
         {
             // evalOk is true if at least one evaluation is Ok
             evalOk = true;
-            AddOutputInfo("Using X0: " + evalPoint_x0.displayAll());
+            AddOutputInfoDeferred([&evalPoint_x0]() { return "Using X0: " + evalPoint_x0.displayAll(); });
         }
         else
         {
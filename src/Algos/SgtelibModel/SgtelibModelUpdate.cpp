@@ -52,6 +52,7 @@
 #include "../../Algos/SgtelibModel/SgtelibModelMegaIteration.hpp"
 #include "../../Algos/SgtelibModel/SgtelibModelUpdate.hpp"
 #include "../../Output/OutputQueue.hpp"
+#include "../../Output/Trace.hpp"
 #include "../../Type/SgtelibModelFeasibilityType.hpp"
 #include "../../Type/SgtelibModelFormulationType.hpp"
 
@@ -147,6 +148,15 @@ bool NOMAD::SgtelibModelUpdate::runImp()
         // Use CacheInterface to ensure the points are converted to subspace
         NOMAD::CacheInterface cacheInterface(this);
         cacheInterface.find(validForUpdate, evalPointList);
+
+        // Truncated evaluations (BB_EVAL_MULTI_FIDELITY) are used as low fidelity data.
+        for (auto& evalPoint : evalPointList)
+        {
+            if (NOMAD::EvalStatusType::EVAL_TRUNCATED == evalPoint.getEvalStatus(NOMAD::EvalType::BB))
+            {
+                evalPoint.setEvalStatus(NOMAD::EvalStatusType::EVAL_OK, NOMAD::EvalType::BB);
+            }
+        }
     }
 
     // Minimum and maximum number of valid points to build a model
@@ -344,7 +354,10 @@ bool NOMAD::SgtelibModelUpdate::runImp()
         AddOutputInfo("Build model...", _displayLevel);
         OUTPUT_INFO_END
 
-        model->build();
+        {
+            NOMAD::TraceScope traceScope("Sgtelib model build", "model");
+            model->build();
+        }
         OUTPUT_INFO_START
         AddOutputInfo("OK.", _displayLevel);
         OUTPUT_INFO_END
@@ -380,7 +393,7 @@ bool NOMAD::SgtelibModelUpdate::validForUpdate(const NOMAD::EvalPoint& evalPoint
 {
     // Verify that the point is valid
     // - Not a NaN
-    // - Not a fail
+    // - Not a fail. A truncated evaluation is low fidelity data: it is valid.
     // - All outputs defined
     // - Blackbox OBJ available (Not MODEL)
     bool validPoint = true;
@@ -395,6 +408,14 @@ bool NOMAD::SgtelibModelUpdate::validForUpdate(const NOMAD::EvalPoint& evalPoint
     {
         const auto& computeTypeS = NOMAD::EvcInterface::getEvaluatorControl()->getFHComputeTypeS();
 
+        // f and h are only computed for EVAL_OK.
+        std::unique_ptr<NOMAD::Eval> lowFidelityEval;
+        if (NOMAD::EvalStatusType::EVAL_TRUNCATED == eval->getEvalStatus())
+        {
+            lowFidelityEval = std::make_unique<NOMAD::Eval>(*eval);
+            lowFidelityEval->setEvalStatus(NOMAD::EvalStatusType::EVAL_OK);
+            eval = lowFidelityEval.get();
+        }
 
         // Note: it could be discussed if points that have h > hMax should still be used
         // to build the model. We validate them to comply with Nomad 3.
@@ -53,6 +53,9 @@
 #include "../Algos/Step.hpp"
 #include "../Cache/CacheBase.hpp"
 #include "../Output/OutputQueue.hpp"
+#include "../Output/OverheadAccounting.hpp"
+#include "../Output/Trace.hpp"
+#include "../Util/InstrumentedLock.hpp"
 
 /*-----------------------------------*/
 /*   static members initialization   */
@@ -245,6 +248,23 @@ void NOMAD::Step::AddOutputInfo(const std::string& s, NOMAD::OutputLevel outputL
 }
 
 
+void NOMAD::Step::AddOutputInfoDeferred(const NOMAD::OutputMsgFormatter& msgFormatter, bool isBlockStart, bool isBlockEnd) const
+{
+    OUTPUT_INFO_START
+    AddOutputInfo(msgFormatter(), isBlockStart, isBlockEnd);
+    OUTPUT_INFO_END
+}
+
+
+void NOMAD::Step::AddOutputInfoDeferred(const NOMAD::OutputMsgFormatter& msgFormatter, NOMAD::OutputLevel outputLevel) const
+{
+    if (NOMAD::OutputQueue::GoodLevel(outputLevel))
+    {
+        AddOutputInfo(msgFormatter(), outputLevel);
+    }
+}
+
+
 void NOMAD::Step::AddOutputError(const std::string& s) const
 {
     AddOutputInfo(s, NOMAD::OutputLevel::LEVEL_ERROR);
@@ -286,6 +306,14 @@ void NOMAD::Step::AddOutputInfo(NOMAD::OutputInfo outputInfo) const
 /// Implementation of virtual functions : default start
 void NOMAD::Step::start()
 {
+    if (NOMAD::Trace::isEnabled())
+    {
+        NOMAD::Trace::begin(getName(), "step");
+    }
+    if (NOMAD::OverheadAccounting::isEnabled())
+    {
+        NOMAD::OverheadAccounting::beginScope(this, NOMAD::stepTypeToString(_stepType));
+    }
     defaultStart();
     startImp();
 }
@@ -295,6 +323,8 @@ void NOMAD::Step::end()
 {
     defaultEnd();
     endImp();
+    NOMAD::OverheadAccounting::endScope(this);
+    NOMAD::Trace::end("step");
 }
 
 
@@ -327,7 +357,7 @@ void NOMAD::Step::defaultStart()
         _stopReasons->setStarted();
     }
 
-    AddOutputInfo("Start step " + getName() , true, false);
+    AddOutputInfoDeferred([this]() { return "Start step " + getName(); }, true, false);
 }
 
 
@@ -337,7 +367,7 @@ void NOMAD::Step::defaultEnd()
     updateParentSuccess();
     updateParentSuccessStats();
 
-    AddOutputInfo("End step " + getName(), false, true);
+    AddOutputInfoDeferred([this]() { return "End step " + getName(); }, false, true);
     
     // Flush because the step is done.
     NOMAD::OutputQueue::Flush();
@@ -645,10 +675,8 @@ void NOMAD::Step::updateParentSuccessStats()
             NOMAD::SuccessStats & parentStats = parentStep->getSuccessStats();
             
             // Can be critical if the parent step is the MainStep and we have several algorithms running in parallel
-#ifdef _OPENMP
-#pragma omp critical
-#endif
             {
+                NOMAD_CRITICAL(unnamed);
                 parentStats.updateStats(_successStats);
             }
         }
@@ -271,6 +271,10 @@ public:
     void AddOutputDebug(const std::string& s) const;
     void AddOutputInfo(OutputInfo outputInfo) const;
 
+    /// \brief display output built by msgFormatter, called only if the output level is displayed
+    void AddOutputInfoDeferred(const OutputMsgFormatter& msgFormatter, bool isBlockStart, bool isBlockEnd) const;
+    void AddOutputInfoDeferred(const OutputMsgFormatter& msgFormatter, OutputLevel outputLevel = OutputLevel::LEVEL_INFO) const;
+
     /// Template function to get the parent of given type.
     /**
      * Starting with parent of current Step, and going through ancestors,
@@ -52,22 +52,16 @@ std::unique_ptr<NOMAD::SubproblemManager> NOMAD::SubproblemManager::_single=null
 
 
 #ifdef _OPENMP
-omp_lock_t NOMAD::SubproblemManager::_mapLock;
+NOMAD::InstrumentedLock NOMAD::SubproblemManager::_mapLock("mapLock");
 #endif
 
 void NOMAD::SubproblemManager::init()
 {
-#ifdef _OPENMP
-    omp_init_lock(&_mapLock);
-#endif // _OPENMP
 }
 
 
 void NOMAD::SubproblemManager::destroy()
 {
-#ifdef _OPENMP
-    omp_destroy_lock(&_mapLock);
-#endif // _OPENMP
 }
 
 
@@ -76,7 +70,7 @@ void NOMAD::SubproblemManager::addSubproblem(const NOMAD::Algorithm* algo, const
 {
     auto algoSubPair = std::pair<const NOMAD::Algorithm*, const NOMAD::Subproblem&>(algo, subproblem);
 #ifdef _OPENMP
-    omp_set_lock(&_mapLock);
+    _mapLock.set();
 #endif // _OPENMP
     auto retPair = _map.insert(algoSubPair);
     if (!retPair.second)
@@ -86,7 +80,7 @@ void NOMAD::SubproblemManager::addSubproblem(const NOMAD::Algorithm* algo, const
         throw NOMAD::StepException(__FILE__,__LINE__, err, algo);
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_mapLock);
+    _mapLock.unset();
 #endif // _OPENMP
 }
 
@@ -94,11 +88,11 @@ void NOMAD::SubproblemManager::addSubproblem(const NOMAD::Algorithm* algo, const
 void NOMAD::SubproblemManager::removeSubproblem(const Algorithm* algo)
 {
 #ifdef _OPENMP
-    omp_set_lock(&_mapLock);
+    _mapLock.set();
 #endif // _OPENMP
     size_t nbErased = _map.erase(algo);
 #ifdef _OPENMP
-    omp_unset_lock(&_mapLock);
+    _mapLock.unset();
 #endif // _OPENMP
     if (0 == nbErased)
     {
@@ -117,11 +111,11 @@ void NOMAD::SubproblemManager::reset()
         std::cout << "Warning: SubproblemManager::clear() called on non-empty SubproblemManager" << std::endl;
     }
 #ifdef _OPENMP
-    omp_set_lock(&_mapLock);
+    _mapLock.set();
 #endif // _OPENMP
     _map.clear();
 #ifdef _OPENMP
-    omp_unset_lock(&_mapLock);
+    _mapLock.unset();
 #endif // _OPENMP
 }
 
@@ -151,11 +145,11 @@ const NOMAD::Subproblem& NOMAD::SubproblemManager::getSubproblem(const NOMAD::St
         // Lock is needed even if map is not modified by this method,
         // because it could be modified by another main thread at the same moment.
 #ifdef _OPENMP
-        omp_set_lock(&_mapLock);
+        _mapLock.set();
 #endif // _OPENMP
         const NOMAD::Subproblem& sub = _map.at(algo);
 #ifdef _OPENMP
-        omp_unset_lock(&_mapLock);
+        _mapLock.unset();
 #endif // _OPENMP
         return sub;
     }
@@ -53,6 +53,7 @@
 #endif // _OPENMP
 #include "../Algos/Algorithm.hpp"
 #include "../Algos/Subproblem.hpp"
+#include "../Util/InstrumentedLock.hpp"
 
 #include "../nomad_nsbegin.hpp"
 
@@ -68,7 +69,7 @@ private:
     std::map<const Algorithm*, const Subproblem> _map;
 
 #ifdef _OPENMP
-    static omp_lock_t _mapLock;
+    static InstrumentedLock _mapLock;
 #endif // _OPENMP
 
     static std::unique_ptr<SubproblemManager> _single; ///< The singleton
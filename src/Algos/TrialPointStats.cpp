@@ -54,6 +54,7 @@
 #include "../Algos/Algorithm.hpp"
 #include "../Algos/IterationUtils.hpp"
 #include "../Algos/TrialPointStats.hpp"
+#include "../Util/InstrumentedLock.hpp"
 
 void NOMAD::TrialPointStats::init()
 {    
@@ -152,11 +153,9 @@ void NOMAD::TrialPointStats::updateParentStats()
         else if (nullptr != dynamic_cast<NOMAD::Algorithm*>(step))
         {
             auto algo = dynamic_cast<NOMAD::Algorithm*>(step);
-#ifdef _OPENMP
-            // Critical region is needed for parallel algo like psdmads. PSDMads algo gets update from multiple Mads
-#pragma omp critical(updateLock)
-#endif // _OPENMP
             {
+                // Critical region is needed for parallel algo like psdmads. PSDMads algo gets update from multiple Mads
+                NOMAD_CRITICAL(updateLock);
                 algo->updateStats(*this);
             }
             break;
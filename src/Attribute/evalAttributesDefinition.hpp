@@ -54,6 +54,11 @@ _definition = {
 { "BB_EVAL_FORMAT",  "NOMAD::ArrayOfDouble",  "-",  " Format of the doubles sent to the blackbox evaluator ",  " \n  \n . BB_EVAL_FORMAT is computed from the BB_INPUT_TYPE parameter. \n  \n . Gives the format precision for doubles sent to blackbox evaluator. \n  \n . CANNOT BE MODIFIED BY USER. Internal parameter. \n  \n . No default value.\n\n",  "  internal  "  , "false" , "false" , "true" },
 { "BB_EXE",  "std::string",  "",  " Blackbox executable ",  " \n  \n . Blackbox executable name \n  \n . List of strings \n  \n . Required for batch mode \n  \n . Unused in library mode \n  \n . One executable can give several outputs \n  \n . Use \' or \", and \'$\', to specify names or commands with spaces \n  \n . When the \'$\' character is put in first position of a string, it is \n   considered as global and no path will be added \n  \n . Examples \n     . BB_EXE bb.exe \n     . BB_EXE \'$nice bb.exe\' \n     . BB_EXE \'$python bb.py\' \n  \n . Default: Empty string.\n\n",  "  basic blackbox blackboxes bb exe executable executables binary output outputs batch  "  , "false" , "false" , "true" },
 { "BB_REDIRECTION",  "bool",  "true",  " Blackbox executable redirection for outputs  ",  " \n  \n . Flag to redirect blackbox executable outputs in a stream. The redirection \n   in a stream does not require an ouptut file. NOMAD interprets the outputs from \n   the stream according to BB_OUTPUT_TYPE. If the blackbox executable \n   outputs some verbose, NOMAD cannot interpret correctly the outputs. \n  \n . If the redirection is disabled. The blackbox must output its results into a \n  file having the name of the input file (usually nomadtmp.pid.threadnum) \n  completed by \".output\". The format must follow the BB_OUTPUT_TYPE. \n  For example, for BB_OUTPUT_TYPE OBJ CSTR, we must have only the two values on \n  a single line in the output file with a end-of-line. \n   \n . Disable blackbox redirection and managing output file can be convenient when \n the blackbox outputs some verbose. All the verbose is put into a temporary \n log file nomadtmp.pid.threadnum.tmplog \n   \n . This parameter has no effect when BB_EXE is not defined like in library mode. \n  \n . Examples \n     . BB_REDIRECTION false \n  \n . Default: true\n\n",  "  basic blackbox blackboxes bb exe executable executables binary output outputs batch  "  , "false" , "false" , "true" },
+{ "BB_EVAL_TIMEOUT",  "size_t",  "INF",  " Maximum wall-clock time in seconds for the evaluation of a block ",  " \n  \n . Maximum wall-clock time in seconds for the evaluation of a block of points. \n  \n . Argument: one positive integer. \n  \n . When the timeout is reached, the blackbox executable (BB_EXE or \n   SURROGATE_EXE) is killed, including all the processes it has launched. \n   Points not evaluated at that time get the status EVAL_TIMEOUT. \n  \n . A timed out evaluation is counted in the number of blackbox evaluations, \n   but it is not a failure: the point is not written in the cache file and \n   it may be evaluated again. \n  \n . In library mode, a user eval_x() or eval_block() can poll \n   NOMAD::Evaluator::evalStopRequested() and return early. \n  \n . Example: BB_EVAL_TIMEOUT 600 # ten minutes per block max \n  \n . Default: INF\n\n",  "  advanced blackbox blackboxes bb exe executable executables time timeout kill stop  "  , "false" , "true" , "true" },
+{ "BB_EVAL_STAGED",  "bool",  "false",  " Staged blackbox outputs with early rejection ",  " \n  \n . The blackbox reports its outputs in stages, in the order of BB_OUTPUT_TYPE, \n   for instance the cheap extreme barrier constraints before the expensive \n   objective. The evaluation is abandoned as soon as the outputs obtained \n   show that the point cannot be a success: \n     . an EB constraint is violated, \n     . the partial violation of the PB constraints exceeds the maximum \n       infeasibility of the barrier, \n     . the objective is not better than the feasible incumbent and no PB \n       constraint can make the point an improving infeasible point. \n   The incumbent is taken under the current computation of f and h (for \n   instance, PhaseOne). \n  \n . The rejected evaluation is counted. Its missing outputs are set to INF: \n   the point is infeasible. \n  \n . Batch mode (BB_EXE): the blackbox writes the outputs of a point on one or \n   several lines and flushes its standard output after each line. A new \n   point starts when all the outputs of the previous point are read. The \n   blackbox is killed when the last point of the block is rejected. \n   Requires BB_REDIRECTION. Not used with BB_WORKERS. \n  \n . Library mode: a user eval_x() or eval_block() can pass the first outputs \n   of a point to NOMAD::Evaluator::rejectPartialOutput() and return early \n   when it returns true. \n  \n . Argument: one boolean (yes or no). \n  \n . Example: BB_EVAL_STAGED yes \n  \n . Default: false\n\n",  "  advanced blackbox blackboxes bb exe output outputs staged partial early reject extreme barrier  "  , "false" , "false" , "true" },
+{ "BB_EVAL_MULTI_FIDELITY",  "bool",  "false",  " Intermediate blackbox outputs with early stopping of dominated runs ",  " \n  \n . The blackbox reports intermediate estimates of its outputs while it \n   converges, for instance along the iterations of a simulation. The \n   evaluation is stopped when its objective estimate is clearly dominated by \n   the estimate of the reference run at the same iteration. \n  \n . The reference run is the best feasible evaluation completed with \n   intermediate estimates. An estimate is dominated when it exceeds the \n   reference estimate by more than BB_EVAL_TRUNCATION_MARGIN. \n   Only used with a single objective and the standard computation of f. \n  \n . The stopped evaluation is counted. It gets the status EVAL_TRUNCATED and \n   keeps its last estimates: it is written in the cache file as low fidelity \n   data. Truncated points are used to build the Sgtelib models, but they are \n   never incumbents and they are not evaluated again. \n  \n . Batch mode (BB_EXE): before the final outputs of a point, the blackbox \n   writes lines with the keyword ITER, the iteration number and an estimate \n   of all the outputs, and flushes its standard output after each line: \n       ITER 10 1.2e3 -0.5 \n       ITER 20 9.8e2 -0.4 \n       9.7e2 -0.4 \n   The blackbox is killed when the last point of the block is truncated. \n   Requires BB_REDIRECTION. Not used with BB_WORKERS. \n  \n . Library mode: a user eval_x() passes each intermediate estimate to \n   NOMAD::Evaluator::reportIntermediateOutput() and returns early when it \n   returns true. \n  \n . Argument: one boolean (yes or no). \n  \n . Example: BB_EVAL_MULTI_FIDELITY yes \n  \n . Default: false\n\n",  "  advanced blackbox blackboxes bb exe output outputs fidelity intermediate iteration truncate early stop  "  , "false" , "false" , "true" },
+{ "BB_EVAL_TRUNCATION_MARGIN",  "NOMAD::Double",  "0.1",  " Relative margin to stop an evaluation dominated by the reference run ",  " \n  \n . With BB_EVAL_MULTI_FIDELITY, an evaluation is stopped when its objective \n   estimate at an iteration exceeds the estimate of the reference run at the \n   same iteration by more than this margin, relative to the absolute value of \n   the reference estimate. \n  \n . A larger margin stops fewer evaluations. \n  \n . Argument: one nonnegative real. \n  \n . Example: BB_EVAL_TRUNCATION_MARGIN 0.5 \n  \n . Default: 0.1\n\n",  "  advanced blackbox blackboxes fidelity intermediate truncate margin  "  , "false" , "false" , "true" },
+{ "BB_WORKERS",  "NOMAD::ArrayOfString",  "",  " Addresses of nomad_worker daemons for distributed evaluations ",  " \n  \n . Addresses of nomad_worker daemons, to evaluate the blocks of points on \n   remote machines (batch mode only). \n  \n . Arguments: list of addresses. An address is either host:port for a TCP \n   socket, or unix:path for a Unix-domain socket. \n  \n . Each worker is started with its own blackbox executable or plugin: \n     nomad_worker ADDRESS --bb-exe bb.exe \n   The worker runs the blackbox on each block of points it receives and sends \n   back the outputs. BB_EXE is not used when BB_WORKERS is set. \n  \n . A block is sent to an idle worker, the fastest first. Set \n   NB_THREADS_PARALLEL_EVAL to the number of workers to use them all. \n  \n . A busy worker sends a heartbeat every second. A worker that is silent for \n   10 seconds, or that closes its connection, is considered lost: its block \n   is sent to another worker. A lost worker is reconnected when available. \n  \n . BB_EVAL_TIMEOUT is forwarded to the workers. \n  \n . Not available on Windows. \n  \n . Example: BB_WORKERS node1:5000 node2:5000 unix:/tmp/w3.sock \n  \n . Default: Empty string.\n\n",  "  advanced blackbox blackboxes bb exe distributed remote worker workers socket sockets parallel  "  , "false" , "false" , "true" },
 { "BB_OUTPUT_TYPE",  "NOMAD::BBOutputTypeList",  "OBJ",  " Type of outputs provided by the blackboxes ",  " \n  \n . Blackbox output types \n  \n . List of types for each blackbox output \n  \n . If BB_EXE is defined, the blackbox outputs must be returned by the executable \n on a SINGLE LINE of the standard output or in an output file \n (see BB_REDIRECTION). The order of outputs must be consistent between the blackbox \n and BB_OUTPUT_TYPE. \n  \n . Available types \n     . OBJ       : objective value to minimize (define twice for bi-objective) \n     . PB        : constraint <= 0 treated with Progressive Barrier (PB) \n     . CSTR      : same as 'PB' \n     . EB        : constraint <= 0 treated with Extreme Barrier (EB) \n     . F         : constraint <= 0 treated with Filter \n     . CNT_EVAL  : 0 or 1 output: count or not the evaluation (for batch mode and Matlab interface) \n     . NOTHING   : this output is ignored \n     . EXTRA_O   : same as 'NOTHING' \n     .  -        : same as 'NOTHING' \n     . BBO_UNDEFINED: same as 'NOTHING' \n  \n . Equality constraints are not natively supported \n  \n . Extra outputs (EXTRA_O, NOTHING, BBO_UNDEFINED, ...) are not used for \n   optimization but are available for display and custom user testing \n   (see examples). \n  \n . See parameters LOWER_BOUND and UPPER_BOUND for bound constraints \n  \n . See parameter H_NORM for the infeasibility measure computation. \n  \n . See parameter H_MIN for relaxing the feasibility criterion. \n  \n . Examples \n     . BB_EXE bb.exe                   # these two lines define \n     . BB_OUTPUT_TYPE OBJ EB EB        # that bb.exe outputs three values \n  \n . Default: OBJ\n\n",  "  basic bb exe blackbox blackboxs output outputs constraint constraints type types infeasibility norm  "  , "false" , "false" , "true" },
 { "SURROGATE_EXE",  "std::string",  "",  " Static surrogate executable ",  " \n . To indicate a static surrogate executable \n  \n . List of strings \n  \n . Surrogate executable must have the same number of outputs as blackbox  \n     executable, defined by BB_OUTPUT_TYPE. \n      \n . Static surrogate evaluations can be used for sorting trial points before \n   blackbox evaluation OR for VNS Search. \n  \n . Example \n     SURROGATE_EXE surrogate.exe     # surrogate.exe is a static surrogate executable \n                                     # for BB_EXE \n . Default: Empty string.\n\n",  "  advanced static surrogate executable  "  , "true" , "false" , "true" } };
 
@@ -52,8 +52,18 @@
 
 _definition = {
 { "BB_MAX_BLOCK_SIZE",  "size_t",  "1",  " Size of blocks of points, to be used for parallel evaluations ",  " \n . Maximum size of a block of evaluations send to the blackbox \n   executable at once. Blackbox executable can manage parallel \n   evaluations on its own. Opportunistic strategies may apply after \n   each block of evaluations. \n  \n . Depending on the algorithm phase, the blackbox executable will \n   receive at most BB_MAX_BLOCK_SIZE points to evaluate. \n  \n . When this parameter is greater than one, the number of evaluations \n   may exceed the MAX_BB_EVAL stopping criterion. \n  \n . Argument: integer > 0. \n  \n . Example: BB_MAX_BLOCK_SIZE 3 \n            The blackbox executable receives blocks of \n            at most 3 points for evaluation. \n  \n . Default: 1\n\n",  "  advanced block parallel  "  , "true" , "true" , "true" },
+{ "BB_ADAPTIVE_BLOCK_SIZE",  "bool",  "false",  " Adapt the size of blocks of blackbox evaluations to the measured times ",  " \n . When true, the size of the blocks of points sent to the blackbox is \n   chosen between 1 and BB_MAX_BLOCK_SIZE, to minimize the time per \n   evaluation. \n  \n . The time of a block is modeled as a launch overhead plus a time per \n   point. Both are estimated from the wall-clock times of the previous \n   blocks, giving more weight to recent blocks. \n  \n . The block size also depends on the number of points waiting for \n   evaluation and on NB_THREADS_PARALLEL_EVAL: the points are spread \n   over the evaluation threads. \n  \n . The number of blocks of each size, and the estimated times, are \n   reported in the detailed stats (EVAL_STATS_FILE). \n  \n . Argument: bool. \n  \n . Example: BB_ADAPTIVE_BLOCK_SIZE true \n  \n . Default: false\n\n",  "  advanced block parallel adaptive time overhead  "  , "false" , "true" , "true" },
+{ "EVAL_COST_AWARE_DISPATCH",  "bool",  "false",  " Dispatch blackbox evaluations using their predicted evaluation times ",  " \n . When true, the wall-clock time of each blackbox evaluation is recorded, \n   and a model predicts the evaluation time of the points to evaluate. \n   The predicted time of a point is a weighted average of the times of \n   its nearest evaluated points. \n  \n . In non-opportunistic context (EVAL_OPPORTUNISTIC false), the points with \n   the longest predicted evaluation times are evaluated first. The points \n   with short evaluation times then fill the idle threads at the end. \n  \n . With blocks (BB_MAX_BLOCK_SIZE > 1), the blocks are filled so that the \n   predicted evaluation times are spread evenly over the \n   NB_THREADS_PARALLEL_EVAL evaluation threads. \n  \n . Useful when the evaluation time of the blackbox depends on the point, \n   with parallel evaluations. \n  \n . Argument: bool. \n  \n . Example: EVAL_COST_AWARE_DISPATCH true \n  \n . Default: false\n\n",  "  advanced parallel block time cost sort dispatch schedule  "  , "false" , "true" , "true" },
+{ "BB_HEDGING_PERCENTILE",  "size_t",  "INF",  " Duplicate the blackbox evaluations slower than this percentile ",  " \n . When an evaluation thread has no more blocks to evaluate, it starts a \n   duplicate of a block still in progress if the elapsed time per point of \n   this block exceeds the given percentile of the measured blackbox \n   evaluation times. The result of the first evaluation to complete is \n   kept, and the other evaluation is cancelled. \n  \n . The slowest block is duplicated first. A block is duplicated at most once. \n  \n . At least 10 measured blackbox evaluations are required before the \n   first duplicate is started. \n  \n . Useful when some blackbox evaluations are abnormally slow (straggler \n   machines, hanging processes), with parallel evaluations \n   (NB_THREADS_PARALLEL_EVAL > 1). The blackbox must give the same outputs \n   for the same point. \n  \n . Each point is counted once in the blackbox evaluations. \n  \n . Argument: a positive integer between 1 and 99, or INF for no duplicates. \n  \n . Example: BB_HEDGING_PERCENTILE 95 \n  \n . Default: INF\n\n",  "  advanced parallel straggler duplicate hedge hedging tail latency percentile  "  , "false" , "true" , "true" },
+{ "DETERMINISTIC_PARALLEL",  "bool",  "false",  " Same results for any number of evaluation threads ",  " \n . When true, the blocks of evaluations are evaluated in parallel, but their \n   results are committed in the order of the blocks: update of the counters, \n   of the cache, of the incumbents, of the success and of the stop reasons. \n   A run gives the same trajectory for any value of NB_THREADS_PARALLEL_EVAL. \n  \n . When the evaluations are stopped by a block (opportunistic success, maximum \n   number of evaluations), the blocks after it that are already evaluated are \n   discarded. Their evaluations are not counted, as with a single evaluation \n   thread. \n  \n . The blackbox must give the same outputs for the same point. \n  \n . Incompatible with BB_ADAPTIVE_BLOCK_SIZE and EVAL_COST_AWARE_DISPATCH, \n   which depend on the measured evaluation times. \n  \n . Argument: bool. \n  \n . Example: DETERMINISTIC_PARALLEL true \n  \n . Default: false\n\n",  "  advanced parallel deterministic reproducible reproducibility order thread  "  , "false" , "true" , "true" },
+{ "EVAL_OPPORTUNISTIC_CANCEL",  "bool",  "false",  " Cancel the evaluations in progress after an opportunistic success ",  " \n . When true, the success of an opportunistic evaluation cancels the blocks \n   of the same main thread that are still evaluated by other threads. \n   Blackbox executables are killed. A user eval_x or eval_block in library \n   mode is cancelled if it calls Evaluator::evalStopRequested(). \n  \n . The evaluation threads are available for the next iteration without \n   waiting for the evaluations in progress to complete. \n  \n . Cancelled evaluations get the status EVAL_CANCELLED. They are not counted \n   and the points may be evaluated again. \n  \n . Used with EVAL_OPPORTUNISTIC and NB_THREADS_PARALLEL_EVAL greater than 1. \n  \n . Incompatible with DETERMINISTIC_PARALLEL. \n  \n . Argument: bool. \n  \n . Example: EVAL_OPPORTUNISTIC_CANCEL true \n  \n . Default: false\n\n",  "  advanced opportunistic oppor parallel thread cancel cancelled kill success  "  , "false" , "true" , "true" },
+{ "NB_THREADS_SURROGATE_EVAL",  "size_t",  "0",  " Number of threads for static surrogate evaluations run in a pipeline with blackbox evaluations ",  " \n . Used with EVAL_QUEUE_SORT SURROGATE. By default (0), all the trial points \n   are evaluated with the static surrogate before the blackbox evaluations \n   start, and both use the NB_THREADS_PARALLEL_EVAL threads. \n  \n . When positive, this number of threads is added to the \n   NB_THREADS_PARALLEL_EVAL threads. The added threads evaluate the blocks of \n   trial points with the static surrogate, while the other threads evaluate \n   them with the blackbox. A blackbox thread always picks the best block \n   according to the surrogate values available at that time. \n  \n . The surrogate evaluations are counted as with EVAL_QUEUE_SORT SURROGATE. \n  \n . Requires OpenMP and opportunistic evaluation. Ignored with \n   DETERMINISTIC_PARALLEL. \n  \n . Argument: one non-negative integer. \n  \n . Example: NB_THREADS_SURROGATE_EVAL 2 \n  \n . Default: 0\n\n",  "  advanced parallel openmp pipeline surrogate sort static thread  "  , "false" , "false" , "true" },
 { "SURROGATE_MAX_BLOCK_SIZE",  "size_t",  "1",  " Size of blocks of points, to be used for parallel evaluations ",  " \n . Maximum size of a block of evaluations send to the surrogate \n   executable at once. Surrogate executable can manage parallel \n   evaluations on its own. \n  \n . Depending on the algorithm phase, the surrogate executable will \n   receive at most SURROGATE_MAX_BLOCK_SIZE points to evaluate. \n  \n . Argument: integer > 0. \n  \n . Example: SURROGATE_MAX_BLOCK_SIZE INF \n            The surrogate executable receives blocks with \n            all points evailable for evaluation. \n  \n . Default: 1\n\n",  "  advanced block parallel surrogate  "  , "true" , "true" , "true" },
 { "EVAL_QUEUE_CLEAR",  "bool",  "true",  " Opportunistic strategy: Flag to clear EvaluatorControl queue between each run ",  " \n  \n . Opportunistic strategy: If a success is found, clear evaluation queue of \n   other points. \n  \n . If this flag is false, the points in the evaluation queue that are not yet \n   evaluated might be evaluated later. \n  \n . If this flag is true, the points in the evaluation queue that are not yet \n   evaluated will be flushed. \n  \n . Outside of opportunistic strategy, this flag has no effect. \n  \n . Default: true\n\n",  "  advanced opportunistic oppor eval evals evaluation evaluations clear flush  "  , "true" , "true" , "true" },
+{ "EVAL_QUEUE_CHECKPOINT_FILE",  "std::string",  "",  " Binary file to checkpoint the evaluations that are not completed ",  " \n . The points waiting in the evaluation queue, the points being evaluated and \n   the evaluation counters are written periodically in this binary file. \n  \n . When a run stops before its end (crash, kill), the next run with the same \n   file reads it back: the counters are restored and the points that were not \n   completed are evaluated first, with X0. They are not lost nor regenerated. \n  \n . The file is removed at the end of a run that completes. \n  \n . Use with CACHE_FILE: the cache file is also written at each checkpoint, \n   to keep the completed evaluations. \n  \n . The file is not portable between platforms. \n  \n . Argument: one string. \n  \n . Example: EVAL_QUEUE_CHECKPOINT_FILE checkpoint.bin \n  \n . Default: Empty string.\n\n",  "  advanced checkpoint restart crash resume queue file  "  , "false" , "false" , "true" },
+{ "EVAL_QUEUE_CHECKPOINT_INTERVAL",  "size_t",  "60",  " Minimum time between two checkpoints of the evaluations, in seconds ",  " \n . Used with EVAL_QUEUE_CHECKPOINT_FILE. \n  \n . The checkpoint is written after the evaluation of a block, when this time \n   has elapsed since the previous checkpoint. \n  \n . Argument: one nonnegative integer. \n  \n . Example: EVAL_QUEUE_CHECKPOINT_INTERVAL 300 \n  \n . Default: 60\n\n",  "  advanced checkpoint restart crash resume queue time interval  "  , "false" , "false" , "true" },
+{ "EVAL_METRICS_FILE",  "std::string",  "",  " File for the histograms of the evaluation latencies and queue depths ",  " \n . The latency of the evaluations, the time spent by the points in the \n   evaluation queue, the sizes of the blocks and the depth of the queue are \n   recorded per evaluator type and per main thread, in histograms. \n  \n . The percentiles of the histograms and the utilization of the evaluation \n   threads are appended periodically to this file, one line per evaluator \n   type and main thread, as key=value pairs. A local scraper can tail it. \n  \n . The histograms are also in the detailed stats (EVAL_STATS_FILE). \n  \n . Argument: one string. \n  \n . Example: EVAL_METRICS_FILE metrics.txt \n  \n . Default: Empty string.\n\n",  "  advanced latency histogram queue depth telemetry metrics utilization file  "  , "false" , "false" , "true" },
+{ "EVAL_METRICS_INTERVAL",  "size_t",  "10",  " Minimum time between two writes of the metrics file, in seconds ",  " \n . Used with EVAL_METRICS_FILE. \n  \n . The metrics are written after the evaluation of a block, when this time \n   has elapsed since the previous write, and at the end of the run. \n  \n . Argument: one nonnegative integer. \n  \n . Example: EVAL_METRICS_INTERVAL 60 \n  \n . Default: 10\n\n",  "  advanced latency histogram queue depth telemetry metrics time interval  "  , "false" , "false" , "true" },
 { "EVAL_SURROGATE_COST",  "size_t",  "INF",  " Cost of the surrogate function versus the true function ",  " \n   . Cost of the surrogate function relative to the true function \n  \n   . Argument: one nonnegative integer. \n  \n   . INF means there is no cost \n  \n   . Examples: \n         EVAL_SURROGATE_COST 3    # three surrogate evaluations count as one blackbox \n                                  # evaluation: the surrogate is three times faster \n         EVAL_SURROGATE_COST INF  # set to infinity: A surrogate evaluation does \n                                  # not count at all \n  \n   . See also: SURROGATE_EXE, EVAL_SURROGATE_OPTIMIZATION \n . Default: INF\n\n",  "  advanced static surrogate  "  , "true" , "false" , "true" },
 { "MAX_BB_EVAL",  "size_t",  "INF",  " Stopping criterion on the number of blackbox evaluations ",  " \n  \n . Maximum number of blackbox evaluations. When OpenMP is activated, this budget \n maybe exceeded due to parallel evaluations. \n  \n . Argument: one positive integer. \n  \n . An INF value serves to disable the stopping criterion. \n  \n . Does not consider evaluations taken in the cache (cache hits) \n  \n . Example: MAX_BB_EVAL 1000 \n  \n . Default: INF\n\n",  "  basic stop stops stopping max maximum criterion criterions blackbox blackboxes bb  "  , "false" , "true" , "true" },
 { "MAX_BLOCK_EVAL",  "size_t",  "INF",  " Stopping criterion on the number of blocks evaluations ",  " \n  \n . Maximum number of blocks evaluations \n  \n . Argument: one positive integer. \n  \n . An INF value serves to disable the stopping criterion. \n  \n . Example: MAX_BLOCK_EVAL 100 \n  \n . Default: INF\n\n",  "  advances block stop parallel  "  , "true" , "true" , "true" },
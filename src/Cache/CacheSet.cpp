@@ -53,6 +53,7 @@
  */
 #include "../Cache/CacheSet.hpp"
 #include "../Output/OutputQueue.hpp"
+#include "../Output/Trace.hpp"
 #include "../Util/fileutils.hpp"
 #include "../Util/MicroSleep.hpp"
 #include "BBOutputType.hpp"
@@ -66,16 +67,16 @@
 #include <iterator>
 
 // Init static members
+#ifdef _OPENMP
+// Before _single: the cache may use the lock until it is destroyed.
+NOMAD::InstrumentedLock NOMAD::CacheSet::_cacheLock("cacheLock");
+#endif // _OPENMP
 NOMAD::BBOutputTypeList NOMAD::CacheSet::_bbOutputType = NOMAD::BBOutputTypeList();
 NOMAD::ArrayOfDouble NOMAD::CacheSet::_bbEvalFormat = NOMAD::ArrayOfDouble();
 std::unique_ptr<NOMAD::CacheBase> NOMAD::CacheBase::_single = nullptr;
 
 std::atomic<size_t> NOMAD::CacheBase::_nbCacheHits;
 
-#ifdef _OPENMP
-omp_lock_t NOMAD::CacheSet::_cacheLock;
-#endif // _OPENMP
-
 
 // Initialize CacheSet class.
 // To be called by the Constructor.
@@ -96,25 +97,16 @@ void NOMAD::CacheSet::destroy()
     // No need to set lock, assuming there is only one cache and
     // that now it is the end of the run, and we are calling its destructor.
     _cache.clear();
-
-#ifdef _OPENMP
-    omp_destroy_lock(&_cacheLock);
-#endif // _OPENMP
 }
 
 void NOMAD::CacheSet::setInstance(const std::shared_ptr<NOMAD::CacheParameters>& cacheParams,
                                   const NOMAD::BBOutputTypeList& bbOutputType,
                                   const NOMAD::ArrayOfDouble& bbEvalFormat)
 {
-#ifdef _OPENMP
-    #pragma omp critical(initCacheLock)
     {
-#endif // _OPENMP
+        NOMAD_CRITICAL(initCacheLock);
         if (nullptr == _single)
         {
-#ifdef _OPENMP
-            omp_init_lock(&_cacheLock);
-#endif // _OPENMP
             _single = std::unique_ptr<NOMAD::CacheSet>(new CacheSet(cacheParams)) ;
         }
         else if (_single->size() != 0)
@@ -122,9 +114,7 @@ void NOMAD::CacheSet::setInstance(const std::shared_ptr<NOMAD::CacheParameters>&
             std::string err = "Cache is not empty while calling NOMAD::CacheSet::setInstance more than ONCE. Need to reset the cache." ;
             throw NOMAD::Exception(__FILE__, __LINE__, err);
         }
-#ifdef _OPENMP
     }   // end of critical section
-#endif // _OPENMP
 
     _bbOutputType = bbOutputType;
     _bbEvalFormat = bbEvalFormat;
@@ -193,15 +183,16 @@ size_t NOMAD::CacheSet::find(const NOMAD::Point& x, NOMAD::EvalPoint &evalPoint,
                              const NOMAD::EvalType evalType,
                              bool waitIfNotYetAvailable ) const
 {
+    NOMAD::TraceScope traceScope("Cache find", "cache");
     size_t nbFound = 0;
 
     NOMAD::EvalPointSet::const_iterator it;
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     it = _cache.find(NOMAD::EvalPoint(x));
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
     if (it != _cache.end())
     {        
@@ -251,11 +242,11 @@ bool NOMAD::CacheSet::findInCacheForRerun(const NOMAD::Point& x, NOMAD::EvalPoin
 
     NOMAD::EvalPointSet::const_iterator it;
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     it = _cacheForRerun.find(NOMAD::EvalPoint(x));
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
     if (it != _cacheForRerun.end())
     {
@@ -276,6 +267,7 @@ bool NOMAD::CacheSet::smartInsert(const NOMAD::EvalPoint &evalPoint,
                                   short maxNumberEval,
                                   NOMAD::EvalType evalType)
 {
+    NOMAD::TraceScope traceScope("Cache insert", "cache");
     verifyPointComplete(evalPoint);
     verifyPointSize(evalPoint);
 
@@ -288,11 +280,11 @@ bool NOMAD::CacheSet::smartInsert(const NOMAD::EvalPoint &evalPoint,
     bool inserted = false;
     std::pair<NOMAD::EvalPointSet::iterator,bool> ret;   // Return of the insert()
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     ret = _cache.insert(evalPoint);
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
     inserted = ret.second;
     bool canEval = (*ret.first).toEval(maxNumberEval, evalType);
@@ -390,7 +382,7 @@ size_t NOMAD::CacheSet::find(const NOMAD::Eval &refeval,
     evalPointList.clear();
     NOMAD::EvalPointSet::const_iterator it;
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (it = _cache.begin(); it != _cache.end(); ++it)
     {
@@ -406,7 +398,7 @@ size_t NOMAD::CacheSet::find(const NOMAD::Eval &refeval,
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
 
     return evalPointList.size();
@@ -429,7 +421,7 @@ size_t NOMAD::CacheSet::findBest(std::function<bool(const NOMAD::Eval&, const NO
     auto compactComputeType = computeType.Short();
 
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (it = _cache.begin(); it != _cache.end(); ++it)
     {
@@ -481,7 +473,7 @@ size_t NOMAD::CacheSet::findBest(std::function<bool(const NOMAD::Eval&, const NO
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
 
     return evalPointList.size();
@@ -492,7 +484,7 @@ bool NOMAD::CacheSet::hasFeas(const NOMAD::FHComputeType& computeType) const
     bool ret = false;
 
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (const auto& it : _cache)
     {
@@ -508,7 +500,7 @@ bool NOMAD::CacheSet::hasFeas(const NOMAD::FHComputeType& computeType) const
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
 
     return ret;
@@ -520,7 +512,7 @@ bool NOMAD::CacheSet::hasInfeas(const NOMAD::FHComputeType& computeType) const
     bool ret = false;
 
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (const auto& it : _cache)
     {
@@ -536,7 +528,7 @@ bool NOMAD::CacheSet::hasInfeas(const NOMAD::FHComputeType& computeType) const
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
 
     return ret;
@@ -557,7 +549,7 @@ size_t NOMAD::CacheSet::find(const NOMAD::Point & X,
     bool errSizeDisplayed = false;  // Error about size to be displayed only once.
     NOMAD::EvalPointSet::const_iterator it;
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (it = _cache.begin(); it != _cache.end(); ++it)
     {
@@ -586,7 +578,7 @@ size_t NOMAD::CacheSet::find(const NOMAD::Point & X,
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
     return evalPointList.size();
 }
@@ -598,7 +590,7 @@ size_t NOMAD::CacheSet::find(std::function<bool(const NOMAD::EvalPoint&)> crit,
     evalPointList.clear();
     NOMAD::EvalPointSet::const_iterator it;
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (it = _cache.begin(); it != _cache.end(); ++it)
     {
@@ -609,7 +601,7 @@ size_t NOMAD::CacheSet::find(std::function<bool(const NOMAD::EvalPoint&)> crit,
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
 
     return evalPointList.size();
@@ -621,7 +613,7 @@ void NOMAD::CacheSet::browse(std::function<void(const NOMAD::EvalPoint&)> crit)
 
     NOMAD::EvalPointSet::const_iterator it;
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (it = _cache.begin(); it != _cache.end(); ++it)
     {
@@ -629,7 +621,7 @@ void NOMAD::CacheSet::browse(std::function<void(const NOMAD::EvalPoint&)> crit)
         crit(evalPoint);
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
 }
 
@@ -641,7 +633,7 @@ size_t NOMAD::CacheSet::find(std::function<bool(const NOMAD::EvalPoint&)> crit1,
 
     NOMAD::EvalPointSet::const_iterator it;
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (it = _cache.begin(); it != _cache.end(); ++it)
     {
@@ -652,7 +644,7 @@ size_t NOMAD::CacheSet::find(std::function<bool(const NOMAD::EvalPoint&)> crit1,
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
     return evalPointList.size();
 }
@@ -662,6 +654,7 @@ size_t NOMAD::CacheSet::findBestFeas(std::vector<EvalPoint> &evalPointList,
                                      const Point& fixedVariable,
                                      const FHComputeType & completeComputeType) const
 {
+    NOMAD::TraceScope traceScope("Cache find best feasible", "cache");
     evalPointList.clear();
     auto compactComputeType = completeComputeType.Short();
     auto computeType = compactComputeType.computeType;
@@ -691,7 +684,7 @@ size_t NOMAD::CacheSet::findBestFeas(std::vector<EvalPoint> &evalPointList,
     std::list<NOMAD::EvalPoint> tmpEvalPointList;
     NOMAD::EvalPointSet::const_iterator itCache;
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (itCache = _cache.begin(); itCache != _cache.end(); ++itCache)
     {
@@ -851,7 +844,7 @@ size_t NOMAD::CacheSet::findBestFeas(std::vector<EvalPoint> &evalPointList,
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
     std::copy(tmpEvalPointList.begin(), tmpEvalPointList.end(), std::back_inserter(evalPointList));
     return evalPointList.size();
@@ -864,6 +857,7 @@ size_t NOMAD::CacheSet::findBestInf(std::vector<EvalPoint> &evalPointList,
                                     const Point& fixedVariable,
                                     const FHComputeType& completeComputeType) const
 {
+    NOMAD::TraceScope traceScope("Cache find best infeasible", "cache");
     evalPointList.clear();
     
     auto evalType = completeComputeType.evalType;
@@ -886,7 +880,7 @@ size_t NOMAD::CacheSet::findBestInf(std::vector<EvalPoint> &evalPointList,
     NOMAD::Double leastInfRefH(NOMAD::INF);
     NOMAD::ArrayOfDouble leastInfRefFs(nobj,NOMAD::INF);
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (itCache = _cache.begin(); itCache != _cache.end(); ++itCache)
     {
@@ -973,7 +967,7 @@ size_t NOMAD::CacheSet::findBestInf(std::vector<EvalPoint> &evalPointList,
     }
 
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
     return evalPointList.size();
 }
@@ -984,6 +978,7 @@ size_t NOMAD::CacheSet::findFilterInf(std::vector<NOMAD::EvalPoint> &evalPointLi
                                       const Point& fixedVariable,
                                       const FHComputeType & completeComputeType) const
 {
+    NOMAD::TraceScope traceScope("Cache find infeasible filter", "cache");
     auto evalType = completeComputeType.evalType;
     auto compactComputeType = completeComputeType.Short();
     auto computeType = compactComputeType.computeType;
@@ -1013,7 +1008,7 @@ size_t NOMAD::CacheSet::findFilterInf(std::vector<NOMAD::EvalPoint> &evalPointLi
     std::list<NOMAD::EvalPoint> tmpEvalPointList;
     NOMAD::EvalPointSet::const_iterator itCache;
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (itCache = _cache.begin(); itCache != _cache.end(); ++itCache)
     {
@@ -1082,7 +1077,7 @@ size_t NOMAD::CacheSet::findFilterInf(std::vector<NOMAD::EvalPoint> &evalPointLi
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
     std::copy(tmpEvalPointList.begin(), tmpEvalPointList.end(), std::back_inserter(evalPointList));
     return evalPointList.size();
@@ -1099,6 +1094,7 @@ size_t NOMAD::CacheSet::findFilterInf(std::vector<NOMAD::EvalPoint> &evalPointLi
 // Returns true if update succeeded, false if there was an error.
 bool NOMAD::CacheSet::update(const NOMAD::EvalPoint& evalPoint, NOMAD::EvalType  evalType, const NOMAD::MeshBasePtr mesh)
 {
+    NOMAD::TraceScope traceScope("Cache update", "cache");
     bool updateOk = false;
 
     if (nullptr == evalPoint.getEval(evalType))
@@ -1112,7 +1108,7 @@ bool NOMAD::CacheSet::update(const NOMAD::EvalPoint& evalPoint, NOMAD::EvalType
 
     NOMAD::EvalPointSet::const_iterator it;
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     it = _cache.find(evalPoint);
     if (it == _cache.end())
@@ -1146,7 +1142,7 @@ bool NOMAD::CacheSet::update(const NOMAD::EvalPoint& evalPoint, NOMAD::EvalType
         updateOk = true;
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
 
     return updateOk;
@@ -1157,11 +1153,11 @@ bool NOMAD::CacheSet::update(const NOMAD::EvalPoint& evalPoint, NOMAD::EvalType
 bool NOMAD::CacheSet::clear()
 {
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     _cache.clear();
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
 
     // Note: We might not want to reset - in that case, remove this line.
@@ -1199,6 +1195,7 @@ void NOMAD::CacheSet::clearModelEval(const int mainThreadNum)
 // Note June 2021: We are now ignoring points for which eval status is not EVAL_OK.
 void NOMAD::CacheSet::purge()
 {
+    NOMAD::TraceScope traceScope("Cache purge", "cache");
     std::cout << "Warning: Calling Cache purge. Size is " << _cache.size() << " max is " << _maxSize << ". Some points will be removed from the cache." << std::endl;
     if ( _maxSize== NOMAD::INF_SIZE_T || _cache.size() < _maxSize)
     {
@@ -1208,7 +1205,7 @@ void NOMAD::CacheSet::purge()
     size_t nbRemovedLast = 1;
 
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
 
     while (_cache.size() >= _maxSize)
@@ -1273,7 +1270,7 @@ void NOMAD::CacheSet::purge()
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
 }
 
@@ -1311,7 +1308,7 @@ size_t NOMAD::CacheSet::computeMeanF(NOMAD::Double &mean) const
 void NOMAD::CacheSet::processOnAllPoints(void (*func)(NOMAD::EvalPoint&), const int mainThreadNum)
 {
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (const auto& it : _cache)
     {
@@ -1323,7 +1320,7 @@ void NOMAD::CacheSet::processOnAllPoints(void (*func)(NOMAD::EvalPoint&), const
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
 }
 
@@ -1331,7 +1328,7 @@ void NOMAD::CacheSet::processOnAllPoints(void (*func)(NOMAD::EvalPoint&), const
 void NOMAD::CacheSet::deleteModelEvalOnly(const int mainThreadNum)
 {
 #ifdef _OPENMP
-    omp_set_lock(&_cacheLock);
+    _cacheLock.set();
 #endif // _OPENMP
     for (auto it = _cache.begin(); it != _cache.end();)
     {
@@ -1362,7 +1359,7 @@ void NOMAD::CacheSet::deleteModelEvalOnly(const int mainThreadNum)
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_cacheLock);
+    _cacheLock.unset();
 #endif // _OPENMP
 }
 
@@ -1371,11 +1368,22 @@ void NOMAD::CacheSet::deleteModelEvalOnly(const int mainThreadNum)
 // This function will use operator<< defined below
 bool NOMAD::CacheSet::write() const
 {
+    NOMAD::TraceScope traceScope("Cache write", "cache");
     OUTPUT_INFO_START
     std::string s = "Write cache file " + _filename;
     NOMAD::OutputQueue::Add(s);
     OUTPUT_INFO_END
-    return NOMAD::write(*this, _filename);
+
+    // The cache may be written during the evaluations (EVAL_QUEUE_CHECKPOINT_FILE).
+#ifdef _OPENMP
+    _cacheLock.set();
+#endif // _OPENMP
+    const bool writeSuccess = NOMAD::write(*this, _filename);
+#ifdef _OPENMP
+    _cacheLock.unset();
+#endif // _OPENMP
+
+    return writeSuccess;
 }
 
 
@@ -1383,6 +1391,7 @@ bool NOMAD::CacheSet::write() const
 // This function will use operator>> defined below.
 bool NOMAD::CacheSet::read()
 {
+    NOMAD::TraceScope traceScope("Cache read", "cache");
     bool fileRead = false;
     if (NOMAD::checkReadFile(_filename))
     {
@@ -60,6 +60,7 @@
 #endif  // _OPENMP
 #include "../Cache/CacheBase.hpp"
 #include "../Eval/EvalPoint.hpp"
+#include "../Util/InstrumentedLock.hpp"
 
 #include "../nomad_platform.hpp"
 #include "../nomad_nsbegin.hpp"
@@ -75,7 +76,7 @@ private:
 
     /// Lock for multithreading
 #ifdef _OPENMP
-    static omp_lock_t  _cacheLock;
+    static InstrumentedLock  _cacheLock;
 #endif // _OPENMP
 
     static BBOutputTypeList    _bbOutputType;  ///< Corresponds to parameter BB_OUTPUT_TYPE used for this cache
@@ -93,6 +93,22 @@ NOMAD::BBOutput::BBOutput(const ArrayOfDouble & bbo)
 }
 
 
+NOMAD::BBOutput::BBOutput(const ArrayOfDouble & bbo, const bool evalOk)
+  : _rawBBO(),
+    _BBO(bbo),
+    _evalOk(evalOk)
+{
+    for (size_t i = 0; i < _BBO.size(); i++)
+    {
+        if (i > 0)
+        {
+            _rawBBO += " ";
+        }
+        _rawBBO += _BBO[i].tostring();
+    }
+}
+
+
 void NOMAD::BBOutput::setBBO(const std::string &bbOutputString, const bool evalOk)
 {
     _rawBBO = bbOutputString;
@@ -102,6 +102,14 @@ public:
      */
     explicit BBOutput(const ArrayOfDouble &bbo);
 
+    /// Constructor #3
+    /**
+     The raw outputs are written with full precision.
+     \param bbo     The outputs of the blackbox as a array of double -- \b IN.
+     \param evalOk  The eval ok flag -- \b IN.
+     */
+    BBOutput(const ArrayOfDouble &bbo, const bool evalOk);
+
     /*---------*/
     /* Get/Set */
     /*---------*/
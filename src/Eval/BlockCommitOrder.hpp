@@ -0,0 +1,101 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   BlockCommitOrder.hpp
+ \brief  Commit of the results of blocks of evaluations in a canonical order
+ \author Christophe Tribes
+ \date   October 2026
+ \see    BlockCommitOrder.cpp
+ */
+#ifndef __NOMAD_4_5_BLOCKCOMMITORDER__
+#define __NOMAD_4_5_BLOCKCOMMITORDER__
+
+#include <atomic>
+#include <cstddef>
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Turns to commit the results of blocks, in the order of the block indices.
+/**
+ Used with DETERMINISTIC_PARALLEL. The blocks are evaluated in parallel, but
+ the thread that evaluated a block waits for its turn before updating the
+ counters, the cache, the success and the stop reasons. The turn of block k
+ comes when the blocks 0 to k-1 are committed. The results are thus the same
+ as with a single evaluation thread.
+
+ When its turn comes, a block may have to be discarded: a single evaluation
+ thread would not have evaluated it because a previous block stopped the
+ evaluations.
+ */
+class DLL_EVAL_API BlockCommitOrder
+{
+private:
+    std::atomic<size_t> _nextBlock; ///< Index of the block to commit next
+    bool                _discarded; ///< The block with the turn is discarded. Accessed by the thread with the turn only.
+
+public:
+    /// Constructor. The turn is to block 0.
+    explicit BlockCommitOrder();
+
+    /// Wait until the blocks before a block are committed.
+    /**
+     \param blockIndex  The block -- \b IN.
+     */
+    void waitTurn(const size_t blockIndex) const;
+
+    /// The block is committed. The turn goes to the next block.
+    void endTurn(const size_t blockIndex);
+
+    bool hasTurn(const size_t blockIndex) const { return (_nextBlock == blockIndex); }
+
+    void setDiscarded(const bool discarded) { _discarded = discarded; }
+    bool isDiscarded() const { return _discarded; }
+};
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_BLOCKCOMMITORDER__
@@ -0,0 +1,179 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   BlockSizeAdapter.cpp
+ \brief  Choice of the size of blocks from measured evaluation times
+ \author Christophe Tribes
+ \date   October 2026
+ \see    BlockSizeAdapter.hpp
+ */
+#include "../Eval/BlockSizeAdapter.hpp"
+#include "../Util/defines.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+NOMAD::BlockSizeAdapter::BlockSizeAdapter()
+  : _sumW(0.0),
+    _sumN(0.0),
+    _sumNN(0.0),
+    _sumT(0.0),
+    _sumNT(0.0),
+    _launchOverhead(-1.0),
+    _timePerPoint(-1.0),
+    _lastBlockSize(0),
+    _blockSizeCount()
+{
+}
+
+
+void NOMAD::BlockSizeAdapter::addMeasure(const size_t blockSize, const double wallTime)
+{
+    if (0 == blockSize || wallTime < 0)
+    {
+        return;
+    }
+
+    _blockSizeCount[blockSize]++;
+    _lastBlockSize = blockSize;
+
+    const double n = static_cast<double>(blockSize);
+    _sumW  = FORGETTING_FACTOR * _sumW  + 1.0;
+    _sumN  = FORGETTING_FACTOR * _sumN  + n;
+    _sumNN = FORGETTING_FACTOR * _sumNN + n * n;
+    _sumT  = FORGETTING_FACTOR * _sumT  + wallTime;
+    _sumNT = FORGETTING_FACTOR * _sumNT + n * wallTime;
+
+    // Weighted variance of the block sizes. The fit needs different block sizes.
+    const double det = _sumW * _sumNN - _sumN * _sumN;
+    if (det > 0.1 * _sumW * _sumW)
+    {
+        _timePerPoint = (_sumW * _sumNT - _sumN * _sumT) / det;
+        _launchOverhead = (_sumT - _timePerPoint * _sumN) / _sumW;
+        if (_timePerPoint < 0)
+        {
+            _timePerPoint = 0.0;
+            _launchOverhead = _sumT / _sumW;
+        }
+        else if (_launchOverhead < 0)
+        {
+            _launchOverhead = 0.0;
+            _timePerPoint = _sumNT / _sumNN;
+        }
+    }
+    else if (_timePerPoint >= 0)
+    {
+        // Same block sizes recently: follow the level of the times, keeping
+        // the ratio between overhead and time per point.
+        const double meanN = _sumN / _sumW;
+        const double model = _launchOverhead + _timePerPoint * meanN;
+        if (model > 0)
+        {
+            const double ratio = (_sumT / _sumW) / model;
+            _launchOverhead *= ratio;
+            _timePerPoint *= ratio;
+        }
+    }
+}
+
+
+size_t NOMAD::BlockSizeAdapter::computeBlockSize(const size_t queueSize,
+                                                 const size_t nbThreads,
+                                                 const size_t maxBlockSize) const
+{
+    const size_t nMax = std::max<size_t>(1, std::min(maxBlockSize, queueSize));
+    if (1 == nMax)
+    {
+        return 1;
+    }
+
+    if (_timePerPoint < 0)
+    {
+        // No estimates yet: start with the largest blocks, then try smaller ones.
+        size_t n = (0 == _lastBlockSize) ? nMax : std::max<size_t>(1, _lastBlockSize / 2);
+        if (n == _lastBlockSize)
+        {
+            n = 2;
+        }
+        return std::min(n, nMax);
+    }
+
+    const double q = static_cast<double>(queueSize);
+    const double p = static_cast<double>(std::max<size_t>(1, nbThreads));
+    size_t bestN = 1;
+    double bestTime = NOMAD::INF;
+    for (size_t n = 1; n <= nMax; n++)
+    {
+        const double rounds = std::ceil(q / (static_cast<double>(n) * p));
+        const double time = rounds * (_launchOverhead + _timePerPoint * static_cast<double>(n));
+        // Prefer smaller blocks when equivalent.
+        if (time < bestTime * (1.0 - 1e-9))
+        {
+            bestTime = time;
+            bestN = n;
+        }
+    }
+
+    return bestN;
+}
+
+
+std::string NOMAD::BlockSizeAdapter::displayBlockSizeCount() const
+{
+    std::string s;
+    for (const auto& sizeCount : _blockSizeCount)
+    {
+        if (!s.empty())
+        {
+            s += " ";
+        }
+        s += std::to_string(sizeCount.first) + ":" + std::to_string(sizeCount.second);
+    }
+
+    return s;
+}
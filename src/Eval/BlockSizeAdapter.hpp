@@ -0,0 +1,125 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   BlockSizeAdapter.hpp
+ \brief  Choice of the size of blocks from measured evaluation times
+ \author Christophe Tribes
+ \date   October 2026
+ \see    BlockSizeAdapter.cpp
+ */
+
+#ifndef __NOMAD_4_5_BLOCKSIZEADAPTER__
+#define __NOMAD_4_5_BLOCKSIZEADAPTER__
+
+#include <map>
+#include <string>
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Class to adapt the size of blocks of blackbox evaluations (BB_ADAPTIVE_BLOCK_SIZE).
+/**
+ The wall-clock time of a block of \c n points is modeled as \c T(n) = a + b*n, where
+ \c a is the launch overhead of the blackbox and \c b is the time per point. Both are
+ estimated online by weighted least squares. Older measures are forgotten
+ gradually, so that the estimates follow the region of the search space.
+
+ With \c p evaluation threads and \c q points in the queue, a block size \c n
+ needs \c ceil(q/(n*p)) rounds of blocks. The chosen block size minimizes the
+ time per evaluation, \c ceil(q/(n*p))*T(n)/q. Smaller blocks are preferred
+ when equivalent, since opportunism applies after each block.
+
+ When the estimates are not available (all measured blocks have the same size),
+ other block sizes are tried.
+
+ \note This class is not thread-safe. The EvaluatorControl protects it.
+ */
+class DLL_EVAL_API BlockSizeAdapter
+{
+private:
+    /// Weight of older measures, for each new measure.
+    static constexpr double FORGETTING_FACTOR = 0.9;
+
+    /// Weighted sums for the least squares fit of T(n) = a + b*n.
+    double _sumW, _sumN, _sumNN, _sumT, _sumNT;
+
+    double _launchOverhead;     ///< Estimated a, in seconds. Negative if unknown.
+    double _timePerPoint;       ///< Estimated b, in seconds. Negative if unknown.
+
+    size_t _lastBlockSize;      ///< Size of the last block measured.
+
+    std::map<size_t, size_t> _blockSizeCount;   ///< Number of blocks evaluated, for each block size.
+
+public:
+    /// Constructor
+    BlockSizeAdapter();
+
+    /// Add the measured wall-clock time of a block.
+    /**
+     \param blockSize   Number of points evaluated in the block -- \b IN.
+     \param wallTime    Wall-clock time of the evaluation of the block, in seconds -- \b IN.
+     */
+    void addMeasure(const size_t blockSize, const double wallTime);
+
+    /// Compute the size of the next block.
+    /**
+     \param queueSize       Number of points waiting for evaluation -- \b IN.
+     \param nbThreads       Number of threads for parallel evaluation -- \b IN.
+     \param maxBlockSize    Maximum block size (BB_MAX_BLOCK_SIZE) -- \b IN.
+     \return                The block size, between 1 and \c maxBlockSize.
+     */
+    size_t computeBlockSize(const size_t queueSize, const size_t nbThreads, const size_t maxBlockSize) const;
+
+    double getLaunchOverhead() const { return _launchOverhead; }
+    double getTimePerPoint() const { return _timePerPoint; }
+
+    /// Number of blocks evaluated, for each block size. Ex. "1:3 4:12".
+    std::string displayBlockSizeCount() const;
+};
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_BLOCKSIZEADAPTER__
@@ -66,7 +66,8 @@ NOMAD::Eval::Eval()
     _preEvalStatus(NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED),
     _bbOutput(""),
     _bbOutputTypeList(),
-    _bbOutputComplete(false)
+    _bbOutputComplete(false),
+    _wallTime(-1.0)
 {
     _moInfo = std::make_unique<MOInfo>();
 }
@@ -80,7 +81,8 @@ NOMAD::Eval::Eval(const std::shared_ptr<NOMAD::EvalParameters>& params,
   : _evalStatus(NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED),
     _preEvalStatus(NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED),
     _bbOutput(bbOutput),
-    _bbOutputTypeList(params->getAttributeValue<NOMAD::BBOutputTypeList>("BB_OUTPUT_TYPE"))
+    _bbOutputTypeList(params->getAttributeValue<NOMAD::BBOutputTypeList>("BB_OUTPUT_TYPE")),
+    _wallTime(-1.0)
 {
     _bbOutputComplete = _bbOutput.isComplete(_bbOutputTypeList);
 
@@ -105,7 +107,8 @@ NOMAD::Eval::Eval(const NOMAD::Eval &eval)
     _preEvalStatus(eval._preEvalStatus),
     _bbOutput(eval._bbOutput),
     _bbOutputTypeList(eval._bbOutputTypeList),
-    _bbOutputComplete(eval._bbOutputComplete)
+    _bbOutputComplete(eval._bbOutputComplete),
+    _wallTime(eval._wallTime)
 {
     _moInfo = std::make_unique<NOMAD::MOInfo>(*eval._moInfo);
 }
@@ -123,6 +126,7 @@ NOMAD::Eval& NOMAD::Eval::operator=(const NOMAD::Eval& eval)
     _bbOutput = eval._bbOutput;
     _bbOutputTypeList = eval._bbOutputTypeList;
     _bbOutputComplete = eval._bbOutputComplete;
+    _wallTime = eval._wallTime;
 
     // Deep copy
     _moInfo = std::make_unique<NOMAD::MOInfo>(*eval._moInfo);
@@ -150,7 +154,9 @@ bool NOMAD::Eval::canBeReEvaluated() const
     if (   _evalStatus == NOMAD::EvalStatusType::EVAL_OK
         || _evalStatus == NOMAD::EvalStatusType::EVAL_NOT_STARTED
         || _preEvalStatus == NOMAD::EvalStatusType::EVAL_USER_REJECTED
-        || _evalStatus == NOMAD::EvalStatusType::EVAL_ERROR)
+        || _evalStatus == NOMAD::EvalStatusType::EVAL_ERROR
+        || _evalStatus == NOMAD::EvalStatusType::EVAL_TIMEOUT
+        || _evalStatus == NOMAD::EvalStatusType::EVAL_CANCELLED)
     {
         reEval = true;
     }
@@ -168,6 +174,7 @@ bool NOMAD::Eval::goodForCacheFile() const
     if (_evalStatus == NOMAD::EvalStatusType::EVAL_OK
         || _evalStatus == NOMAD::EvalStatusType::EVAL_FAILED
         || _evalStatus == NOMAD::EvalStatusType::EVAL_ERROR
+        || _evalStatus == NOMAD::EvalStatusType::EVAL_TRUNCATED
         || _preEvalStatus == NOMAD::EvalStatusType::EVAL_USER_REJECTED
         || _preEvalStatus == NOMAD::EvalStatusType::EVAL_USER_ACCEPTED)
     {
@@ -433,7 +440,22 @@ void NOMAD::Eval::setBBO(const std::string &bbo,
                          const NOMAD::BBOutputTypeList &bbOutputTypeList,
                          const bool evalOk)
 {
-    _bbOutput = NOMAD::BBOutput(bbo, evalOk);
+    setBBOutput(NOMAD::BBOutput(bbo, evalOk), bbOutputTypeList);
+}
+
+
+void NOMAD::Eval::setBBO(const NOMAD::ArrayOfDouble &bbo,
+                         const NOMAD::BBOutputTypeList &bbOutputTypeList,
+                         const bool evalOk)
+{
+    setBBOutput(NOMAD::BBOutput(bbo, evalOk), bbOutputTypeList);
+}
+
+
+void NOMAD::Eval::setBBOutput(NOMAD::BBOutput bbOutput,
+                              const NOMAD::BBOutputTypeList &bbOutputTypeList)
+{
+    _bbOutput = std::move(bbOutput);
     _bbOutputTypeList = bbOutputTypeList;
     _moInfo = std::make_unique<NOMAD::MOInfo>();
 
@@ -865,6 +887,15 @@ std::string NOMAD::enumStr(const NOMAD::EvalStatusType evalStatus)
         case NOMAD::EvalStatusType::EVAL_WAIT:
             str = "Waiting for evaluation in progress";
             break;
+        case NOMAD::EvalStatusType::EVAL_TIMEOUT:
+            str = "Evaluation timed out (may be submitted again)";
+            break;
+        case NOMAD::EvalStatusType::EVAL_CANCELLED:
+            str = "Evaluation cancelled (may be submitted again)";
+            break;
+        case NOMAD::EvalStatusType::EVAL_TRUNCATED:
+            str = "Evaluation truncated (low fidelity)";
+            break;
         case NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED:
             str = "Undefined evaluation status";
             break;
@@ -907,6 +938,15 @@ std::ostream& NOMAD::operator<<(std::ostream& out, const NOMAD::EvalStatusType &
         case NOMAD::EvalStatusType::EVAL_WAIT:
             out << "EVAL_WAIT";
             break;
+        case NOMAD::EvalStatusType::EVAL_TIMEOUT:
+            out << "EVAL_TIMEOUT";
+            break;
+        case NOMAD::EvalStatusType::EVAL_CANCELLED:
+            out << "EVAL_CANCELLED";
+            break;
+        case NOMAD::EvalStatusType::EVAL_TRUNCATED:
+            out << "EVAL_TRUNCATED";
+            break;
         case NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED:
             out << "EVAL_STATUS_UNDEFINED";
             break;
@@ -966,6 +1006,18 @@ std::istream& NOMAD::operator>>(std::istream& is, NOMAD::EvalStatusType &evalSta
     {
         evalStatus = NOMAD::EvalStatusType::EVAL_WAIT;
     }
+    else if ("EVAL_TIMEOUT" == s)
+    {
+        evalStatus = NOMAD::EvalStatusType::EVAL_TIMEOUT;
+    }
+    else if ("EVAL_CANCELLED" == s)
+    {
+        evalStatus = NOMAD::EvalStatusType::EVAL_CANCELLED;
+    }
+    else if ("EVAL_TRUNCATED" == s)
+    {
+        evalStatus = NOMAD::EvalStatusType::EVAL_TRUNCATED;
+    }
     else if ("EVAL_STATUS_UNDEFINED" == s)
     {
         evalStatus = NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED;
@@ -85,6 +85,9 @@ enum class EvalStatusType
     EVAL_OK,                ///< Correct evaluation
     EVAL_IN_PROGRESS,       ///< Evaluation in progress
     EVAL_WAIT,              ///< Evaluation in progress for another instance of the same point: Wait for evaluation to be done.
+    EVAL_TIMEOUT,           ///< Evaluation stopped after BB_EVAL_TIMEOUT. Not a failure; may be submitted again.
+    EVAL_CANCELLED,         ///< Evaluation cancelled by the algorithm before completion. May be submitted again.
+    EVAL_TRUNCATED,         ///< Evaluation stopped early from its intermediate outputs (BB_EVAL_MULTI_FIDELITY). Low-fidelity outputs, never an incumbent.
     EVAL_STATUS_UNDEFINED   ///< Undefined evaluation status
 };
 
@@ -114,6 +117,7 @@ private:
     BBOutputTypeList _bbOutputTypeList; ///< List of output types: OBJ, PB, EB etc.
     bool _bbOutputComplete;             ///< All bbo outputs have a valid value for functions (OBJ, PB and EB).
     std::unique_ptr<MOInfo> _moInfo; ///< Multiobjective information; precomputed to have more performance
+    double _wallTime;                   ///< Wall-clock evaluation time in seconds. Negative if unknown.
     
 public:
 
@@ -164,6 +168,10 @@ public:
     void setPreEvalStatus(const EvalStatusType &evalStatus) { _preEvalStatus = evalStatus; }
     bool isEvalOk () const { return _evalStatus == EvalStatusType::EVAL_OK; }
 
+    /// Wall-clock evaluation time in seconds. For a block, the time of the block divided by its number of points.
+    double getWallTime() const { return _wallTime; }
+    void setWallTime(const double wallTime) { _wallTime = wallTime; }
+
     bool isBBOutputComplete() const { return _bbOutputComplete; }
     BBOutput getBBOutput() const { return _bbOutput; }
     ArrayOfDouble getBBOutputByType( const BBOutputType & bboType );
@@ -181,6 +189,11 @@ public:
                 const BBOutputTypeList &bbOutputTypeList,
                 const bool evalOk = true);
 
+    /// Set blackbox output from values, without parsing a string
+    void setBBO(const ArrayOfDouble &bbo,
+                const BBOutputTypeList &bbOutputTypeList,
+                const bool evalOk = true);
+
     /*---------------*/
     /* Other methods */
     /*---------------*/
@@ -198,9 +211,10 @@ public:
 
     /** Should this point be saved to cache file? Based on the eval status only.
      * These eval statuses are good: EVAL_OK, EVAL_FAILED, EVAL_USER_REJECTED,
-     * EVAL_ERROR.
+     * EVAL_ERROR, EVAL_TRUNCATED.
      * These eval statuses are not good:
-     * EVAL_NOT_STARTED, EVAL_IN_PROGRESS, EVAL_WAIT, EVAL_STATUS_UNDEFINED.
+     * EVAL_NOT_STARTED, EVAL_IN_PROGRESS, EVAL_WAIT, EVAL_TIMEOUT,
+     * EVAL_CANCELLED, EVAL_STATUS_UNDEFINED.
     */
     bool goodForCacheFile() const;
 
@@ -322,6 +336,9 @@ private:
     /// Helpers for getF() and getH()
     Double computeHStandard( NOMAD::HNormType hNormType) const;
     Double computeFPhaseOne( NOMAD::HNormType hNormType) const;
+
+    /// Helper for setBBO: set the outputs and update the eval status.
+    void setBBOutput(BBOutput bbOutput, const BBOutputTypeList &bbOutputTypeList);
     
 
     
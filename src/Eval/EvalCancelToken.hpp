@@ -0,0 +1,124 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   EvalCancelToken.hpp
+ \brief  Cancellation and timeout control of an evaluation in progress
+ \author Christophe Tribes
+ \date   October 2026
+ \see    EvalCancelToken.cpp
+ */
+#ifndef __NOMAD_4_5_EVALCANCELTOKEN__
+#define __NOMAD_4_5_EVALCANCELTOKEN__
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "../Eval/Eval.hpp"
+#include "../Util/defines.hpp"
+
+#include "../nomad_nsbegin.hpp"
+
+/// Class to request the stop of an evaluation in progress.
+/**
+ A token is created by EvaluatorControl for each block of points sent to the
+ Evaluator. The evaluation must stop when the token is cancelled (by another
+ thread) or when the timeout given by parameter BB_EVAL_TIMEOUT is reached.
+
+ The token of the block currently evaluated by a thread is available through
+ Evaluator::evalStopRequested(). Blackbox executables are killed by the
+ Evaluator. A user eval_x() or eval_block() in library mode can call
+ Evaluator::evalStopRequested() periodically and return early.
+ */
+class DLL_EVAL_API EvalCancelToken
+{
+private:
+    std::atomic<bool>   _cancelRequested;
+    const size_t        _timeout;       ///< Timeout in seconds. INF_SIZE_T for no timeout.
+    const int           _mainThreadNum; ///< Main thread that requested the evaluation
+    const std::chrono::steady_clock::time_point _startTime;
+
+public:
+    /// Constructor
+    /**
+     \param timeout         Timeout in seconds, INF_SIZE_T for no timeout -- \b IN.
+     \param mainThreadNum   Main thread of the points evaluated -- \b IN.
+     */
+    explicit EvalCancelToken(const size_t timeout = INF_SIZE_T, const int mainThreadNum = 0)
+      : _cancelRequested(false),
+        _timeout(timeout),
+        _mainThreadNum(mainThreadNum),
+        _startTime(std::chrono::steady_clock::now())
+    {}
+
+    /// Request the stop of the evaluation. Thread-safe.
+    void cancel() { _cancelRequested = true; }
+
+    bool isCancelled() const { return _cancelRequested; }
+    bool isTimedOut() const;
+    int getMainThreadNum() const { return _mainThreadNum; }
+
+    /// Is the evaluation cancelled, or out of time?
+    bool stopRequested() const { return isCancelled() || isTimedOut(); }
+
+    /// The eval status to give to points that were not completed because of this token.
+    /**
+     \return EVAL_CANCELLED, EVAL_TIMEOUT, or EVAL_STATUS_UNDEFINED if no stop was requested.
+     */
+    EvalStatusType getStopEvalStatus() const;
+
+    /// Set the token for the evaluations done by the current thread. Use nullptr to reset.
+    static void setCurrent(const std::shared_ptr<EvalCancelToken>& token);
+
+    /// Get the token for the evaluations done by the current thread. May be nullptr.
+    static const std::shared_ptr<EvalCancelToken>& getCurrent();
+};
+
+typedef std::shared_ptr<EvalCancelToken> EvalCancelTokenPtr;
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_EVALCANCELTOKEN__
@@ -0,0 +1,291 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   EvalHedging.cpp
+ \brief  Duplicate execution of straggler evaluations
+ \author Christophe Tribes
+ \date   October 2026
+ \see    EvalHedging.hpp
+ */
+#include "../Eval/EvalHedging.hpp"
+
+#include <algorithm>
+
+
+NOMAD::HedgedBlock::HedgedBlock(const NOMAD::Block& block,
+                                const size_t nbPointsToEval,
+                                const NOMAD::EvalCancelTokenPtr& originalToken)
+  : _duplicateBlock(),
+    _nbPointsToEval(nbPointsToEval),
+    _mainThreadNum(originalToken->getMainThreadNum()),
+    _startTime(std::chrono::steady_clock::now()),
+    _originalToken(originalToken),
+    _duplicateToken(nullptr),
+    _winner(Winner::NONE),
+    _duplicateEvalOk(),
+    _duplicateCountEval()
+{
+    // Copy the points before the evaluation starts: the original points are
+    // updated by the evaluator during the race.
+    for (const auto& evalPoint : block)
+    {
+        _duplicateBlock.push_back(std::make_shared<NOMAD::EvalPoint>(*evalPoint));
+    }
+}
+
+
+double NOMAD::HedgedBlock::getElapsedTimePerPoint() const
+{
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - _startTime;
+    return elapsed.count() / static_cast<double>(std::max<size_t>(1, _nbPointsToEval));
+}
+
+
+bool NOMAD::HedgedBlock::startDuplicate(const NOMAD::EvalCancelTokenPtr& duplicateToken)
+{
+    bool started = false;
+    {
+        NOMAD_CRITICAL(hedgedBlock);
+        if (Winner::NONE == _winner && nullptr == _duplicateToken)
+        {
+            _duplicateToken = duplicateToken;
+            started = true;
+        }
+    }
+
+    return started;
+}
+
+
+bool NOMAD::HedgedBlock::originalDone()
+{
+    bool duplicateWon = false;
+    {
+        NOMAD_CRITICAL(hedgedBlock);
+        if (Winner::NONE == _winner)
+        {
+            _winner = Winner::ORIGINAL;
+            if (nullptr != _duplicateToken)
+            {
+                _duplicateToken->cancel();
+            }
+        }
+        duplicateWon = (Winner::DUPLICATE == _winner);
+    }
+
+    return duplicateWon;
+}
+
+
+bool NOMAD::HedgedBlock::duplicateDone(const std::vector<bool>& evalOk, const std::vector<bool>& countEval)
+{
+    bool duplicateWon = false;
+    {
+        NOMAD_CRITICAL(hedgedBlock);
+        if (Winner::NONE == _winner)
+        {
+            _winner = Winner::DUPLICATE;
+            _duplicateEvalOk = evalOk;
+            _duplicateCountEval = countEval;
+            _originalToken->cancel();
+            duplicateWon = true;
+        }
+    }
+
+    return duplicateWon;
+}
+
+
+void NOMAD::HedgedBlock::adoptDuplicate(NOMAD::Block& block,
+                                        std::vector<bool>& evalOk,
+                                        std::vector<bool>& countEval,
+                                        const NOMAD::EvalType evalType) const
+{
+    for (size_t index = 0; index < block.size() && index < _duplicateBlock.size(); index++)
+    {
+        const NOMAD::Eval* eval = _duplicateBlock[index]->getEval(evalType);
+        const auto evalStatus = _duplicateBlock[index]->getEvalStatus(evalType);
+        if (   nullptr == eval
+            || NOMAD::EvalStatusType::EVAL_WAIT == evalStatus
+            || NOMAD::EvalStatusType::EVAL_USER_REJECTED == evalStatus)
+        {
+            // Not evaluated
+            continue;
+        }
+        block[index]->setEval(*eval, evalType);
+        evalOk[index] = _duplicateEvalOk[index];
+        countEval[index] = _duplicateCountEval[index];
+    }
+}
+
+
+NOMAD::EvalHedging::EvalHedging()
+  : _percentile(NOMAD::INF_SIZE_T),
+    _latencies(),
+    _next(0),
+    _runningBlocks(),
+    _nbDuplicates(0),
+    _nbDuplicateWins(0)
+#ifdef _OPENMP
+    ,_hedgingLock("hedgingLock")
+#endif // _OPENMP
+{
+}
+
+
+NOMAD::EvalHedging::~EvalHedging()
+{
+}
+
+
+void NOMAD::EvalHedging::addLatency(const double timePerPoint)
+{
+#ifdef _OPENMP
+    _hedgingLock.set();
+#endif // _OPENMP
+    if (_latencies.size() < MAX_NB_LATENCIES)
+    {
+        _latencies.push_back(timePerPoint);
+    }
+    else
+    {
+        _latencies[_next] = timePerPoint;
+        _next = (_next + 1) % MAX_NB_LATENCIES;
+    }
+#ifdef _OPENMP
+    _hedgingLock.unset();
+#endif // _OPENMP
+}
+
+
+void NOMAD::EvalHedging::addRunningBlock(const NOMAD::HedgedBlockPtr& hedgedBlock)
+{
+#ifdef _OPENMP
+    _hedgingLock.set();
+#endif // _OPENMP
+    _runningBlocks.push_back(hedgedBlock);
+#ifdef _OPENMP
+    _hedgingLock.unset();
+#endif // _OPENMP
+}
+
+
+void NOMAD::EvalHedging::removeRunningBlock(const NOMAD::HedgedBlockPtr& hedgedBlock)
+{
+#ifdef _OPENMP
+    _hedgingLock.set();
+#endif // _OPENMP
+    auto it = std::find(_runningBlocks.begin(), _runningBlocks.end(), hedgedBlock);
+    if (it != _runningBlocks.end())
+    {
+        _runningBlocks.erase(it);
+    }
+#ifdef _OPENMP
+    _hedgingLock.unset();
+#endif // _OPENMP
+}
+
+
+double NOMAD::EvalHedging::computeThreshold() const
+{
+    if (_latencies.size() < MIN_NB_LATENCIES)
+    {
+        return NOMAD::INF;
+    }
+
+    std::vector<double> latencies(_latencies);
+    const size_t k = std::min(latencies.size() - 1, _percentile * latencies.size() / 100);
+    std::nth_element(latencies.begin(), latencies.begin() + k, latencies.end());
+
+    return latencies[k];
+}
+
+
+NOMAD::HedgedBlockPtr NOMAD::EvalHedging::startDuplicateOfStraggler(const int mainThreadNum,
+                                                                    const NOMAD::EvalCancelTokenPtr& duplicateToken)
+{
+    NOMAD::HedgedBlockPtr straggler = nullptr;
+
+#ifdef _OPENMP
+    _hedgingLock.set();
+#endif // _OPENMP
+    const double threshold = computeThreshold();
+    if (threshold < NOMAD::INF)
+    {
+        // The slowest straggler first.
+        double maxElapsedTimePerPoint = threshold;
+        for (const auto& hedgedBlock : _runningBlocks)
+        {
+            if (hedgedBlock->getMainThreadNum() != mainThreadNum || hedgedBlock->isDuplicated())
+            {
+                continue;
+            }
+            const double elapsedTimePerPoint = hedgedBlock->getElapsedTimePerPoint();
+            if (elapsedTimePerPoint > maxElapsedTimePerPoint)
+            {
+                maxElapsedTimePerPoint = elapsedTimePerPoint;
+                straggler = hedgedBlock;
+            }
+        }
+        if (nullptr != straggler)
+        {
+            if (straggler->startDuplicate(duplicateToken))
+            {
+                _nbDuplicates++;
+            }
+            else
+            {
+                straggler = nullptr;
+            }
+        }
+    }
+#ifdef _OPENMP
+    _hedgingLock.unset();
+#endif // _OPENMP
+
+    return straggler;
+}
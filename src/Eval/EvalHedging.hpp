@@ -0,0 +1,215 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   EvalHedging.hpp
+ \brief  Duplicate execution of straggler evaluations
+ \author Christophe Tribes
+ \date   October 2026
+ \see    EvalHedging.cpp
+ */
+#ifndef __NOMAD_4_5_EVALHEDGING__
+#define __NOMAD_4_5_EVALHEDGING__
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "../Eval/EvalCancelToken.hpp"
+#include "../Eval/EvalPoint.hpp"
+#include "../Util/InstrumentedLock.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include "../nomad_nsbegin.hpp"
+
+/// Block of points being evaluated, that may be duplicated on another thread.
+/**
+ The original evaluation and its duplicate race. The first to complete wins
+ and cancels the other one. Only the thread of the original evaluation
+ updates the cache and the counters: when the duplicate wins, the original
+ adopts its results (see adoptDuplicate()). A point is thus counted once.
+ */
+class DLL_EVAL_API HedgedBlock
+{
+private:
+    /// Outcome of the race
+    enum class Winner
+    {
+        NONE,
+        ORIGINAL,
+        DUPLICATE
+    };
+
+    Block               _duplicateBlock;    ///< Copy of the points, for the duplicate evaluation
+    const size_t        _nbPointsToEval;
+    const int           _mainThreadNum;
+    const std::chrono::steady_clock::time_point _startTime;
+    EvalCancelTokenPtr  _originalToken;
+    EvalCancelTokenPtr  _duplicateToken;    ///< nullptr until a duplicate is started
+    Winner              _winner;
+    std::vector<bool>   _duplicateEvalOk;
+    std::vector<bool>   _duplicateCountEval;
+
+public:
+    /// Constructor
+    /**
+     \param block           The points to evaluate. They are copied -- \b IN.
+     \param nbPointsToEval  Number of points of the block that are evaluated -- \b IN.
+     \param originalToken   Token of the original evaluation -- \b IN.
+     */
+    HedgedBlock(const Block& block,
+                const size_t nbPointsToEval,
+                const EvalCancelTokenPtr& originalToken);
+
+    int getMainThreadNum() const { return _mainThreadNum; }
+
+    /// Elapsed time per evaluated point since the start of the original evaluation, in seconds.
+    double getElapsedTimePerPoint() const;
+
+    bool isDuplicated() const { return (nullptr != _duplicateToken); }
+
+    /// Start the duplicate.
+    /**
+     \return \c false if the original evaluation is already complete.
+     */
+    bool startDuplicate(const EvalCancelTokenPtr& duplicateToken);
+
+    /// The points for the duplicate evaluation.
+    Block& getDuplicateBlock() { return _duplicateBlock; }
+
+    /// The original evaluation is complete.
+    /**
+     \return \c true if the duplicate won. Its results must be adopted.
+     Otherwise, the duplicate is cancelled.
+     */
+    bool originalDone();
+
+    /// The duplicate evaluation is complete.
+    /**
+     \return \c true if the duplicate won. The original evaluation is cancelled.
+     */
+    bool duplicateDone(const std::vector<bool>& evalOk, const std::vector<bool>& countEval);
+
+    /// Copy the results of the duplicate in the original points.
+    void adoptDuplicate(Block& block,
+                        std::vector<bool>& evalOk,
+                        std::vector<bool>& countEval,
+                        const EvalType evalType) const;
+};
+
+typedef std::shared_ptr<HedgedBlock> HedgedBlockPtr;
+
+
+/// Class for the hedging policy of blackbox evaluations (BB_HEDGING_PERCENTILE).
+/**
+ The evaluation times per point of the last blocks are recorded. A block is
+ a straggler when it runs longer than the given percentile of these times.
+ A thread with no more blocks to evaluate may launch a duplicate of a
+ straggler (see HedgedBlock).
+
+ Thread-safe.
+ */
+class DLL_EVAL_API EvalHedging
+{
+private:
+    static constexpr size_t MAX_NB_LATENCIES = 200;    ///< Number of times kept
+    static constexpr size_t MIN_NB_LATENCIES = 10;     ///< Minimum number of times to detect stragglers
+
+    size_t                      _percentile;    ///< INF_SIZE_T for no hedging
+    std::vector<double>         _latencies;     ///< Evaluation times per point, in seconds
+    size_t                      _next;          ///< Next time to replace, when _latencies is full
+    std::vector<HedgedBlockPtr> _runningBlocks;
+
+    std::atomic<size_t>         _nbDuplicates;      ///< Number of duplicates started
+    std::atomic<size_t>         _nbDuplicateWins;   ///< Number of duplicates completed first
+
+#ifdef _OPENMP
+    mutable InstrumentedLock _hedgingLock;
+#endif // _OPENMP
+
+public:
+    /// Constructor. No hedging.
+    EvalHedging();
+
+    /// Destructor
+    virtual ~EvalHedging();
+
+    EvalHedging(const EvalHedging&) = delete;
+    EvalHedging& operator=(const EvalHedging&) = delete;
+
+    void setPercentile(const size_t percentile) { _percentile = percentile; }
+    bool isEnabled() const { return (_percentile < 100); }
+
+    /// Record the evaluation time per point of a block that was not stopped.
+    void addLatency(const double timePerPoint);
+
+    void addRunningBlock(const HedgedBlockPtr& hedgedBlock);
+    void removeRunningBlock(const HedgedBlockPtr& hedgedBlock);
+
+    /// Find a straggler of a main thread that is not duplicated yet, and start its duplicate.
+    /**
+     \param mainThreadNum   The main thread -- \b IN.
+     \param duplicateToken  The token for the duplicate evaluation -- \b IN.
+     \return                The straggler, or \c nullptr if there is none.
+     */
+    HedgedBlockPtr startDuplicateOfStraggler(const int mainThreadNum,
+                                             const EvalCancelTokenPtr& duplicateToken);
+
+    void incNbDuplicateWins() { _nbDuplicateWins++; }
+    size_t getNbDuplicates() const { return _nbDuplicates; }
+    size_t getNbDuplicateWins() const { return _nbDuplicateWins; }
+
+private:
+    /// Evaluation time per point above which a block is a straggler. INF if unknown.
+    double computeThreshold() const;
+};
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_EVALHEDGING__
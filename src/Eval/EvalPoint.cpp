@@ -56,6 +56,7 @@
 #include "../Eval/EvalPoint.hpp"
 #include "../Output/OutputQueue.hpp"
 #include "../Math/MatrixUtils.hpp"
+#include "../Util/InstrumentedLock.hpp"
 
 int NOMAD::EvalPoint::_currentTag = -1;
 
@@ -444,6 +445,32 @@ void NOMAD::EvalPoint::setBBO(const std::string &bbo,
 }
 
 
+void NOMAD::EvalPoint::setBBO(const NOMAD::ArrayOfDouble &bbo,
+                              const NOMAD::BBOutputTypeList &bbOutputTypeList,
+                              NOMAD::EvalType evalType,
+                              const bool evalOk)
+{
+    if (NOMAD::EvalType::LAST == evalType)
+    {
+        // Select the single eval in progress
+        evalType = getSingleEvalType(NOMAD::EvalStatusType::EVAL_IN_PROGRESS);
+    }
+    NOMAD::Eval * eval = getEval(evalType);
+
+    if (nullptr == eval)
+    {
+        _eval[(size_t) evalType] = std::make_unique<NOMAD::Eval>(NOMAD::Eval());
+        eval = getEval(evalType);
+    }
+
+    if (nullptr == eval)
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "EvalPoint::setBBO: Could not create new Eval");
+    }
+    eval->setBBO(bbo, bbOutputTypeList, evalOk);
+}
+
+
 void NOMAD::EvalPoint::setBBO(const std::string &bbo,
                               const std::string &sBBOutputTypes,
                               NOMAD::EvalType evalType,
@@ -627,10 +654,10 @@ void NOMAD::EvalPoint::setRevealedConstraint(const NOMAD::Double &constraintValu
 void NOMAD::EvalPoint::updateTag() const
 {
     if (-1 == _tag)
+    {
 #ifdef OPENMP
-#pragma omp critical
+        NOMAD_CRITICAL(unnamed);
 #endif
-    {
         _currentTag++;
         _tag = _currentTag;
     }
@@ -207,6 +207,19 @@ public:
                 EvalType evalType = EvalType::LAST,
                 const bool evalOk = true);
 
+    /// Set the blackbox output for the Eval of this EvalType from values.
+    /**
+     Same as setBBO with a \c string, without formatting and parsing the outputs.
+     \param bbo                 The values of the outputs -- \b IN.
+     \param bbOutputTypeList    The list of blackbox output types -- \b IN.
+     \param evalType            Blackbox or model evaluation  -- \b IN.
+     \param evalOk              Flag for evaluation status  -- \b IN.
+    */
+    void setBBO(const ArrayOfDouble &bbo,
+                const BBOutputTypeList& bbOutputTypeList,
+                EvalType evalType = EvalType::LAST,
+                const bool evalOk = true);
+
     /// Set the true or model blackbox output from a \c string.
     /**
      \param bbo             The string containing the raw result of the blackbox evaluation -- \b IN.
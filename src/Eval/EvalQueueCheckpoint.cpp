@@ -0,0 +1,423 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   EvalQueueCheckpoint.cpp
+ \brief  Checkpoint of the evaluations that are not completed
+ \author Christophe Tribes
+ \date   October 2026
+ \see    EvalQueueCheckpoint.hpp
+ */
+#include "../Eval/EvalQueueCheckpoint.hpp"
+#include "../Util/InstrumentedLock.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <set>
+
+
+const char NOMAD::EvalQueueCheckpoint::MAGIC[8] = {'N','O','M','A','D','E','Q','C'};
+const uint32_t NOMAD::EvalQueueCheckpoint::VERSION = 1;
+
+
+// Helpers to write and read native binary values.
+namespace
+{
+    template<typename T>
+    void writeValue(std::ofstream& out, const T& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool readValue(std::ifstream& in, T& value)
+    {
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return in.good();
+    }
+
+    void writePointRecord(std::ofstream& out, const NOMAD::EvalQueueCheckpoint::PointRecord& record)
+    {
+        writeValue<int32_t>(out, record._tag);
+        writeValue<int32_t>(out, record._mainThreadNum);
+        writeValue<uint8_t>(out, record._inProgress ? 1 : 0);
+        writeValue<uint64_t>(out, record._x.size());
+        for (size_t i = 0; i < record._x.size(); i++)
+        {
+            // An undefined coordinate is written as NaN.
+            const double xi = record._x[i].isDefined() ? record._x[i].todouble()
+                                                       : std::numeric_limits<double>::quiet_NaN();
+            writeValue<double>(out, xi);
+        }
+    }
+
+    bool readPointRecord(std::ifstream& in, NOMAD::EvalQueueCheckpoint::PointRecord& record)
+    {
+        int32_t tag = 0, mainThreadNum = 0;
+        uint8_t inProgress = 0;
+        uint64_t n = 0;
+        if (!readValue(in, tag) || !readValue(in, mainThreadNum)
+            || !readValue(in, inProgress) || !readValue(in, n))
+        {
+            return false;
+        }
+        record._tag = tag;
+        record._mainThreadNum = mainThreadNum;
+        record._inProgress = (0 != inProgress);
+        record._x = NOMAD::Point(static_cast<size_t>(n));
+        for (size_t i = 0; i < n; i++)
+        {
+            double xi = 0.0;
+            if (!readValue(in, xi))
+            {
+                return false;
+            }
+            if (!std::isnan(xi))
+            {
+                record._x[i] = xi;
+            }
+        }
+        return true;
+    }
+}
+
+
+NOMAD::EvalQueueCheckpoint::EvalQueueCheckpoint()
+  : _fileName(),
+    _interval(0),
+    _lastWrite(std::chrono::steady_clock::now()),
+    _writing(false),
+    _pendingPoints(),
+    _restoredPoints(),
+    _nbWrites(0)
+{
+}
+
+
+void NOMAD::EvalQueueCheckpoint::init(const std::string& fileName, const size_t interval)
+{
+    _fileName = fileName;
+    _interval = interval;
+    _lastWrite = std::chrono::steady_clock::now();
+}
+
+
+void NOMAD::EvalQueueCheckpoint::addPendingPoints(const NOMAD::BlockForEval& block)
+{
+    {
+        NOMAD_CRITICAL(evalQueueCheckpoint);
+        for (const auto& evalPoint : block)
+        {
+            _pendingPoints[evalPoint->getTag()] = {evalPoint->getTag(),
+                                                   evalPoint->getThreadAlgo(),
+                                                   false,
+                                                   *evalPoint->getX()};
+        }
+    }
+}
+
+
+void NOMAD::EvalQueueCheckpoint::setInProgress(const NOMAD::BlockForEval& block)
+{
+    {
+        NOMAD_CRITICAL(evalQueueCheckpoint);
+        for (const auto& evalPoint : block)
+        {
+            auto it = _pendingPoints.find(evalPoint->getTag());
+            if (it != _pendingPoints.end())
+            {
+                it->second._inProgress = true;
+            }
+        }
+    }
+}
+
+
+void NOMAD::EvalQueueCheckpoint::removePendingPoints(const NOMAD::BlockForEval& block)
+{
+    {
+        NOMAD_CRITICAL(evalQueueCheckpoint);
+        for (const auto& evalPoint : block)
+        {
+            _pendingPoints.erase(evalPoint->getTag());
+        }
+    }
+}
+
+
+bool NOMAD::EvalQueueCheckpoint::startWrite()
+{
+    if (!isEnabled())
+    {
+        return false;
+    }
+
+    // Only one thread writes. The others do not wait.
+    bool expected = false;
+    if (!_writing.compare_exchange_strong(expected, true))
+    {
+        return false;
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - _lastWrite;
+    if (elapsed.count() < static_cast<double>(_interval))
+    {
+        _writing = false;
+        return false;
+    }
+
+    return true;
+}
+
+
+void NOMAD::EvalQueueCheckpoint::endWrite()
+{
+    _lastWrite = std::chrono::steady_clock::now();
+    _writing = false;
+}
+
+
+bool NOMAD::EvalQueueCheckpoint::write(const std::vector<PointRecord>& queuedPoints,
+                                       const Counters& counters)
+{
+    // Gather all the points that are not completed. A point that is
+    // put back in the queue may still be in the pending points.
+    std::vector<PointRecord> points;
+    std::set<int> tags;
+    for (const auto& record : queuedPoints)
+    {
+        if (tags.insert(record._tag).second)
+        {
+            points.push_back(record);
+        }
+    }
+    {
+        NOMAD_CRITICAL(evalQueueCheckpoint);
+        for (const auto& tagRecord : _pendingPoints)
+        {
+            if (tags.insert(tagRecord.first).second)
+            {
+                points.push_back(tagRecord.second);
+            }
+        }
+        // Restored points that are not submitted yet keep their old tags.
+        points.insert(points.end(), _restoredPoints.begin(), _restoredPoints.end());
+    }
+
+    // Number of points of each main thread.
+    std::map<int, MainThreadRecord> mainThreads;
+    for (const auto& record : points)
+    {
+        auto& mainThread = mainThreads[record._mainThreadNum];
+        mainThread._mainThreadNum = record._mainThreadNum;
+        (record._inProgress) ? mainThread._nbPointsInProgress++ : mainThread._nbPointsInQueue++;
+    }
+
+    const std::string tmpFileName = _fileName + ".tmp";
+    std::ofstream out(tmpFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (out.fail())
+    {
+        std::cerr << "Warning: Cannot write evaluation queue checkpoint file " << tmpFileName << std::endl;
+        return false;
+    }
+
+    out.write(MAGIC, sizeof(MAGIC));
+    writeValue<uint32_t>(out, VERSION);
+
+    writeValue<uint64_t>(out, counters._bbEval);
+    writeValue<uint64_t>(out, counters._bbEvalNotOk);
+    writeValue<uint64_t>(out, counters._feasBBEval);
+    writeValue<uint64_t>(out, counters._infBBEval);
+    writeValue<uint64_t>(out, counters._surrogateEval);
+    writeValue<uint64_t>(out, counters._totalModelEval);
+    writeValue<uint64_t>(out, counters._blockEval);
+    writeValue<uint64_t>(out, counters._nbEvalSentToEvaluator);
+
+    writeValue<uint64_t>(out, mainThreads.size());
+    for (const auto& threadRecord : mainThreads)
+    {
+        writeValue<int32_t>(out, threadRecord.second._mainThreadNum);
+        writeValue<uint64_t>(out, threadRecord.second._nbPointsInQueue);
+        writeValue<uint64_t>(out, threadRecord.second._nbPointsInProgress);
+    }
+
+    writeValue<uint64_t>(out, points.size());
+    for (const auto& record : points)
+    {
+        writePointRecord(out, record);
+    }
+    out.close();
+    if (out.fail())
+    {
+        std::cerr << "Warning: Cannot write evaluation queue checkpoint file " << tmpFileName << std::endl;
+        return false;
+    }
+
+    if (0 != std::rename(tmpFileName.c_str(), _fileName.c_str()))
+    {
+        std::cerr << "Warning: Cannot rename evaluation queue checkpoint file " << tmpFileName << " to " << _fileName << std::endl;
+        return false;
+    }
+    _nbWrites++;
+
+    return true;
+}
+
+
+bool NOMAD::EvalQueueCheckpoint::read(Counters& counters, std::vector<MainThreadRecord>& mainThreads)
+{
+    if (!isEnabled())
+    {
+        return false;
+    }
+
+    std::ifstream in(_fileName, std::ios::in | std::ios::binary);
+    if (in.fail())
+    {
+        // No checkpoint: the previous run completed, or this is the first run.
+        return false;
+    }
+
+    char magic[sizeof(MAGIC)];
+    uint32_t version = 0;
+    in.read(magic, sizeof(MAGIC));
+    if (!in.good() || 0 != std::memcmp(magic, MAGIC, sizeof(MAGIC))
+        || !readValue(in, version) || VERSION != version)
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "File " + _fileName + " is not an evaluation queue checkpoint file, or was written by another version of NOMAD");
+    }
+
+    uint64_t values[8];
+    for (auto& value : values)
+    {
+        if (!readValue(in, value))
+        {
+            throw NOMAD::Exception(__FILE__, __LINE__, "Evaluation queue checkpoint file " + _fileName + " is truncated");
+        }
+    }
+    counters._bbEval                = values[0];
+    counters._bbEvalNotOk           = values[1];
+    counters._feasBBEval            = values[2];
+    counters._infBBEval             = values[3];
+    counters._surrogateEval         = values[4];
+    counters._totalModelEval        = values[5];
+    counters._blockEval             = values[6];
+    counters._nbEvalSentToEvaluator = values[7];
+
+    uint64_t nbMainThreads = 0;
+    bool readOk = readValue(in, nbMainThreads);
+    mainThreads.clear();
+    for (uint64_t i = 0; readOk && i < nbMainThreads; i++)
+    {
+        int32_t mainThreadNum = 0;
+        uint64_t nbPointsInQueue = 0, nbPointsInProgress = 0;
+        readOk = readValue(in, mainThreadNum) && readValue(in, nbPointsInQueue) && readValue(in, nbPointsInProgress);
+        mainThreads.push_back({mainThreadNum, static_cast<size_t>(nbPointsInQueue), static_cast<size_t>(nbPointsInProgress)});
+    }
+
+    uint64_t nbPoints = 0;
+    readOk = readOk && readValue(in, nbPoints);
+    std::vector<PointRecord> points;
+    for (uint64_t i = 0; readOk && i < nbPoints; i++)
+    {
+        PointRecord record;
+        readOk = readPointRecord(in, record);
+        points.push_back(record);
+    }
+    if (!readOk)
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "Evaluation queue checkpoint file " + _fileName + " is truncated");
+    }
+
+    {
+        NOMAD_CRITICAL(evalQueueCheckpoint);
+        _restoredPoints = std::move(points);
+    }
+
+    return true;
+}
+
+
+std::vector<NOMAD::Point> NOMAD::EvalQueueCheckpoint::popRestoredPoints(const NOMAD::Point& fixedVariable)
+{
+    std::vector<NOMAD::Point> subPoints;
+    {
+        NOMAD_CRITICAL(evalQueueCheckpoint);
+        auto it = _restoredPoints.begin();
+        while (it != _restoredPoints.end())
+        {
+            if (0 == fixedVariable.size())
+            {
+                subPoints.push_back(it->_x);
+                it = _restoredPoints.erase(it);
+            }
+            else if (it->_x.size() == fixedVariable.size() && it->_x.hasFixed(fixedVariable))
+            {
+                subPoints.push_back(it->_x.makeSubSpacePointFromFixed(fixedVariable));
+                it = _restoredPoints.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    return subPoints;
+}
+
+
+void NOMAD::EvalQueueCheckpoint::remove()
+{
+    if (isEnabled())
+    {
+        std::remove(_fileName.c_str());
+    }
+}
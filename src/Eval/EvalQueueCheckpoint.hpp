@@ -0,0 +1,201 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   EvalQueueCheckpoint.hpp
+ \brief  Checkpoint of the evaluations that are not completed
+ \author Christophe Tribes
+ \date   October 2026
+ \see    EvalQueueCheckpoint.cpp
+ */
+#ifndef __NOMAD_4_5_EVALQUEUECHECKPOINT__
+#define __NOMAD_4_5_EVALQUEUECHECKPOINT__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../Eval/EvalQueuePoint.hpp"
+
+#include "../nomad_nsbegin.hpp"
+
+/// Checkpoint of the evaluations that are not completed (EVAL_QUEUE_CHECKPOINT_FILE).
+/**
+ The points waiting in the evaluation queue, the points being evaluated, the
+ evaluation counters and the number of points of each main thread are written
+ periodically in a binary file. When a run stops before its end, the next run
+ with the same file reads it back: the counters are restored and the points
+ that were not completed are submitted again first, instead of being lost.
+
+ The file is written in a temporary file which is then renamed: a crash while
+ writing keeps the previous checkpoint. The format is the native binary
+ representation: the file is not portable between platforms.
+
+ Thread-safe.
+ */
+class DLL_EVAL_API EvalQueueCheckpoint
+{
+public:
+    /// A point of the checkpoint
+    struct PointRecord
+    {
+        int     _tag;           ///< Tag of the point in the run that wrote the checkpoint
+        int     _mainThreadNum; ///< Main thread that generated the point
+        bool    _inProgress;    ///< The evaluation of the point was started
+        Point   _x;             ///< Coordinates, in full space
+    };
+
+    /// Counters of EvaluatorControl
+    struct Counters
+    {
+        size_t _bbEval = 0;
+        size_t _bbEvalNotOk = 0;
+        size_t _feasBBEval = 0;
+        size_t _infBBEval = 0;
+        size_t _surrogateEval = 0;
+        size_t _totalModelEval = 0;
+        size_t _blockEval = 0;
+        size_t _nbEvalSentToEvaluator = 0;
+    };
+
+    /// Number of points of a main thread in the checkpoint
+    struct MainThreadRecord
+    {
+        int     _mainThreadNum;
+        size_t  _nbPointsInQueue;
+        size_t  _nbPointsInProgress;
+    };
+
+private:
+    static const char   MAGIC[8];
+    static const uint32_t VERSION;
+
+    std::string         _fileName;  ///< Empty if there is no checkpoint
+    size_t              _interval;  ///< Minimum time between two checkpoints, in seconds
+    std::chrono::steady_clock::time_point _lastWrite;   ///< Access by the thread that holds _writing
+    std::atomic<bool>   _writing;   ///< A thread is writing the checkpoint, or checking if it is time to write
+
+    /// Points taken from the queue for the current runs, by tag. Access in critical section evalQueueCheckpoint.
+    std::map<int, PointRecord> _pendingPoints;
+
+    /// Points read from the checkpoint that are not submitted yet. Access in critical section evalQueueCheckpoint.
+    std::vector<PointRecord> _restoredPoints;
+
+    size_t              _nbWrites;
+
+public:
+    /// Constructor. No checkpoint.
+    EvalQueueCheckpoint();
+
+    EvalQueueCheckpoint(const EvalQueueCheckpoint&) = delete;
+    EvalQueueCheckpoint& operator=(const EvalQueueCheckpoint&) = delete;
+
+    /// Set the checkpoint file and the minimum time between two checkpoints.
+    /**
+     \param fileName    The file name. Empty for no checkpoint -- \b IN.
+     \param interval    Minimum time between two checkpoints, in seconds -- \b IN.
+     */
+    void init(const std::string& fileName, const size_t interval);
+
+    bool isEnabled() const { return !_fileName.empty(); }
+    const std::string& getFileName() const { return _fileName; }
+    size_t getNbWrites() const { return _nbWrites; }
+
+    /// The points of a block are taken from the queue, to be evaluated by a run.
+    void addPendingPoints(const BlockForEval& block);
+
+    /// The evaluation of the points of a block is started.
+    void setInProgress(const BlockForEval& block);
+
+    /// The points of a block are evaluated, or back in the queue.
+    void removePendingPoints(const BlockForEval& block);
+
+    /// Is it time for a new checkpoint?
+    /**
+     When \c true is returned, the caller must write the checkpoint and call
+     endWrite(). Only one thread at a time gets \c true.
+     */
+    bool startWrite();
+
+    /// Write the checkpoint file.
+    /**
+     The pending points and the restored points that are not submitted yet
+     are added to the queued points. A point is written once.
+     \param queuedPoints    The points waiting in the evaluation queue -- \b IN.
+     \param counters        The counters of EvaluatorControl -- \b IN.
+     \return                \c true if the file was written.
+     */
+    bool write(const std::vector<PointRecord>& queuedPoints,
+               const Counters& counters);
+
+    /// End of the write started by startWrite().
+    void endWrite();
+
+    /// Read the checkpoint file, if it exists.
+    /**
+     The points read are kept until they are taken by popRestoredPoints().
+     \param counters        The counters of the run that wrote the checkpoint -- \b OUT.
+     \param mainThreads     The number of points of each main thread -- \b OUT.
+     \return                \c true if a checkpoint was read.
+     */
+    bool read(Counters& counters, std::vector<MainThreadRecord>& mainThreads);
+
+    /// Take the restored points that are in the sub space of the given fixed variables.
+    /**
+     \param fixedVariable   The fixed variables of the sub space -- \b IN.
+     \return                The points, in the sub space.
+     */
+    std::vector<Point> popRestoredPoints(const Point& fixedVariable);
+
+    /// Remove the checkpoint file. To be called at the end of a run that completes.
+    void remove();
+};
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_EVALQUEUECHECKPOINT__
@@ -57,6 +57,7 @@
 
 #include "../Eval/EvalPoint.hpp"
 
+#include <chrono>
 #include <functional>   // For std::function
 
 #include "../nomad_nsbegin.hpp"
@@ -75,6 +76,7 @@ private:
     bool            _relativeSuccess;   ///< Did better than the previous evaluation
 
     size_t          _k; ///< The number of the iteration that generated this point. For sorting purposes.
+    std::chrono::steady_clock::time_point _queueTime;   ///< When the point was put in the evaluation queue
 
 public:
 
@@ -88,7 +90,8 @@ public:
         _evalType(evalType),
         _success(SuccessType::UNDEFINED),
         _relativeSuccess(false),
-        _k(0)
+        _k(0),
+        _queueTime(std::chrono::steady_clock::now())
     {}
 
     const EvalType& getEvalType() const { return _evalType; }
@@ -101,6 +104,8 @@ public:
 
     void setK(const size_t k) { _k = k; };
     size_t getK() const { return _k; }
+
+    const std::chrono::steady_clock::time_point& getQueueTime() const { return _queueTime; }
     
     /// Comparison operator \c ==.
     /**
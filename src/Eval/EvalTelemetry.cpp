@@ -0,0 +1,362 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   EvalTelemetry.cpp
+ \brief  Histograms of the evaluation latencies and of the evaluation queue depth
+ \author Christophe Tribes
+ \date   October 2026
+ \see    EvalTelemetry.hpp
+ */
+#include "../Eval/EvalTelemetry.hpp"
+#include "../Util/InstrumentedLock.hpp"
+#include "../Util/utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+// Values below 2^SUB_BITS have their own bucket. Above, each power of 2 has
+// 2^(SUB_BITS-1) buckets.
+static const size_t SUB_BITS = 5;
+static const size_t HALF_SUB_BUCKETS = size_t(1) << (SUB_BITS - 1);
+static const size_t NB_BUCKETS = 64 * HALF_SUB_BUCKETS;
+
+
+// Time in seconds, from microseconds.
+static std::string secondsToString(const uint64_t us)
+{
+    std::ostringstream oss;
+    oss << static_cast<double>(us) / 1e6;
+    return oss.str();
+}
+
+
+/*------------------*/
+/*   LogHistogram   */
+/*------------------*/
+NOMAD::LogHistogram::LogHistogram()
+  : _counts(NB_BUCKETS, 0),
+    _count(0),
+    _min(UINT64_MAX),
+    _max(0),
+    _sum(0.0)
+{
+}
+
+
+size_t NOMAD::LogHistogram::bucketIndex(const uint64_t value)
+{
+    if (value < (uint64_t(1) << SUB_BITS))
+    {
+        return static_cast<size_t>(value);
+    }
+    // Position of the most significant bit
+    size_t msb = 0;
+    for (uint64_t v = value; v > 1; v >>= 1)
+    {
+        msb++;
+    }
+    // The SUB_BITS most significant bits of value select the bucket.
+    const size_t shift = msb - (SUB_BITS - 1);
+    return shift * HALF_SUB_BUCKETS + static_cast<size_t>(value >> shift);
+}
+
+
+uint64_t NOMAD::LogHistogram::bucketLowest(const size_t index)
+{
+    if (index < (size_t(1) << SUB_BITS))
+    {
+        return index;
+    }
+    const size_t shift = index / HALF_SUB_BUCKETS - 1;
+    const uint64_t mantissa = index % HALF_SUB_BUCKETS + HALF_SUB_BUCKETS;
+    return mantissa << shift;
+}
+
+
+void NOMAD::LogHistogram::add(const uint64_t value, const uint64_t count)
+{
+    if (0 == count)
+    {
+        return;
+    }
+    _counts[bucketIndex(value)] += count;
+    _count += count;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+    _sum += static_cast<double>(value) * static_cast<double>(count);
+}
+
+
+uint64_t NOMAD::LogHistogram::getPercentile(const double p) const
+{
+    if (0 == _count)
+    {
+        return 0;
+    }
+    const double rank = std::ceil(std::min(100.0, std::max(0.0, p)) / 100.0 * static_cast<double>(_count));
+    const uint64_t target = std::max(uint64_t(1), static_cast<uint64_t>(rank));
+    uint64_t cumul = 0;
+    for (size_t index = 0; index < _counts.size(); index++)
+    {
+        cumul += _counts[index];
+        if (cumul >= target)
+        {
+            const uint64_t lowest = bucketLowest(index);
+            const uint64_t width = bucketLowest(index + 1) - lowest;
+            // Middle of the bucket, within the values seen.
+            return std::min(_max, std::max(getMin(), lowest + width / 2));
+        }
+    }
+    return _max;
+}
+
+
+/*-------------------*/
+/*   EvalTelemetry   */
+/*-------------------*/
+NOMAD::EvalTelemetry::EvalTelemetry()
+  : _startTime(std::chrono::steady_clock::now()),
+    _stats(),
+    _busyTime(),
+    _metricsFile(),
+    _interval(0),
+    _lastWrite(std::chrono::steady_clock::now()),
+    _writing(false)
+{
+}
+
+
+void NOMAD::EvalTelemetry::init(const std::string& metricsFile, const size_t interval)
+{
+    {
+        NOMAD_CRITICAL(evalTelemetry);
+        _stats.clear();
+        _busyTime.clear();
+    }
+    _startTime = std::chrono::steady_clock::now();
+    _lastWrite = _startTime;
+    _metricsFile = metricsFile;
+    _interval = interval;
+
+    if (!_metricsFile.empty())
+    {
+        // Start with an empty file. The lines are appended by writeMetrics().
+        std::ofstream out(_metricsFile, std::ios::trunc);
+    }
+}
+
+
+void NOMAD::EvalTelemetry::addQueueDepth(const NOMAD::EvalType evalType, const int mainThreadNum, const size_t queueDepth)
+{
+    {
+        NOMAD_CRITICAL(evalTelemetry);
+        Stats& stats = _stats[std::make_pair(evalType, mainThreadNum)];
+        stats._queueDepth.add(queueDepth);
+        stats._lastQueueDepth = queueDepth;
+    }
+}
+
+
+void NOMAD::EvalTelemetry::addQueueWaits(const NOMAD::EvalType evalType, const int mainThreadNum, const std::vector<double>& queueWaits)
+{
+    {
+        NOMAD_CRITICAL(evalTelemetry);
+        Stats& stats = _stats[std::make_pair(evalType, mainThreadNum)];
+        for (const double wait : queueWaits)
+        {
+            stats._queueWait.add(static_cast<uint64_t>(std::max(0.0, wait) * 1e6));
+        }
+    }
+}
+
+
+void NOMAD::EvalTelemetry::addBlock(const NOMAD::EvalType evalType, const int mainThreadNum, const size_t nbPoints, const double blockTime)
+{
+    if (0 == nbPoints)
+    {
+        return;
+    }
+    const uint64_t blockTimeUs = static_cast<uint64_t>(std::max(0.0, blockTime) * 1e6);
+    const int threadNum = NOMAD::getThreadNum();
+    {
+        NOMAD_CRITICAL(evalTelemetry);
+        Stats& stats = _stats[std::make_pair(evalType, mainThreadNum)];
+        // The time of each point is not known inside a block.
+        stats._latency.add(blockTimeUs / nbPoints, nbPoints);
+        stats._blockTime.add(blockTimeUs);
+        stats._blockSize.add(nbPoints);
+        _busyTime[threadNum] += std::max(0.0, blockTime);
+    }
+}
+
+
+void NOMAD::EvalTelemetry::writeMetrics(const bool force)
+{
+    if (_metricsFile.empty())
+    {
+        return;
+    }
+
+    // Only one thread writes. The others do not wait.
+    bool expected = false;
+    if (!_writing.compare_exchange_strong(expected, true))
+    {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> sinceLastWrite = now - _lastWrite;
+    if (!force && sinceLastWrite.count() < static_cast<double>(_interval))
+    {
+        _writing = false;
+        return;
+    }
+    const std::chrono::duration<double> elapsed = now - _startTime;
+
+    std::ostringstream oss;
+    {
+        NOMAD_CRITICAL(evalTelemetry);
+        for (const auto& keyStats : _stats)
+        {
+            const Stats& stats = keyStats.second;
+            oss << "time=" << elapsed.count();
+            oss << " eval_type=" << NOMAD::evalTypeToString(keyStats.first.first);
+            oss << " main_thread=" << keyStats.first.second;
+            oss << " evals=" << stats._latency.getCount();
+            oss << " blocks=" << stats._blockTime.getCount();
+            oss << " latency_p50=" << secondsToString(stats._latency.getPercentile(50));
+            oss << " latency_p90=" << secondsToString(stats._latency.getPercentile(90));
+            oss << " latency_p99=" << secondsToString(stats._latency.getPercentile(99));
+            oss << " latency_max=" << secondsToString(stats._latency.getMax());
+            oss << " block_time_p50=" << secondsToString(stats._blockTime.getPercentile(50));
+            oss << " block_time_p99=" << secondsToString(stats._blockTime.getPercentile(99));
+            oss << " queue_wait_p50=" << secondsToString(stats._queueWait.getPercentile(50));
+            oss << " queue_wait_p99=" << secondsToString(stats._queueWait.getPercentile(99));
+            oss << " block_size_mean=" << stats._blockSize.getMean();
+            oss << " block_size_max=" << stats._blockSize.getMax();
+            oss << " queue_depth=" << stats._lastQueueDepth;
+            oss << " queue_depth_max=" << stats._queueDepth.getMax();
+            oss << "\n";
+        }
+        for (const auto& threadBusy : _busyTime)
+        {
+            oss << "time=" << elapsed.count();
+            oss << " eval_thread=" << threadBusy.first;
+            oss << " utilization=" << ((elapsed.count() > 0) ? 100.0 * threadBusy.second / elapsed.count() : 0.0);
+            oss << "\n";
+        }
+    }
+
+    std::ofstream out(_metricsFile, std::ios::app);
+    out << oss.str() << std::flush;
+
+    _lastWrite = now;
+    _writing = false;
+}
+
+
+void NOMAD::EvalTelemetry::display(NOMAD::ArrayOfString& s1, NOMAD::ArrayOfString& s2) const
+{
+    {
+        NOMAD_CRITICAL(evalTelemetry);
+        for (const auto& keyStats : _stats)
+        {
+            const Stats& stats = keyStats.second;
+            const std::string suffix = " (" + NOMAD::evalTypeToString(keyStats.first.first)
+                                       + ", main thread " + NOMAD::itos(keyStats.first.second) + ")";
+
+            s1.add("Evaluation latency per point" + suffix + " (s):");
+            s2.add("p50 " + secondsToString(stats._latency.getPercentile(50))
+                   + " p90 " + secondsToString(stats._latency.getPercentile(90))
+                   + " p99 " + secondsToString(stats._latency.getPercentile(99))
+                   + " max " + secondsToString(stats._latency.getMax())
+                   + " (" + NOMAD::itos(static_cast<size_t>(stats._latency.getCount())) + " points)");
+
+            s1.add("Evaluation queue wait" + suffix + " (s):");
+            s2.add("p50 " + secondsToString(stats._queueWait.getPercentile(50))
+                   + " p90 " + secondsToString(stats._queueWait.getPercentile(90))
+                   + " p99 " + secondsToString(stats._queueWait.getPercentile(99))
+                   + " max " + secondsToString(stats._queueWait.getMax()));
+
+            std::ostringstream blockSizeMean;
+            blockSizeMean << stats._blockSize.getMean();
+            s1.add("Block sizes" + suffix + ":");
+            s2.add("mean " + blockSizeMean.str()
+                   + " min " + NOMAD::itos(static_cast<size_t>(stats._blockSize.getMin()))
+                   + " max " + NOMAD::itos(static_cast<size_t>(stats._blockSize.getMax()))
+                   + " (" + NOMAD::itos(static_cast<size_t>(stats._blockSize.getCount())) + " blocks)");
+
+            s1.add("Evaluation queue depth" + suffix + ":");
+            s2.add("p50 " + NOMAD::itos(static_cast<size_t>(stats._queueDepth.getPercentile(50)))
+                   + " p90 " + NOMAD::itos(static_cast<size_t>(stats._queueDepth.getPercentile(90)))
+                   + " max " + NOMAD::itos(static_cast<size_t>(stats._queueDepth.getMax())));
+        }
+        if (!_busyTime.empty())
+        {
+            s1.add("Evaluation thread utilization (thread:%):");
+            s2.add(displayUtilization());
+        }
+    }
+}
+
+
+std::string NOMAD::EvalTelemetry::displayUtilization() const
+{
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - _startTime;
+    std::ostringstream oss;
+    oss.precision(3);
+    for (const auto& threadBusy : _busyTime)
+    {
+        if (oss.tellp() > 0)
+        {
+            oss << " ";
+        }
+        oss << threadBusy.first << ":" << ((elapsed.count() > 0) ? 100.0 * threadBusy.second / elapsed.count() : 0.0);
+    }
+    return oss.str();
+}
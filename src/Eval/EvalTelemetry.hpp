@@ -0,0 +1,219 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   EvalTelemetry.hpp
+ \brief  Histograms of the evaluation latencies and of the evaluation queue depth
+ \author Christophe Tribes
+ \date   October 2026
+ \see    EvalTelemetry.cpp
+ */
+#ifndef __NOMAD_4_5_EVALTELEMETRY__
+#define __NOMAD_4_5_EVALTELEMETRY__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Type/EvalType.hpp"
+#include "../Util/ArrayOfString.hpp"
+
+#include "../nomad_nsbegin.hpp"
+
+/// Histogram of nonnegative integer values, with a bounded relative error.
+/**
+ The buckets are as in HDR histograms: the values below 32 have their own
+ bucket; above, each power of 2 is split in 16 buckets of the same width.
+ A percentile is known within 1/16 of its value, for any range of values,
+ with a fixed number of buckets.
+
+ Not thread-safe.
+ */
+class DLL_EVAL_API LogHistogram
+{
+private:
+    std::vector<uint64_t>   _counts;
+    uint64_t                _count;
+    uint64_t                _min;
+    uint64_t                _max;
+    double                  _sum;
+
+public:
+    /// Constructor
+    LogHistogram();
+
+    /// Add a value.
+    /**
+     \param value   The value -- \b IN.
+     \param count   Number of times the value is added -- \b IN.
+     */
+    void add(const uint64_t value, const uint64_t count = 1);
+
+    uint64_t getCount() const { return _count; }
+    uint64_t getMin() const { return (0 == _count) ? 0 : _min; }
+    uint64_t getMax() const { return _max; }
+    double getMean() const { return (0 == _count) ? 0.0 : _sum / static_cast<double>(_count); }
+
+    /// Value under which are p percent of the values.
+    /**
+     \param p   The percentile, between 0 and 100 -- \b IN.
+     \return    The middle of the bucket of the percentile, 0 if there are no values.
+     */
+    uint64_t getPercentile(const double p) const;
+
+private:
+    static size_t bucketIndex(const uint64_t value);
+    static uint64_t bucketLowest(const size_t index);
+};
+
+
+/// Telemetry of the evaluations, per evaluator type and per main thread.
+/**
+ For each evaluator type (BB, MODEL, SURROGATE) and each main thread:
+ - the latency of the points (time of the block divided by its number of
+   points), and the time of the blocks;
+ - the time spent by the points in the evaluation queue;
+ - the sizes of the blocks;
+ - the depth of the evaluation queue, when a block is taken from it.
+ For each evaluation thread, the time spent in evaluations, for the
+ utilization of the threads.
+
+ The histograms are in the detailed stats (EVAL_STATS_FILE). They are also
+ written periodically in the metrics file (EVAL_METRICS_FILE), one line per
+ evaluator type and main thread, as key=value pairs: a local scraper can tail it.
+
+ Thread-safe.
+ */
+class DLL_EVAL_API EvalTelemetry
+{
+private:
+    /// Histograms of an evaluator type and a main thread. Times in microseconds.
+    struct Stats
+    {
+        LogHistogram    _latency;
+        LogHistogram    _blockTime;
+        LogHistogram    _queueWait;
+        LogHistogram    _blockSize;
+        LogHistogram    _queueDepth;
+        size_t          _lastQueueDepth = 0;
+    };
+
+    std::chrono::steady_clock::time_point _startTime;
+
+    /// Access in critical section evalTelemetry.
+    std::map<std::pair<EvalType, int>, Stats> _stats;
+
+    /// Time in evaluations of each evaluation thread, in seconds. Access in critical section evalTelemetry.
+    std::map<int, double> _busyTime;
+
+    std::string         _metricsFile;   ///< Empty if there is no metrics file
+    size_t              _interval;      ///< Minimum time between two writes of the metrics file, in seconds
+    std::chrono::steady_clock::time_point _lastWrite;   ///< Access by the thread that holds _writing
+    std::atomic<bool>   _writing;       ///< A thread is writing the metrics file, or checking if it is time to write
+
+public:
+    /// Constructor. No metrics file.
+    EvalTelemetry();
+
+    EvalTelemetry(const EvalTelemetry&) = delete;
+    EvalTelemetry& operator=(const EvalTelemetry&) = delete;
+
+    /// Reset the telemetry, and set the metrics file.
+    /**
+     \param metricsFile     The file name. Empty for no metrics file. An existing file is overwritten -- \b IN.
+     \param interval        Minimum time between two writes of the metrics file, in seconds -- \b IN.
+     */
+    void init(const std::string& metricsFile, const size_t interval);
+
+    /// A block is taken from the evaluation queue.
+    /**
+     \param evalType        Evaluator type of the block -- \b IN.
+     \param mainThreadNum   Main thread of the block -- \b IN.
+     \param queueDepth      Number of points in the queue, before the block is taken -- \b IN.
+     */
+    void addQueueDepth(const EvalType evalType, const int mainThreadNum, const size_t queueDepth);
+
+    /// The evaluation of a block starts.
+    /**
+     \param evalType        Evaluator type of the block -- \b IN.
+     \param mainThreadNum   Main thread of the block -- \b IN.
+     \param queueWaits      Time spent in the queue by each point of the block, in seconds -- \b IN.
+     */
+    void addQueueWaits(const EvalType evalType, const int mainThreadNum, const std::vector<double>& queueWaits);
+
+    /// A block is evaluated by the current thread.
+    /**
+     \param evalType        Evaluator type of the block -- \b IN.
+     \param mainThreadNum   Main thread of the block -- \b IN.
+     \param nbPoints        Number of points evaluated -- \b IN.
+     \param blockTime       Wall time of the evaluation of the block, in seconds -- \b IN.
+     */
+    void addBlock(const EvalType evalType, const int mainThreadNum, const size_t nbPoints, const double blockTime);
+
+    /// Write the metrics file if the interval has elapsed since the previous write.
+    /**
+     \param force   Write even if the interval has not elapsed -- \b IN.
+     */
+    void writeMetrics(const bool force = false);
+
+    /// Lines of the detailed stats.
+    /**
+     \param s1      Titles -- \b OUT.
+     \param s2      Values -- \b OUT.
+     */
+    void display(ArrayOfString& s1, ArrayOfString& s2) const;
+
+private:
+    /// Utilization of each evaluation thread, in percent, since init().
+    std::string displayUtilization() const;
+};
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_EVALTELEMETRY__
@@ -0,0 +1,187 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   EvalTimeModel.cpp
+ \brief  Prediction of the evaluation time of points
+ \author Christophe Tribes
+ \date   October 2026
+ \see    EvalTimeModel.hpp
+ */
+#include "../Eval/EvalTimeModel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+
+NOMAD::EvalTimeModel::EvalTimeModel()
+  : _points(),
+    _times(),
+    _next(0)
+{
+}
+
+
+void NOMAD::EvalTimeModel::addEvalTime(const NOMAD::Point& x, const double time)
+{
+    if (time < 0 || !x.isComplete())
+    {
+        return;
+    }
+    if (!_points.empty() && _points[0].size() != x.size())
+    {
+        // Points of a different dimension (ex. sub-problem with fixed variables). Start over.
+        _points.clear();
+        _times.clear();
+        _next = 0;
+    }
+
+    if (_points.size() < MAX_NB_POINTS)
+    {
+        _points.push_back(x);
+        _times.push_back(time);
+    }
+    else
+    {
+        _points[_next] = x;
+        _times[_next] = time;
+        _next = (_next + 1) % MAX_NB_POINTS;
+    }
+}
+
+
+std::vector<double> NOMAD::EvalTimeModel::computeScaling() const
+{
+    const size_t n = _points[0].size();
+    std::vector<double> scaling(n, 1.0);
+    for (size_t i = 0; i < n; i++)
+    {
+        double lb = NOMAD::INF, ub = NOMAD::M_INF;
+        for (const auto& point : _points)
+        {
+            const double xi = point[i].todouble();
+            lb = std::min(lb, xi);
+            ub = std::max(ub, xi);
+        }
+        if (ub > lb)
+        {
+            scaling[i] = 1.0 / (ub - lb);
+        }
+    }
+
+    return scaling;
+}
+
+
+double NOMAD::EvalTimeModel::predict(const NOMAD::Point& x, const std::vector<double>& scaling) const
+{
+    if (x.size() != scaling.size() || !x.isComplete())
+    {
+        return -1.0;
+    }
+
+    // Squared scaled distances to the evaluated points
+    std::vector<std::pair<double, size_t>> distances;
+    distances.reserve(_points.size());
+    for (size_t k = 0; k < _points.size(); k++)
+    {
+        double d2 = 0.0;
+        for (size_t i = 0; i < scaling.size(); i++)
+        {
+            const double di = (x[i].todouble() - _points[k][i].todouble()) * scaling[i];
+            d2 += di * di;
+        }
+        distances.push_back(std::make_pair(d2, k));
+    }
+
+    const size_t nbNeighbors = std::min(NB_NEIGHBORS, distances.size());
+    std::partial_sort(distances.begin(), distances.begin() + nbNeighbors, distances.end());
+
+    double sumW = 0.0, sumWT = 0.0;
+    for (size_t j = 0; j < nbNeighbors; j++)
+    {
+        if (distances[j].first < NOMAD::DEFAULT_EPSILON)
+        {
+            // Point already evaluated
+            return _times[distances[j].second];
+        }
+        const double w = 1.0 / std::sqrt(distances[j].first);
+        sumW += w;
+        sumWT += w * _times[distances[j].second];
+    }
+
+    return sumWT / sumW;
+}
+
+
+double NOMAD::EvalTimeModel::predict(const NOMAD::Point& x) const
+{
+    if (!isReady())
+    {
+        return -1.0;
+    }
+
+    return predict(x, computeScaling());
+}
+
+
+std::vector<double> NOMAD::EvalTimeModel::predict(const std::vector<NOMAD::EvalQueuePointPtr>& points) const
+{
+    std::vector<double> times(points.size(), -1.0);
+    if (!isReady())
+    {
+        return times;
+    }
+
+    const auto scaling = computeScaling();
+    for (size_t k = 0; k < points.size(); k++)
+    {
+        times[k] = predict(*points[k]->getX(), scaling);
+    }
+
+    return times;
+}
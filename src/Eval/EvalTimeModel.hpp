@@ -0,0 +1,117 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   EvalTimeModel.hpp
+ \brief  Prediction of the evaluation time of points
+ \author Christophe Tribes
+ \date   October 2026
+ \see    EvalTimeModel.cpp
+ */
+
+#ifndef __NOMAD_4_5_EVALTIMEMODEL__
+#define __NOMAD_4_5_EVALTIMEMODEL__
+
+#include <vector>
+
+#include "../Eval/EvalQueuePoint.hpp"
+#include "../Math/Point.hpp"
+
+#include "../nomad_nsbegin.hpp"
+
+/// Class to predict the wall-clock evaluation time of a point (EVAL_COST_AWARE_DISPATCH).
+/**
+ The model is built on the last evaluated points and their measured times.
+ The predicted time of a point is the average time of its nearest evaluated
+ neighbors, weighted by the inverse of the distance. Each coordinate is scaled
+ by the range of the evaluated points.
+
+ This model is cheap to update and to query, so that it can be used to
+ sort the queue of points before each block of evaluations.
+
+ \note This class is not thread-safe. The EvaluatorControl protects it.
+ */
+class DLL_EVAL_API EvalTimeModel
+{
+private:
+    /// Maximum number of points kept. Older points are replaced.
+    static constexpr size_t MAX_NB_POINTS = 500;
+
+    /// Minimum number of points for a prediction.
+    static constexpr size_t MIN_NB_POINTS = 5;
+
+    /// Number of neighbors used for a prediction.
+    static constexpr size_t NB_NEIGHBORS = 5;
+
+    std::vector<Point>  _points;    ///< Evaluated points
+    std::vector<double> _times;     ///< Evaluation times, in seconds
+    size_t              _next;      ///< Index of the next point to replace, when the model is full
+
+public:
+    /// Constructor
+    EvalTimeModel();
+
+    /// Add the measured evaluation time of a point.
+    void addEvalTime(const Point& x, const double time);
+
+    /// The model has enough points for a prediction.
+    bool isReady() const { return (_points.size() >= MIN_NB_POINTS); }
+
+    /// Predicted evaluation time of a point, in seconds. Negative if the model is not ready.
+    double predict(const Point& x) const;
+
+    /// Predicted evaluation times of the points of the queue. Negative if the model is not ready.
+    std::vector<double> predict(const std::vector<EvalQueuePointPtr>& points) const;
+
+private:
+    /// Scaling of each coordinate: the inverse of the range of the evaluated points.
+    std::vector<double> computeScaling() const;
+
+    double predict(const Point& x, const std::vector<double>& scaling) const;
+};
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_EVALTIMEMODEL__
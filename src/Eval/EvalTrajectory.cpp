@@ -0,0 +1,94 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   EvalTrajectory.cpp
+ \brief  Intermediate objective estimates of a multi-fidelity evaluation
+ \author Christophe Tribes
+ \date   October 2026
+ \see    EvalTrajectory.hpp
+ */
+#include "../Eval/EvalTrajectory.hpp"
+
+
+void NOMAD::EvalTrajectory::add(const size_t iteration, const NOMAD::Double& estimate)
+{
+    if (!estimate.isDefined()
+        || (!_records.empty() && iteration <= _records.back().first))
+    {
+        return;
+    }
+    _records.emplace_back(iteration, estimate);
+}
+
+
+NOMAD::Double NOMAD::EvalTrajectory::estimateAt(const size_t iteration) const
+{
+    NOMAD::Double estimate;
+    for (const auto& record : _records)
+    {
+        if (record.first > iteration)
+        {
+            break;
+        }
+        estimate = record.second;
+    }
+    return estimate;
+}
+
+
+bool NOMAD::EvalTrajectory::dominates(const size_t iteration,
+                                      const NOMAD::Double& estimate,
+                                      const NOMAD::Double& margin) const
+{
+    const NOMAD::Double reference = estimateAt(iteration);
+    if (!reference.isDefined() || !estimate.isDefined())
+    {
+        // Nothing to compare yet.
+        return false;
+    }
+    return (estimate > reference + margin * reference.abs());
+}
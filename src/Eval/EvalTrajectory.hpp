@@ -0,0 +1,105 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   EvalTrajectory.hpp
+ \brief  Intermediate objective estimates of a multi-fidelity evaluation
+ \author Christophe Tribes
+ \date   October 2026
+ \see    EvalTrajectory.cpp
+ */
+#ifndef __NOMAD_4_5_EVALTRAJECTORY__
+#define __NOMAD_4_5_EVALTRAJECTORY__
+
+#include <memory>
+#include <vector>
+
+#include "../Math/Double.hpp"
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Objective estimates of an evaluation along the iterations of the blackbox.
+/**
+ With parameter BB_EVAL_MULTI_FIDELITY, the blackbox reports an estimate of
+ its outputs at some of its iterations. The objective estimates of a
+ point are kept in increasing order of iterations, to be compared with the
+ trajectory of a reference evaluation.
+ */
+class DLL_EVAL_API EvalTrajectory
+{
+private:
+    std::vector<std::pair<size_t, Double>> _records;  ///< Pairs (iteration, objective estimate)
+
+public:
+    /// Constructor
+    explicit EvalTrajectory()
+      : _records()
+    {}
+
+    /// Add the objective estimate of an iteration. Records of previous iterations are ignored.
+    void add(const size_t iteration, const Double& estimate);
+
+    bool empty() const { return _records.empty(); }
+    size_t size() const { return _records.size(); }
+
+    /// The estimate of the last iteration reported up to \c iteration. Undefined if there is none.
+    Double estimateAt(const size_t iteration) const;
+
+    /// Is this estimate clearly worse than the estimate of this trajectory at the same iteration?
+    /**
+     \param iteration   The iteration of the estimate -- \b IN.
+     \param estimate    The objective estimate to compare -- \b IN.
+     \param margin      Relative margin -- \b IN.
+     \return            \c true if \c estimate exceeds the estimate of this trajectory by more than \c margin times its absolute value.
+     */
+    bool dominates(const size_t iteration, const Double& estimate, const Double& margin) const;
+};
+
+typedef std::shared_ptr<const EvalTrajectory> EvalTrajectoryPtr;
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_EVALTRAJECTORY__
@@ -46,16 +46,15 @@
 /*---------------------------------------------------------------------------------*/
 #include "../Eval/Evaluator.hpp"
 #include "../Output/OutputQueue.hpp"
+#include "../Util/ChildProcess.hpp"
 #include "../Util/fileutils.hpp"
-#include <cstdio>  // For popen
+#include "../Util/InstrumentedLock.hpp"
 #include <fstream>  // For ofstream
 #ifndef _WIN32
 #include <unistd.h> // for getpid
 #else
 #include <process.h>
 #define getpid _getpid
-#define popen  _popen
-#define pclose _pclose
 #endif
 
 // Initialize tmp files. NOTE: static variables for those are not working when building for Windows VS.
@@ -89,7 +88,10 @@ NOMAD::Evaluator::Evaluator(
     _evalXDefined(evalXDefined),
     _evalType(evalType),
     _bbOutputTypeList(_evalParams->getAttributeValue<NOMAD::BBOutputTypeList>("BB_OUTPUT_TYPE")),
-    _bbEvalFormat(_evalParams->getAttributeValue<NOMAD::ArrayOfDouble>("BB_EVAL_FORMAT"))
+    _bbEvalFormat(_evalParams->getAttributeValue<NOMAD::ArrayOfDouble>("BB_EVAL_FORMAT")),
+    _evalTimeout(_evalParams->getAttributeValue<size_t>("BB_EVAL_TIMEOUT")),
+    _evalStaged(_evalParams->getAttributeValue<bool>("BB_EVAL_STAGED")),
+    _evalMultiFidelity(_evalParams->getAttributeValue<bool>("BB_EVAL_MULTI_FIDELITY"))
 {
     init();
 }
@@ -119,6 +121,49 @@ void NOMAD::Evaluator::init()
 NOMAD::Evaluator::~Evaluator() = default;
 
 
+bool NOMAD::Evaluator::evalStopRequested()
+{
+    const auto& token = NOMAD::EvalCancelToken::getCurrent();
+    return (nullptr != token && token->stopRequested());
+}
+
+
+bool NOMAD::Evaluator::rejectPartialOutput(NOMAD::EvalPoint &x, const std::string &partialBBO)
+{
+    const auto& stagedEvalRejection = NOMAD::StagedEvalRejection::getCurrent();
+    if (nullptr == stagedEvalRejection
+        || !stagedEvalRejection->reject(NOMAD::BBOutput(partialBBO).getBBOAsArrayOfDouble()))
+    {
+        return false;
+    }
+
+    x.setBBO(stagedEvalRejection->completeBBO(partialBBO),
+             stagedEvalRejection->getBBOutputTypeList(),
+             stagedEvalRejection->getEvalType());
+    stagedEvalRejection->countRejected();
+
+    return true;
+}
+
+
+bool NOMAD::Evaluator::reportIntermediateOutput(NOMAD::EvalPoint &x, const size_t iteration, const std::string &bbo)
+{
+    const auto& stagedEvalRejection = NOMAD::StagedEvalRejection::getCurrent();
+    if (nullptr == stagedEvalRejection
+        || !stagedEvalRejection->truncate(x.getTag(), iteration, NOMAD::BBOutput(bbo).getBBOAsArrayOfDouble()))
+    {
+        return false;
+    }
+
+    // Keep the last estimate as low fidelity outputs.
+    const NOMAD::EvalType evalType = stagedEvalRejection->getEvalType();
+    x.setBBO(bbo, stagedEvalRejection->getBBOutputTypeList(), evalType);
+    x.setEvalStatus(NOMAD::EvalStatusType::EVAL_TRUNCATED, evalType);
+
+    return true;
+}
+
+
 void NOMAD::Evaluator::initializeTmpFiles(const std::string& tmpDir, const int & nbThreadsForParallelEval)
 {
     // Initialize tmp files for Evaluators
@@ -284,10 +329,8 @@ std::vector<bool> NOMAD::Evaluator::eval_block(NOMAD::Block &block,
         if (NOMAD::EvalStatusType::EVAL_IN_PROGRESS != it->getEvalStatus(_evalType) &&
             NOMAD::EvalStatusType::EVAL_WAIT != it->getEvalStatus(_evalType))
         {
-#ifdef _OPENMP
-            #pragma omp critical(warningEvalX)
-#endif
             {
+                NOMAD_CRITICAL(warningEvalX);
                 throw NOMAD::Exception(__FILE__, __LINE__, "EVAL should already be IN_PROGRESS for point" + it->display());
             }
         }
@@ -427,32 +470,39 @@ std::vector<bool> NOMAD::Evaluator::evalXBBExe(NOMAD::Block &block,
     // Stream for output file when bb manages output files (no redirection)
     std::ifstream finWithoutRedirection;
 
-    FILE *fresult = popen(cmd.c_str(), "r");
-    if (!fresult)
+    // The blackbox process is killed when the evaluation is cancelled or reaches BB_EVAL_TIMEOUT.
+    const NOMAD::EvalCancelTokenPtr cancelToken = NOMAD::EvalCancelToken::getCurrent();
+    NOMAD::ChildProcess bbProcess([cancelToken]() { return (nullptr != cancelToken && cancelToken->stopRequested()); });
+
+    if (!bbProcess.start(cmd))
     {
         // Something went wrong with the evaluation.
         // Point could be re-submitted.
         for (auto& it : block)
         {
             it->setEvalStatus(NOMAD::EvalStatusType::EVAL_ERROR, _evalType);
-#ifdef _OPENMP
-            #pragma omp critical(warningEvalX)
-#endif
             {
+                NOMAD_CRITICAL(warningEvalX);
                 std::cout << "Warning: Evaluation error with point " << it->display() << std::endl;
             }
         }
     }
     else
     {
+        // Points for which an output was obtained before a stop request
+        std::vector<bool> outputRead(block.size(), false);
+        // Points stopped from their intermediate outputs (BB_EVAL_MULTI_FIDELITY).
+        std::vector<bool> truncated(block.size(), false);
+        // The blackbox was killed after the early rejection (BB_EVAL_STAGED) or the truncation
+        // (BB_EVAL_MULTI_FIDELITY) of the last point
+        bool bbKilledOnRejection = false;
+        std::string outputLine;
+        NOMAD::ChildProcessReadStatus readStatus = NOMAD::ChildProcessReadStatus::LINE_READ;
 
         if (!_bbRedirection)
         {
-            char buffer[BUFFER_SIZE];
-            char *outputline = nullptr;
-
-            outputline = fgets(buffer, sizeof(buffer), fresult);
-            if ( nullptr != outputline) // Something to log
+            readStatus = bbProcess.readLine(outputLine);
+            if (NOMAD::ChildProcessReadStatus::LINE_READ == readStatus) // Something to log
             {
 
                 // BB log file
@@ -467,65 +517,78 @@ std::vector<bool> NOMAD::Evaluator::evalXBBExe(NOMAD::Block &block,
                     // Get blackbox standard and error outputs (not yet bb_output) and write into log file.
                     // If something is output then do at least once with the base message. Otherwise, no file is created.
                     foutLogWithoutRedirection << "####### Blackbox evaluation output log (no redirection)  ######## " <<std::endl;
-                    std::string out;
-                    do
+                }
+                // Read all the output, even if the log file is not available.
+                do
+                {
+                    if (foutLogWithoutRedirection.is_open())
                     {
-                        out = outputline;
-                        // delete trailing '\n'
-                        out.erase(out.size() - 1);
-                        foutLogWithoutRedirection << out << std::endl;
-                        outputline = fgets(buffer, sizeof(buffer), fresult);
+                        foutLogWithoutRedirection << outputLine << std::endl;
                     }
-                    while (nullptr != outputline);
+                    readStatus = bbProcess.readLine(outputLine);
                 }
+                while (NOMAD::ChildProcessReadStatus::LINE_READ == readStatus);
                 foutLogWithoutRedirection.close();
             }
 
-            // Test bb outputs file
-            finWithoutRedirection.open( tmpoutfile.c_str() );
-            if (!finWithoutRedirection.is_open())
+            // When the blackbox is stopped, the output file is not complete: do not read it.
+            if (NOMAD::ChildProcessReadStatus::STOPPED != readStatus)
             {
-                for (auto& it : block)
+                // Test bb outputs file
+                finWithoutRedirection.open( tmpoutfile.c_str() );
+                if (!finWithoutRedirection.is_open())
                 {
-                    it->setEvalStatus(NOMAD::EvalStatusType::EVAL_ERROR, _evalType);
-#ifdef _OPENMP
-#pragma omp critical(warningEvalX)
-#endif
+                    for (auto& it : block)
                     {
-                        std::cout << "Warning: Cannot open output file " << tmpoutfile << " for point " << it->display() << std::endl;
+                        it->setEvalStatus(NOMAD::EvalStatusType::EVAL_ERROR, _evalType);
+                        {
+                            NOMAD_CRITICAL(warningEvalX);
+                            std::cout << "Warning: Cannot open output file " << tmpoutfile << " for point " << it->display() << std::endl;
+                        }
                     }
                 }
-            }
 
-            // Read bb outputs in file
-            for (size_t index = 0; index < block.size(); index++)
-            {
-                const std::shared_ptr<NOMAD::EvalPoint>& x = block[index];
-
-                // Only EVAL_IN_PROGRESS are managed.
-                // EVAL_WAIT points are not evaluated
-                if (x->getEvalStatus(_evalType) != NOMAD::EvalStatusType::EVAL_WAIT)
+                // Read bb outputs in file
+                for (size_t index = 0; index < block.size(); index++)
                 {
+                    const std::shared_ptr<NOMAD::EvalPoint>& x = block[index];
 
-                    std::string bbo;
-                    std::getline(finWithoutRedirection, bbo);
-
-                    // When several points are evaluated, an empty line is a failed evaluation
-                    if (!bbo.empty())
+                    // Only EVAL_IN_PROGRESS are managed.
+                    // EVAL_WAIT points are not evaluated
+                    if (x->getEvalStatus(_evalType) != NOMAD::EvalStatusType::EVAL_WAIT)
                     {
-                        // Process blackbox output
-                        x->setBBO(bbo, _bbOutputTypeList, _evalType);
-                        auto bbOutput = x->getEval(_evalType)->getBBOutput();
 
-                        evalOk[index] = bbOutput.getEvalOk();
-                        countEval[index] = bbOutput.getCountEval(_bbOutputTypeList);
+                        std::string bbo;
+                        std::getline(finWithoutRedirection, bbo);
+
+                        // When several points are evaluated, an empty line is a failed evaluation
+                        if (!bbo.empty())
+                        {
+                            // Process blackbox output
+                            x->setBBO(bbo, _bbOutputTypeList, _evalType);
+                            auto bbOutput = x->getEval(_evalType)->getBBOutput();
+
+                            evalOk[index] = bbOutput.getEvalOk();
+                            countEval[index] = bbOutput.getCountEval(_bbOutputTypeList);
+                        }
                     }
                 }
+                finWithoutRedirection.close();
             }
-            finWithoutRedirection.close();
         }
         else  // Nomad is handling bb redirection
         {
+            // With BB_EVAL_STAGED or BB_EVAL_MULTI_FIDELITY, the outputs of a point may be given on several lines.
+            const bool stagedOutput = ((_evalStaged || _evalMultiFidelity) && NOMAD::EvalType::BB == _evalType);
+            size_t lastIndex = 0;
+            for (size_t index = 0; index < block.size(); index++)
+            {
+                if (block[index]->getEvalStatus(_evalType) != NOMAD::EvalStatusType::EVAL_WAIT)
+                {
+                    lastIndex = index;
+                }
+            }
+
             for (size_t index = 0; index < block.size(); index++)
             {
                 const std::shared_ptr<NOMAD::EvalPoint>& x = block[index];
@@ -534,51 +597,90 @@ std::vector<bool> NOMAD::Evaluator::evalXBBExe(NOMAD::Block &block,
                 // EVAL_WAIT points are not evaluated
                 if (x->getEvalStatus(_evalType) != NOMAD::EvalStatusType::EVAL_WAIT)
                 {
+                    bool rejected = false, truncatedPoint = false;
+                    if (stagedOutput)
+                    {
+                        // No need to read the outputs of a rejected or truncated point
+                        // when no other point follows.
+                        readStatus = readStagedOutput(bbProcess, x->getTag(), outputLine,
+                                                      rejected, truncatedPoint, index == lastIndex);
+                        truncated[index] = truncatedPoint;
+                    }
+                    else
+                    {
+                        readStatus = bbProcess.readLine(outputLine);
+                    }
 
-                    char buffer[BUFFER_SIZE];
-                    char *outputLine = nullptr;
-
-                    size_t nbTries=0;
-                    while (nbTries < 20)
+                    if (rejected)
                     {
-                        nbTries++;
-
-                        outputLine = fgets(buffer, sizeof(buffer), fresult);
-
-                        if( feof(fresult) )
-                        { // c-stream eof detected. Output is empty, break the loop
-                            x->setEvalStatus(NOMAD::EvalStatusType::EVAL_ERROR, _evalType);
-                            s = "Warning: Evaluation error with point " + x->display();
-                            s += ": output is empty. Let's count eval anyway (I).";
-                            NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_WARNING);
-                            countEval[index] = true;
-                            break;
-                        }
+                        // The point cannot be a success. Keep the partial outputs.
+                        const auto& stagedEvalRejection = NOMAD::StagedEvalRejection::getCurrent();
+                        x->setBBO(stagedEvalRejection->completeBBO(outputLine), _bbOutputTypeList, _evalType);
+                        stagedEvalRejection->countRejected();
 
-                        if (nullptr != outputLine)
-                        {
-                            // Evaluation succeeded. Get and process blackbox output.
-                            std::string bbo(outputLine);
-                            // delete trailing '\n'
-                            bbo.erase(bbo.size() - 1);
+                        evalOk[index] = true;
+                        countEval[index] = true;
+                        outputRead[index] = true;
 
-                            // Process blackbox output
-                            x->setBBO(bbo, _bbOutputTypeList, _evalType);
-                            auto bbOutput = x->getEval(_evalType)->getBBOutput();
+                        if (index == lastIndex)
+                        {
+                            bbProcess.kill();
+                            bbKilledOnRejection = true;
+                            OUTPUT_INFO_START
+                            s = "Blackbox process killed: staged evaluation rejected for point " + x->display();
+                            NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_INFO);
+                            OUTPUT_INFO_END
+                        }
+                    }
+                    else if (truncatedPoint)
+                    {
+                        // The point is dominated. Keep its last estimate.
+                        x->setBBO(outputLine, _bbOutputTypeList, _evalType);
 
-                            evalOk[index] = bbOutput.getEvalOk();
-                            countEval[index] = bbOutput.getCountEval(_bbOutputTypeList);
+                        countEval[index] = true;
+                        outputRead[index] = true;
 
-                            break;
+                        if (index == lastIndex)
+                        {
+                            bbProcess.kill();
+                            bbKilledOnRejection = true;
+                            OUTPUT_INFO_START
+                            s = "Blackbox process killed: evaluation truncated for point " + x->display();
+                            NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_INFO);
+                            OUTPUT_INFO_END
                         }
                     }
-                    if( ! feof(fresult) && nullptr == outputLine )
+                    else if (NOMAD::ChildProcessReadStatus::LINE_READ == readStatus)
+                    {
+                        // Evaluation succeeded. Process blackbox output.
+                        x->setBBO(outputLine, _bbOutputTypeList, _evalType);
+                        auto bbOutput = x->getEval(_evalType)->getBBOutput();
+
+                        evalOk[index] = bbOutput.getEvalOk();
+                        countEval[index] = bbOutput.getCountEval(_bbOutputTypeList);
+                        outputRead[index] = true;
+                    }
+                    else if (NOMAD::ChildProcessReadStatus::STOPPED == readStatus)
+                    {
+                        // Remaining points are handled below.
+                        break;
+                    }
+                    else if (NOMAD::ChildProcessReadStatus::END_OF_OUTPUT == readStatus)
+                    {
+                        // Output is empty
+                        x->setEvalStatus(NOMAD::EvalStatusType::EVAL_ERROR, _evalType);
+                        s = "Warning: Evaluation error with point " + x->display();
+                        s += ": output is empty. Let's count eval anyway (I).";
+                        NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_WARNING);
+                        countEval[index] = true;
+                    }
+                    else
                     {
                         // Something went wrong with the evaluation.
                         // Point could be re-submitted.
                         x->setEvalStatus(NOMAD::EvalStatusType::EVAL_ERROR, _evalType);
                         s = "Warning: Evaluation error with point " + x->display();
-                        s += ": output is empty. Let's count eval anyway (II). Nb Tries to read output: " + std::to_string(nbTries) + ". You may consider increasing the number of tries in the code and rebuild." ;
+                        s += ": output cannot be read. Let's count eval anyway (II).";
                         NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_WARNING);
                         countEval[index] = true;
                     }
@@ -586,8 +688,25 @@ std::vector<bool> NOMAD::Evaluator::evalXBBExe(NOMAD::Block &block,
             }
         }
 
+        // Evaluation cancelled or timed out: kill the blackbox and all its child processes.
+        NOMAD::EvalStatusType stopEvalStatus = NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED;
+        if (NOMAD::ChildProcessReadStatus::STOPPED == readStatus)
+        {
+            bbProcess.kill();
+            stopEvalStatus = cancelToken->getStopEvalStatus();
+            OUTPUT_INFO_START
+            s = "Blackbox process killed: " + NOMAD::enumStr(stopEvalStatus);
+            NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_INFO);
+            OUTPUT_INFO_END
+        }
+
         // Get exit status of the bb.exe. If it is not 0, there was an error.
-        int exitStatus = pclose(fresult);
+        // A blackbox killed after an early rejection is not an error.
+        int exitStatus = bbProcess.close();
+        if (bbKilledOnRejection)
+        {
+            exitStatus = 0;
+        }
 
         size_t index = 0;   // used to update evalOk
         for (auto& it : block)
@@ -599,7 +718,28 @@ std::vector<bool> NOMAD::Evaluator::evalXBBExe(NOMAD::Block &block,
             if ( NOMAD::EvalStatusType::EVAL_WAIT != x->getEvalStatus(_evalType) )
             {
 
-                if (exitStatus)
+                if (truncated[index])
+                {
+                    // Not a failure, but not an evaluation ok either.
+                    evalOk[index] = false;
+                    x->setEvalStatus(NOMAD::EvalStatusType::EVAL_TRUNCATED, _evalType);
+                }
+                else if (NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED != stopEvalStatus)
+                {
+                    // Keep the outputs obtained before the blackbox was killed.
+                    if (outputRead[index])
+                    {
+                        x->setEvalStatus(evalOk[index] ? NOMAD::EvalStatusType::EVAL_OK : NOMAD::EvalStatusType::EVAL_FAILED, _evalType);
+                    }
+                    else
+                    {
+                        // Not a failure. A timed out evaluation used the resources, count it.
+                        evalOk[index] = false;
+                        x->setEvalStatus(stopEvalStatus, _evalType);
+                        countEval[index] = (NOMAD::EvalStatusType::EVAL_TIMEOUT == stopEvalStatus);
+                    }
+                }
+                else if (exitStatus)
                 {
                     evalOk[index] = false;
                     // Test eval status to prevent multiple error display (see above)
@@ -628,3 +768,90 @@ std::vector<bool> NOMAD::Evaluator::evalXBBExe(NOMAD::Block &block,
 
     return evalOk;
 }
+
+
+NOMAD::ChildProcessReadStatus NOMAD::Evaluator::readStagedOutput(NOMAD::ChildProcess &bbProcess,
+                                                                 const int tag,
+                                                                 std::string &bbo,
+                                                                 bool &rejected,
+                                                                 bool &truncated,
+                                                                 const bool stopOnRejection) const
+{
+    const auto& stagedEvalRejection = NOMAD::StagedEvalRejection::getCurrent();
+    NOMAD::ChildProcessReadStatus readStatus = NOMAD::ChildProcessReadStatus::LINE_READ;
+    std::string line;
+    size_t nbOutputs = 0;
+
+    bbo.clear();
+    rejected = false;
+    truncated = false;
+    while (nbOutputs < _bbOutputTypeList.size())
+    {
+        readStatus = bbProcess.readLine(line);
+        if (NOMAD::ChildProcessReadStatus::LINE_READ != readStatus)
+        {
+            // Incomplete outputs are processed as usual: the evaluation is in error.
+            // A truncated point keeps its last estimate.
+            if (NOMAD::ChildProcessReadStatus::END_OF_OUTPUT == readStatus && (nbOutputs > 0 || truncated))
+            {
+                readStatus = NOMAD::ChildProcessReadStatus::LINE_READ;
+            }
+            break;
+        }
+
+        const NOMAD::ArrayOfString words(line);
+        if (0 == words.size())
+        {
+            // An empty line ends the outputs of the point.
+            break;
+        }
+
+        std::string keyword = words[0];
+        NOMAD::toupper(keyword);
+        if (_evalMultiFidelity && "ITER" == keyword)
+        {
+            // Intermediate estimate of all the outputs: ITER iteration outputs.
+            // The estimates following a truncation are ignored.
+            size_t iteration = 0;
+            if (!rejected && !truncated && words.size() > 2 && NOMAD::atost(words[1], iteration))
+            {
+                std::string estimate = words[2];
+                for (size_t i = 3; i < words.size(); i++)
+                {
+                    estimate += " " + words[i];
+                }
+                if (   nullptr != stagedEvalRejection
+                    && stagedEvalRejection->truncate(tag, iteration, NOMAD::BBOutput(estimate).getBBOAsArrayOfDouble()))
+                {
+                    bbo = estimate;
+                    truncated = true;
+                    if (stopOnRejection)
+                    {
+                        break;
+                    }
+                }
+            }
+            continue;
+        }
+        nbOutputs += words.size();
+
+        // The remaining outputs of a rejected or truncated point are ignored.
+        if (!rejected && !truncated)
+        {
+            bbo += (bbo.empty() ? "" : " ") + line;
+            if (   _evalStaged
+                && nullptr != stagedEvalRejection
+                && nbOutputs < _bbOutputTypeList.size()
+                && stagedEvalRejection->reject(NOMAD::BBOutput(bbo).getBBOAsArrayOfDouble()))
+            {
+                rejected = true;
+                if (stopOnRejection)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    return readStatus;
+}
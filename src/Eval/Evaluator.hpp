@@ -56,9 +56,12 @@
 #define __NOMAD_4_5_EVALUATOR__
 
 #include "../Eval/BBOutput.hpp"
+#include "../Eval/EvalCancelToken.hpp"
 #include "../Eval/EvalPoint.hpp"
+#include "../Eval/StagedEvalRejection.hpp"
 #include "../Param/EvalParameters.hpp"
 #include "../Type/EvalType.hpp"
+#include "../Util/ChildProcess.hpp"
 
 #include "../nomad_platform.hpp"
 #include "../nomad_nsbegin.hpp"
@@ -106,6 +109,12 @@ private:
     static bool   _bbRedirection;
     
     const ArrayOfDouble _bbEvalFormat;
+
+    const size_t   _evalTimeout;   ///< Maximum duration of an evaluation in seconds (BB_EVAL_TIMEOUT)
+
+    const bool     _evalStaged;    ///< The blackbox reports its outputs in stages (BB_EVAL_STAGED)
+
+    const bool     _evalMultiFidelity; ///< The blackbox reports intermediate estimates of its outputs (BB_EVAL_MULTI_FIDELITY)
     
 public:
 
@@ -140,6 +149,51 @@ public:
     
     const EvalType& getEvalType() const { return _evalType; }
 
+    size_t getEvalTimeout() const { return _evalTimeout; }
+
+    bool getEvalStaged() const { return _evalStaged; }
+
+    bool getEvalMultiFidelity() const { return _evalMultiFidelity; }
+
+    /// Should the evaluation in progress in the current thread stop?
+    /**
+     * True when the evaluation was cancelled by EvaluatorControl or when
+     * BB_EVAL_TIMEOUT is reached. A user-defined eval_x() or eval_block()
+     * may call this function periodically and return early (evaluation not ok).
+     * The points are then given the status EVAL_CANCELLED or EVAL_TIMEOUT.
+     */
+    static bool evalStopRequested();
+
+    /// Can the evaluation in progress of x stop, given its first outputs?
+    /**
+     * Used with BB_EVAL_STAGED. A user-defined eval_x() or eval_block() may
+     * call this function after computing the first outputs of x, in the order
+     * of BB_OUTPUT_TYPE, for instance the cheap EB constraints. When the point
+     * cannot be a success, x is given the partial outputs completed with INF,
+     * and the function returns true: the evaluation should return early
+     * (evaluation ok and counted).
+
+     \param x           The point evaluated -- \b IN/OUT.
+     \param partialBBO  The first outputs of x -- \b IN.
+     \return            \c true if the evaluation of x can stop.
+     */
+    static bool rejectPartialOutput(EvalPoint &x, const std::string &partialBBO);
+
+    /// Can the evaluation in progress of x stop, given an intermediate estimate of its outputs?
+    /**
+     * Used with BB_EVAL_MULTI_FIDELITY. A user-defined eval_x() may call this
+     * function with the estimate of all the outputs of x at an iteration of
+     * the blackbox. When the estimate is dominated by the reference evaluation,
+     * x is given the estimate and the status EVAL_TRUNCATED, and the function
+     * returns true: the evaluation should return early (counted).
+
+     \param x           The point evaluated -- \b IN/OUT.
+     \param iteration   The iteration of the blackbox -- \b IN.
+     \param bbo         The estimate of all the outputs of x -- \b IN.
+     \return            \c true if the evaluation of x can stop.
+     */
+    static bool reportIntermediateOutput(EvalPoint &x, const size_t iteration, const std::string &bbo);
+
     /*---------------*/
     /* Other methods */
     /*---------------*/
@@ -186,6 +240,23 @@ private:
     virtual std::vector<bool> evalXBBExe(Block &block,
                                          const Double &hMax,
                                          std::vector<bool> &countEval) const;
+
+    /// Helper for evalXBBExe(): read the outputs of a point given in stages (BB_EVAL_STAGED) or with intermediate estimates (BB_EVAL_MULTI_FIDELITY)
+    /**
+     \param bbProcess        The blackbox process -- \b IN.
+     \param tag              The tag of the point -- \b IN.
+     \param bbo              The outputs read, partial if the point is rejected, last estimate if it is truncated -- \b OUT.
+     \param rejected         The point cannot be a success -- \b OUT.
+     \param truncated        The point is dominated by the reference evaluation -- \b OUT.
+     \param stopOnRejection  Stop reading when the point is rejected or truncated -- \b IN.
+     \return                 The status of the last read.
+     */
+    ChildProcessReadStatus readStagedOutput(ChildProcess &bbProcess,
+                                            const int tag,
+                                            std::string &bbo,
+                                            bool &rejected,
+                                            bool &truncated,
+                                            bool stopOnRejection) const;
 };
 
 typedef std::shared_ptr<Evaluator> EvaluatorPtr;
@@ -51,11 +51,17 @@
 #include "../Eval/EvaluatorControl.hpp"
 #include "../Output/OutputQueue.hpp"
 #include "../Output/OutputDirectToFile.hpp"
+#include "../Output/OverheadAccounting.hpp"
+#include "../Output/Trace.hpp"
 #include "../Type/EvalSortType.hpp"
 #include "../Util/AllStopReasons.hpp"
 #include "../Util/Clock.hpp"
+#include "../Util/InstrumentedLock.hpp"
 #include "../Util/MicroSleep.hpp"
 
+#include <algorithm>
+#include <chrono>
+
 /*-----------------------------------*/
 /*   static members initialization   */
 /*-----------------------------------*/
@@ -71,6 +77,7 @@ bool NOMAD::EvaluatorControl::_customOpportunisticOnlyCheck = false;
 NOMAD::EvalCallbackFunc<NOMAD::CallbackType::EVAL_STOP_CHECK> NOMAD::EvaluatorControl::_cbEvalStopCheck = NOMAD::EvaluatorControl::defaultEvalCB<bool&>;
 NOMAD::EvalCallbackFunc<NOMAD::CallbackType::EVAL_FAIL_CHECK> NOMAD::EvaluatorControl::_cbFailEvalCheck = NOMAD::EvaluatorControl::defaultEvalCB<>;
 bool NOMAD::EvaluatorControl::_cbFailEvalCheckIsDefault = true;
+bool NOMAD::EvaluatorControl::_cbEvalOpportunisticCheckIsDefault = true;
 
 std::shared_ptr<NOMAD::ComparePriorityMethod> NOMAD::EvaluatorControl::_userCompMethod = nullptr;
 
@@ -87,6 +94,7 @@ void DLL_EVAL_API NOMAD::EvaluatorControl::addEvalCallback<NOMAD::CallbackType::
 template<>
 void DLL_EVAL_API NOMAD::EvaluatorControl::addEvalCallback<NOMAD::CallbackType::EVAL_OPPORTUNISTIC_CHECK>(const NOMAD::EvalCallbackFunc<CallbackType::EVAL_OPPORTUNISTIC_CHECK>& evalCbFunc)
 {
+    _cbEvalOpportunisticCheckIsDefault = false;
     _cbEvalOpportunisticCheck = evalCbFunc;
     _customOpportunisticOnlyCheck = true;  // The custom opportunistic check is the only one considered, the default is not. See below for having both.
 }
@@ -95,6 +103,7 @@ void DLL_EVAL_API NOMAD::EvaluatorControl::addEvalCallback<NOMAD::CallbackType::
 template<>
 void DLL_EVAL_API NOMAD::EvaluatorControl::addEvalCallback<NOMAD::CallbackType::EVAL_OPPORTUNISTIC_CHECK>(const NOMAD::EvalCallbackFunc<CallbackType::EVAL_OPPORTUNISTIC_CHECK>& evalCbFunc, bool customOnly)
 {
+    _cbEvalOpportunisticCheckIsDefault = false;
     _cbEvalOpportunisticCheck = evalCbFunc;
     _customOpportunisticOnlyCheck = customOnly;
 }
@@ -187,9 +196,6 @@ void NOMAD::EvaluatorControl::runEvalCallback<NOMAD::CallbackType::POST_EVAL_UPD
 // To be called by the Constructor.
 void NOMAD::EvaluatorControl::init()
 {
-#ifdef _OPENMP
-    omp_init_lock(&_evalQueueLock);
-#endif // _OPENMP
 
     _mainThreads.clear();
     _mainThreadInfo.clear();
@@ -209,6 +215,16 @@ void NOMAD::EvaluatorControl::init()
     _maxModelEval = _evalContGlobalParams->getTypeAttribute<size_t>("MODEL_MAX_EVAL");
     _useCacheFileForRerun = _evalContGlobalParams->getTypeAttribute<bool>("USE_CACHE_FILE_FOR_RERUN");
     _nbThreadsForParallelEval = _evalContGlobalParams->getTypeAttribute<int>("NB_THREADS_PARALLEL_EVAL");
+    _bbAdaptiveBlockSize = _evalContGlobalParams->getTypeAttribute<bool>("BB_ADAPTIVE_BLOCK_SIZE");
+    _evalCostAwareDispatch = _evalContGlobalParams->getTypeAttribute<bool>("EVAL_COST_AWARE_DISPATCH");
+    _evalHedging.setPercentile(_evalContGlobalParams->getAttributeValue<size_t>("BB_HEDGING_PERCENTILE"));
+    _deterministicParallel = _evalContGlobalParams->getTypeAttribute<bool>("DETERMINISTIC_PARALLEL");
+    _opportunisticCancel = _evalContGlobalParams->getTypeAttribute<bool>("EVAL_OPPORTUNISTIC_CANCEL");
+    _nbThreadsSurrogateEval = _evalContGlobalParams->getTypeAttribute<size_t>("NB_THREADS_SURROGATE_EVAL");
+    _evalQueueCheckpoint.init(_evalContGlobalParams->getAttributeValue<std::string>("EVAL_QUEUE_CHECKPOINT_FILE"),
+                              _evalContGlobalParams->getAttributeValue<size_t>("EVAL_QUEUE_CHECKPOINT_INTERVAL"));
+    _evalTelemetry.init(_evalContGlobalParams->getAttributeValue<std::string>("EVAL_METRICS_FILE"),
+                        _evalContGlobalParams->getAttributeValue<size_t>("EVAL_METRICS_INTERVAL"));
 
     // Add the first main thread (#0). More main threads may be added later
     addMainThread(0, _evalContParams);
@@ -262,9 +278,6 @@ void NOMAD::EvaluatorControl::destroy()
     // NB: valid only because we consider a unique Evaluator in a run
     resetCallbacks();
 
-#ifdef _OPENMP
-    omp_destroy_lock(&_evalQueueLock);
-#endif // _OPENMP
 }
 
 bool NOMAD::EvaluatorControl::hasEvaluator(NOMAD::EvalType evalType) const
@@ -313,7 +326,9 @@ void NOMAD::EvaluatorControl::addMainThread(const int threadNum,
         _mainThreadInfo.emplace(std::piecewise_construct, std::forward_as_tuple(threadNum), std::forward_as_tuple(std::move(evalContParamsU)));
 
         // Main thread added. Create tmp files. For each main thread we may have several threads for parallel eval. Each one has its own tmp file.
-        NOMAD::Evaluator::initializeTmpFiles(_evalContGlobalParams->getAttributeValue<std::string>("TMP_DIR"), _nbThreadsForParallelEval->getValue());
+        // The threads for static surrogate evaluations (NB_THREADS_SURROGATE_EVAL) come after the threads for parallel eval.
+        NOMAD::Evaluator::initializeTmpFiles(_evalContGlobalParams->getAttributeValue<std::string>("TMP_DIR"),
+                                             _nbThreadsForParallelEval->getValue() + static_cast<int>(_nbThreadsSurrogateEval->getValue()));
 
 
     }
@@ -571,7 +586,7 @@ void NOMAD::EvaluatorControl::clearEvaluatedPoints(const int threadNum)
 }
 
 
-const NOMAD::SuccessType& NOMAD::EvaluatorControl::getSuccessType(const int threadNum) const
+NOMAD::SuccessType NOMAD::EvaluatorControl::getSuccessType(const int threadNum) const
 {
     return getMainThreadInfo(threadNum).getSuccessType();
 }
@@ -583,6 +598,12 @@ void NOMAD::EvaluatorControl::setSuccessType(const int threadNum, const NOMAD::S
 }
 
 
+void NOMAD::EvaluatorControl::updateSuccessType(const int threadNum, const NOMAD::SuccessType& success)
+{
+    getMainThreadInfo(threadNum).updateSuccessType(success);
+}
+
+
 NOMAD::Double NOMAD::EvaluatorControl::getHMax(const int threadNum) const
 {
     NOMAD::Double hMax = NOMAD::INF;
@@ -637,6 +658,22 @@ void NOMAD::EvaluatorControl::setEvalSortType(NOMAD::EvalSortType evalSortType)
 }
 
 
+bool NOMAD::EvaluatorControl::useSurrogatePipeline(const int mainThreadNum) const
+{
+#ifdef _OPENMP
+    // Same conditions as the sort of the trial points using the static surrogate.
+    return (   _nbThreadsSurrogateEval->getValue() > 0
+            && !_deterministicParallel->getValue()
+            && NOMAD::EvalSortType::SURROGATE == getEvalSortType(mainThreadNum)
+            && NOMAD::EvalType::BB == getCurrentEvalType(mainThreadNum)
+            && getOpportunisticEval(mainThreadNum)
+            && nullptr != getMainThreadInfo(mainThreadNum).findEvaluator(NOMAD::EvalType::SURROGATE));
+#else
+    return false;
+#endif // _OPENMP
+}
+
+
 bool NOMAD::EvaluatorControl::getOpportunisticEval(const int mainThreadNum) const
 {
     return getMainThreadInfo(mainThreadNum).getOpportunisticEval();
@@ -704,7 +741,7 @@ void NOMAD::EvaluatorControl::lockQueue()
         throw NOMAD::Exception(__FILE__, __LINE__, err);
     }
     // Note: The queue could be already locked, ex. by popBlock.
-    omp_set_lock(&_evalQueueLock);
+    _evalQueueLock.set();
 #endif // _OPENMP
 }
 
@@ -724,19 +761,20 @@ void NOMAD::EvaluatorControl::unlockQueue(bool doSort, const size_t keepN, const
 
 #ifdef _OPENMP
     // 2- Verify the queue was already locked. The lock should have been set by lockQueue().
-    if (omp_test_lock(&_evalQueueLock))
+    if (_evalQueueLock.test())
     {
         // Queue was not locked. Queue is now locked.
         std::string err = "Error: trying to unlock a queue that was not locked.";
-        omp_unset_lock(&_evalQueueLock);
+        _evalQueueLock.unset();
         throw NOMAD::Exception(__FILE__, __LINE__, err);
     }
 #endif // _OPENMP
 
     // The EvalQueuePoints are added randomly.
     // Sort the queue, using sorting algorithm, if doSort is true (default).
-    // In non-opportunistic context, it is useless to sort.
-    if (doSort && getOpportunisticEval(threadNum) && getQueueSize(-1) > 1)
+    // In non-opportunistic context, it is useless to sort, except to
+    // dispatch the longest evaluations first.
+    if (doSort && (getOpportunisticEval(threadNum) || _evalCostAwareDispatch->getValue()) && getQueueSize(-1) > 1)
     {
         sort(_evalPointQueue,false);
     }
@@ -805,7 +843,7 @@ void NOMAD::EvaluatorControl::unlockQueue(bool doSort, const size_t keepN, const
 
     // Now, unlock the queue.
 #ifdef _OPENMP
-    omp_unset_lock(&_evalQueueLock);
+    _evalQueueLock.unset();
 #endif // _OPENMP
 }
 
@@ -834,13 +872,13 @@ bool NOMAD::EvaluatorControl::addToQueue(const NOMAD::EvalQueuePointPtr& evalQue
     // Thread-safety necessary here.
     // Ensure we will keep adding points until we ask to eval the queue, using run().
     // I.e. Ensure the queue is already locked.
-    if (omp_test_lock(&_evalQueueLock))
+    if (_evalQueueLock.test())
     {
         std::string err = "Error: trying to add an element to a queue that was not locked.";
         // Unlock queue before throwing exception.
         // If we are in this section, it means that the queue was locked by
         // the call to omp_test_lock().
-        omp_unset_lock(&_evalQueueLock);
+        _evalQueueLock.unset();
         throw NOMAD::Exception(__FILE__, __LINE__, err);
     }
 #endif // _OPENMP
@@ -958,15 +996,63 @@ bool NOMAD::EvaluatorControl::popBlockForMainThread(NOMAD::BlockForEval &block,
     // Otherwise, we could have 2 threads getting half-filled blocks instead
     // of one thread with a full block and one with no blocks.
 #ifdef _OPENMP
-    omp_set_lock(&_evalQueueLock);
+    _evalQueueLock.set();
 #endif // _OPENMP
+    const size_t queueDepth = _evalPointQueue.size();
+
+    // Adapt the size of the block to the measured blackbox evaluation times.
+    if (NOMAD::EvalType::BB == evaluator->getEvalType() && _bbAdaptiveBlockSize->getValue())
+    {
+        {
+            NOMAD_CRITICAL(blockSizeAdapter);
+            blockSize = _blockSizeAdapter.computeBlockSize(_evalPointQueue.size(),
+                                                           static_cast<size_t>(_nbThreadsForParallelEval->getValue()),
+                                                           blockSize);
+        }
+    }
+
+    // Pack the blocks so that the evaluation threads have the same load.
+    // With the longest evaluations first, the block is filled up to the
+    // predicted time of the queue divided by the number of threads.
+    double blockTime = 0.0, targetBlockTime = NOMAD::INF;
+    const bool packBlock = (NOMAD::EvalType::BB == evaluator->getEvalType() && _evalCostAwareDispatch->getValue() && blockSize > 1);
+    if (packBlock)
+    {
+        std::vector<double> predictedTimes;
+        {
+            NOMAD_CRITICAL(evalTimeModel);
+            predictedTimes = _evalTimeModel.predict(_evalPointQueue);
+        }
+        double queueTime = 0.0;
+        for (size_t i = 0; i < _evalPointQueue.size(); i++)
+        {
+            if (_evalPointQueue[i]->getThreadAlgo() == mainThreadNum && predictedTimes[i] >= 0)
+            {
+                queueTime += predictedTimes[i];
+            }
+        }
+        if (queueTime > 0)
+        {
+            targetBlockTime = queueTime / std::max(1, _nbThreadsForParallelEval->getValue());
+        }
+    }
 
-    while (_evalPointQueue.size() > 0 && block.size() < blockSize && popWorks)
+    while (_evalPointQueue.size() > 0 && block.size() < blockSize && blockTime < targetBlockTime && popWorks)
     {
         NOMAD::EvalQueuePointPtr evalQueuePoint;
         popWorks = popEvalPointForMainThread(evalQueuePoint, mainThreadNum);
         if (popWorks)
         {
+            if (packBlock && targetBlockTime < NOMAD::INF)
+            {
+                double predictedTime = 0.0;
+                {
+                    NOMAD_CRITICAL(evalTimeModel);
+                    predictedTime = _evalTimeModel.predict(*evalQueuePoint->getX());
+                }
+                blockTime += std::max(0.0, predictedTime);
+            }
+
             // Safeguard.
             if (evaluator->getEvalType() != evalQueuePoint->getEvalType())
             {
@@ -978,8 +1064,12 @@ bool NOMAD::EvaluatorControl::popBlockForMainThread(NOMAD::BlockForEval &block,
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_evalQueueLock);
+    _evalQueueLock.unset();
 #endif
+    if (success)
+    {
+        _evalTelemetry.addQueueDepth(evaluator->getEvalType(), mainThreadNum, queueDepth);
+    }
 
     return success;
 }
@@ -1023,9 +1113,19 @@ void NOMAD::EvaluatorControl::sort(std::vector<EvalQueuePointPtr> & evalPointsPt
     }
     else if (NOMAD::EvalSortType::SURROGATE == evalSortType)
     {
-        // Consider all SURROGATE evaluations are already done.
-        NOMAD::FHComputeType completeComputeType = {NOMAD::EvalType::SURROGATE, computeTypeS};
-        compMethod = std::make_shared<NOMAD::OrderByEval>(completeComputeType);
+        if (useSurrogatePipeline(mainThreadNum))
+        {
+            // SURROGATE evaluations are done during the BB evaluations, see run().
+            // Meanwhile, order by direction.
+            NOMAD::FHComputeType completeComputeType = {evalType, computeTypeS};
+            compMethod = makeCompMethodOrderByDirection(completeComputeType);
+        }
+        else
+        {
+            // Consider all SURROGATE evaluations are already done.
+            NOMAD::FHComputeType completeComputeType = {NOMAD::EvalType::SURROGATE, computeTypeS};
+            compMethod = std::make_shared<NOMAD::OrderByEval>(completeComputeType);
+        }
     }
     // For now, consider only quadratic_model, can be generalized
     else if (NOMAD::EvalSortType::QUADRATIC_MODEL == evalSortType)
@@ -1103,6 +1203,44 @@ void NOMAD::EvaluatorControl::sort(std::vector<EvalQueuePointPtr> & evalPointsPt
         }
         OUTPUT_DEBUG_END
     }
+
+    // All points are evaluated in non-opportunistic context: the order of
+    // evaluation only changes the elapsed time. Dispatch the longest
+    // evaluations first, so that the shortest ones fill the idle threads at
+    // the end. As the queue is popped from the end, longest are put last.
+    if (   NOMAD::EvalType::BB == evalType
+        && _evalCostAwareDispatch->getValue()
+        && !getOpportunisticEval(mainThreadNum))
+    {
+        std::vector<double> predictedTimes;
+        {
+            NOMAD_CRITICAL(evalTimeModel);
+            predictedTimes = _evalTimeModel.predict(evalPointsPtrToSort);
+        }
+
+        std::vector<std::pair<double, NOMAD::EvalQueuePointPtr>> timedPoints;
+        for (size_t i = 0; i < evalPointsPtrToSort.size(); i++)
+        {
+            timedPoints.push_back(std::make_pair(predictedTimes[i], std::move(evalPointsPtrToSort[i])));
+        }
+        std::stable_sort(timedPoints.begin(), timedPoints.end(),
+                         [](const std::pair<double, NOMAD::EvalQueuePointPtr>& p1,
+                            const std::pair<double, NOMAD::EvalQueuePointPtr>& p2)
+                         { return p1.first < p2.first; });
+        for (size_t i = 0; i < timedPoints.size(); i++)
+        {
+            evalPointsPtrToSort[i] = std::move(timedPoints[i].second);
+        }
+
+        OUTPUT_DEBUG_START
+        if (!timedPoints.empty() && timedPoints.back().first >= 0)
+        {
+            std::string s = "Evaluation points sorted by predicted evaluation time. Longest: ";
+            s += std::to_string(timedPoints.back().first) + " s.";
+            NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_DEBUG);
+        }
+        OUTPUT_DEBUG_END
+    }
 }
 
 
@@ -1154,7 +1292,7 @@ size_t NOMAD::EvaluatorControl::clearQueue(const int mainThreadNum, const bool s
     size_t nbPointsErased = 0;
 
 #ifdef _OPENMP
-    omp_set_lock(&_evalQueueLock);
+    _evalQueueLock.set();
 #endif // _OPENMP
 
     if (-1 == mainThreadNum)
@@ -1200,7 +1338,7 @@ size_t NOMAD::EvaluatorControl::clearQueue(const int mainThreadNum, const bool s
     }
 
 #ifdef _OPENMP
-    omp_unset_lock(&_evalQueueLock);
+    _evalQueueLock.unset();
 #endif // _OPENMP
 
     return nbPointsErased;
@@ -1229,6 +1367,10 @@ NOMAD::SuccessType NOMAD::EvaluatorControl::run()
         throw NOMAD::Exception(__FILE__, __LINE__, err);
     }
 
+    // The time of this main thread outside of its own evaluations, including
+    // the wait for the other evaluation threads, is accounted here.
+    NOMAD::OverheadScope overheadScope("Evaluator control");
+
     // Initialize success type for evaluation
     setSuccessType(mainThreadNum, NOMAD::SuccessType::UNSUCCESSFUL);
 
@@ -1301,7 +1443,7 @@ NOMAD::SuccessType NOMAD::EvaluatorControl::run()
     OUTPUT_DEBUG_END
 
     // On main thread, queue runs until stopMainEval() is true.
-    bool conditionForStop = false;
+    std::atomic<bool> conditionForStop(false);
 
     // Get the blocks ready.
     // The block contains eval point from the mainThread and the same evaluator.
@@ -1317,6 +1459,15 @@ NOMAD::SuccessType NOMAD::EvaluatorControl::run()
         }
     }
 
+    if (_evalQueueCheckpoint.isEnabled())
+    {
+        for (const auto& block : allBlocks)
+        {
+            _evalQueueCheckpoint.addPendingPoints(block);
+        }
+        writeCheckpoint();
+    }
+
     OUTPUT_DEBUG_START
     std::string s = "After blocks generation: ";
     s += NOMAD::itos(allBlocks.size()) + " blocks";
@@ -1328,88 +1479,162 @@ NOMAD::SuccessType NOMAD::EvaluatorControl::run()
     NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_DEBUG);
     OUTPUT_DEBUG_END
 
-    int k=0;
+    // The blocks are pulled by the evaluation threads as they become free.
+    // A thread with no more blocks steals the blocks waiting for another thread.
+#ifdef _OPENMP
+    const size_t t = _nbThreadsForParallelEval->getValue();
+#else
+    const size_t t = 1;
+#endif // _OPENMP
+    // With DETERMINISTIC_PARALLEL, the blocks are pulled in order from a single
+    // deque, and their results are committed in the same order.
+    NOMAD::BlockCommitOrder commitOrder;
+    NOMAD::BlockCommitOrder* commitOrderPtr = _deterministicParallel->getValue() ? &commitOrder : nullptr;
+    NOMAD::WorkStealingQueue blockQueue(allBlocks.size(), (nullptr != commitOrderPtr) ? 1 : t);
+    std::atomic<size_t> nbBlocksRunning(0);
+
+    // With NB_THREADS_SURROGATE_EVAL, more threads evaluate the blocks with the static
+    // surrogate. The blackbox threads pull the best block ranked by the surrogate so far.
+    bool surrogatePipeline = useSurrogatePipeline(mainThreadNum);
+    const size_t nbSurrogateThreads = surrogatePipeline ? _nbThreadsSurrogateEval->getValue() : 0;
+    size_t nbBBThreads = t;
+    NOMAD::OrderByEval orderBySurrogate({NOMAD::EvalType::SURROGATE, getFHComputeTypeS(mainThreadNum)});
+    std::vector<NOMAD::EvalQueuePointPtr> bestScreenedPoints(allBlocks.size(), nullptr);
+    NOMAD::SurrogatePipeline pipeline(surrogatePipeline ? allBlocks.size() : 0,
+                                      [&bestScreenedPoints, &orderBySurrogate](size_t k1, size_t k2)
+    {
+        // A block without surrogate evaluation has the lowest priority.
+        NOMAD::EvalQueuePointPtr point1 = bestScreenedPoints[k1], point2 = bestScreenedPoints[k2];
+        if (nullptr == point1 || nullptr == point2)
+        {
+            return (nullptr == point1 && nullptr != point2);
+        }
+        return orderBySurrogate.comp(point1, point2);
+    });
+
     // conditionForStop is true if we are in a main thread and stopMainEval() returns true.
     // conditionForStop is true in any thread if reachedMaxEval() returns true; otherwise, it is always false.
+    // Once true, the threads stop pulling blocks.
 #ifdef _OPENMP
-    const size_t t = _nbThreadsForParallelEval->getValue();
-#pragma omp parallel for num_threads(t) default(none) shared(conditionForStop,mainThreadNum,allBlocks) private(k) schedule(static,1)
+#pragma omp parallel num_threads(t + nbSurrogateThreads) default(none) shared(conditionForStop,mainThreadNum,allBlocks,blockQueue,nbBlocksRunning,commitOrderPtr,surrogatePipeline,nbBBThreads,pipeline,bestScreenedPoints,orderBySurrogate)
 #endif
-    for (k=0 ; k < allBlocks.size(); k++)
     {
-        // Check for stop conditions
-        conditionForStop = conditionForStop || stopMainEval(mainThreadNum, true /*true: display info if stop*/ );
+    size_t k = 0;
+    // The threads after the blackbox threads evaluate the static surrogate.
+    const bool surrogateThread = surrogatePipeline && static_cast<size_t>(NOMAD::getThreadNum()) >= nbBBThreads;
+    if (surrogateThread)
+    {
+        const NOMAD::Evaluator* surrogateEvaluator = getMainThreadInfo(mainThreadNum).findEvaluator(NOMAD::EvalType::SURROGATE);
+        while (!conditionForStop && pipeline.popToScreen(k))
+        {
+            bestScreenedPoints[k] = screenBlock(allBlocks[k], *surrogateEvaluator, orderBySurrogate);
+            pipeline.pushScreened(k);
+        }
+    }
 
-        // If we reached max eval, we also stop (valid for all threads).
-        conditionForStop = conditionForStop || reachedMaxEval();
+    while (   !surrogateThread
+           && !conditionForStop
+           && (surrogatePipeline ? pipeline.popBest(k, conditionForStop)
+                                 : blockQueue.pop((nullptr != commitOrderPtr) ? 0 : NOMAD::getThreadNum(), k)))
+    {
+        nbBlocksRunning++;
 
-        if (conditionForStop)
+        // Check for stop conditions.
+        // If we reached max eval, we also stop (valid for all threads).
+        if (   stopMainEval(mainThreadNum, true /*true: display info if stop*/ )
+            || reachedMaxEval())
         {
-#ifdef _OPENMP
-#pragma omp flush (conditionForStop)
-#else
-            break; // Can only break when no omp parallel for.
-#endif
+            conditionForStop = true;
+            if (nullptr != commitOrderPtr)
+            {
+                // The blocks pulled after this one wait for their turn.
+                commitOrderPtr->waitTurn(k);
+                commitOrderPtr->endTurn(k);
+            }
         }
         else
         {
+            if (_evalQueueCheckpoint.isEnabled())
+            {
+                _evalQueueCheckpoint.setInProgress(allBlocks[k]);
+            }
 
-            bool evalBlockOk = evalBlock(allBlocks[k]);
+            bool evalBlockOk = evalBlock(allBlocks[k], commitOrderPtr, k);
+
+            if (nullptr != commitOrderPtr && commitOrderPtr->isDiscarded())
+            {
+                // A previous block stopped the evaluations. The points are
+                // put back in the queue, as if they were not evaluated.
+                for (size_t i = 0; i < allBlocks[k].size(); i++)
+                {
+                    getMainThreadInfo(allBlocks[k][i]->getThreadAlgo()).decCurrentlyRunning();
+                }
+                conditionForStop = true;
+                commitOrderPtr->endTurn(k);
+                nbBlocksRunning--;
+                continue;
+            }
 
             // Update SuccessType
             // success is a member of EvcMainThreadInfo and so it can be shared between secondary threads.
-#ifdef _OPENMP
-#pragma omp critical(updateSuccessType)
-#endif // _OPENMP
+            // It is updated with a lock-free max-reduction, and the eval counters are atomic.
+            // Only the user callback, the stop reasons and the outputs are done in critical sections.
+            if (evalBlockOk)
             {
-                if (evalBlockOk)
+                for (auto it = allBlocks[k].begin(); it < allBlocks[k].end(); it++)
                 {
-                    for (auto it = allBlocks[k].begin(); it < allBlocks[k].end(); it++)
-                    {
-                        NOMAD::EvalQueuePointPtr evalQueuePoint = (*it);
-                        const int mainThreadNum = evalQueuePoint->getThreadAlgo();
-
-                        // User callback
-                        // Note: should be done before accessing success type as this may be modified in the callback (e.g. in DiscoMads)
-                        bool customOpportunisticEvalStop = false, customOpportunisticIterStop = false;
-                        runEvalCallback<NOMAD::CallbackType::EVAL_OPPORTUNISTIC_CHECK>(evalQueuePoint,customOpportunisticEvalStop,customOpportunisticIterStop);
+                    NOMAD::EvalQueuePointPtr evalQueuePoint = (*it);
+                    const int mainThreadNum = evalQueuePoint->getThreadAlgo();
 
-                        const NOMAD::SuccessType success = evalQueuePoint->getSuccess();
-
-                        // Update success type for return
-                        if (success > getSuccessType(mainThreadNum))
+                    // User callback
+                    // Note: should be done before accessing success type as this may be modified in the callback (e.g. in DiscoMads)
+                    bool customOpportunisticEvalStop = false, customOpportunisticIterStop = false;
+                    if (!_cbEvalOpportunisticCheckIsDefault)
+                    {
                         {
-                            setSuccessType(mainThreadNum, success);
+                            NOMAD_CRITICAL(evalOpportunisticCheck);
+                            runEvalCallback<NOMAD::CallbackType::EVAL_OPPORTUNISTIC_CHECK>(evalQueuePoint,customOpportunisticEvalStop,customOpportunisticIterStop);
                         }
+                    }
 
-                        if (   NOMAD::SuccessType::FULL_SUCCESS == success
-                            && evalTypeAsBB(evalQueuePoint->getEvalType(), mainThreadNum))
-                        {
-                            //PhaseOne full success
-                            if (evalQueuePoint->getGenByPhaseOne())
-                            {
-                                _nbPhaseOneSuccess++;
-                            }
+                    const NOMAD::SuccessType success = evalQueuePoint->getSuccess();
 
-                            if (!evalQueuePoint->getRelativeSuccess())
-                            {
-                                _indexBestInfeasEval = getBbEval();
-                            }
+                    // Update success type for return
+                    updateSuccessType(mainThreadNum, success);
 
+                    if (   NOMAD::SuccessType::FULL_SUCCESS == success
+                        && evalTypeAsBB(evalQueuePoint->getEvalType(), mainThreadNum))
+                    {
+                        //PhaseOne full success
+                        if (evalQueuePoint->getGenByPhaseOne())
+                        {
+                            _nbPhaseOneSuccess++;
                         }
-                        if (evalQueuePoint->getRelativeSuccess())
+
+                        if (!evalQueuePoint->getRelativeSuccess())
                         {
-                            _nbRelativeSuccess++;
-                            _indexSuccBlockEval = getBlockEval();
-                            _indexBestFeasEval = getBbEval();
+                            _indexBestInfeasEval = getBbEval();
                         }
 
-                        // Output in history (always) and solution (FULL_SUCCESS only)
-                        addDirectToFileInfo(evalQueuePoint);
+                    }
+                    if (evalQueuePoint->getRelativeSuccess())
+                    {
+                        _nbRelativeSuccess++;
+                        _indexSuccBlockEval = getBlockEval();
+                        _indexBestFeasEval = getBbEval();
+                    }
+
+                    // Opportunism on full success only (default opportunism only)
+                    // See below when a callback is added for checking custom opportunistic criterion
+                    const bool opportunisticSuccess = (!_customOpportunisticOnlyCheck && getOpportunisticEval(mainThreadNum) && getSuccessType(mainThreadNum) >= NOMAD::SuccessType::FULL_SUCCESS);
+                    if (!opportunisticSuccess && !customOpportunisticEvalStop && !customOpportunisticIterStop)
+                    {
+                        continue;
+                    }
 
-                        // Opportunism on full success only (default opportunism only)
-                        // See below when a callback is added for checking custom opportunistic criterion
-                        if (!_customOpportunisticOnlyCheck && getOpportunisticEval(mainThreadNum) && getSuccessType(mainThreadNum) >= NOMAD::SuccessType::FULL_SUCCESS)
+                    {
+                        NOMAD_CRITICAL(setEvalStopReason);
+                        if (opportunisticSuccess)
                         {
                             setStopReason(mainThreadNum, NOMAD::EvalMainThreadStopType::OPPORTUNISTIC_SUCCESS);
                         }
@@ -1432,38 +1657,65 @@ NOMAD::SuccessType NOMAD::EvaluatorControl::run()
                             setStopReason(mainThreadNum, NOMAD::EvalMainThreadStopType::CUSTOM_OPPORTUNISTIC_ITER_STOP);
                         }
                     }
-                }
-                else
-                {
-                    // EvalBlock not ok
-                    // Let's try to write block points into file
-                    for (auto it = allBlocks[k].begin(); it < allBlocks[k].end(); it++)
-                    {
-                        NOMAD::EvalQueuePointPtr evalQueuePoint = (*it);
-                        // Output in history (always)
-                        addDirectToFileInfo(evalQueuePoint);
 
+                    // The blocks of this main thread still evaluated by other
+                    // threads are not needed anymore. Free the threads.
+                    if (_opportunisticCancel->getValue())
+                    {
+                        cancelEvaluations(mainThreadNum);
                     }
                 }
+            }
+
+            {
+                NOMAD_CRITICAL(evalBlockOutput);
+                // Output in history (always) and solution (FULL_SUCCESS only)
+                for (auto it = allBlocks[k].begin(); it < allBlocks[k].end(); it++)
+                {
+                    addDirectToFileInfo(*it);
+                }
 
                 // Cannot modify _succesStats outside critical
                 addStatsInfo(allBlocks[k]);
+            }   // End critical(evalBlockOutput)
 
-                // Decrement main thread info counter separately as each eval point of a block
-                // maybe come from a different algo.
-                for (size_t i = 0; i < allBlocks[k].size(); i++)
-                {
-                    getMainThreadInfo(allBlocks[k][i]->getThreadAlgo()).decCurrentlyRunning();
-                }
+            // Decrement main thread info counter separately as each eval point of a block
+            // maybe come from a different algo.
+            for (size_t i = 0; i < allBlocks[k].size(); i++)
+            {
+                getMainThreadInfo(allBlocks[k][i]->getThreadAlgo()).decCurrentlyRunning();
+            }
 
-            }   // End critical(updateSuccessType)
+            if (_evalQueueCheckpoint.isEnabled())
+            {
+                _evalQueueCheckpoint.removePendingPoints(allBlocks[k]);
+                writeCheckpoint();
+            }
 
             // Clear the block.
             allBlocks[k].clear();
+
+            if (nullptr != commitOrderPtr)
+            {
+                commitOrderPtr->endTurn(k);
+            }
         }
 
+        nbBlocksRunning--;
     }
-    // End of for loop: Exit for this main thread.
+    // End of while loop: Exit for this main thread.
+
+#ifdef _OPENMP
+    // The threads with no more blocks may duplicate the stragglers.
+    if (_evalHedging.isEnabled() && !surrogateThread)
+    {
+        hedgeStragglers(mainThreadNum, nbBlocksRunning, conditionForStop);
+    }
+#endif // _OPENMP
+    }   // End of parallel region
+
+    _nbBlockSteals += blockQueue.getNbSteals();
+    _nbBlocksReprioritized += pipeline.getNbReordered();
 
 
     // Put back the unevaluated points into the queue.
@@ -1472,6 +1724,11 @@ NOMAD::SuccessType NOMAD::EvaluatorControl::run()
     // Let's do the reverse.
     for (size_t k=0; k < allBlocks.size(); k++)
     {
+        if (_evalQueueCheckpoint.isEnabled())
+        {
+            _evalQueueCheckpoint.removePendingPoints(allBlocks[k]);
+        }
+
         // Each point in the block is put back in the queue.
         for (auto itB = allBlocks[k].begin(); itB < allBlocks[k].end(); itB++)
         {
@@ -1482,11 +1739,11 @@ NOMAD::SuccessType NOMAD::EvaluatorControl::run()
             {
                 // Point was not evaluated. Put it back in the queue.
 #ifdef _OPENMP
-    omp_set_lock(&_evalQueueLock);
+    _evalQueueLock.set();
 #endif // _OPENMP
                 _evalPointQueue.push_back(*itB);
 #ifdef _OPENMP
-    omp_unset_lock(&_evalQueueLock);
+    _evalQueueLock.unset();
 #endif // _OPENMP
                 getMainThreadInfo(mainThreadNum).incNbPointsInQueue();
                 OUTPUT_DEBUG_START
@@ -1588,6 +1845,109 @@ void NOMAD::EvaluatorControl::stop()
 }
 
 
+void NOMAD::EvaluatorControl::cancelEvaluations(const int mainThreadNum)
+{
+    size_t nbCancelled = 0;
+    {
+        NOMAD_CRITICAL(evalCancelTokens);
+        for (const auto& token : _evalCancelTokens)
+        {
+            if (token->getMainThreadNum() == mainThreadNum && !token->isCancelled())
+            {
+                token->cancel();
+                nbCancelled++;
+            }
+        }
+    }
+
+    OUTPUT_DEBUG_START
+    std::string s = "Cancel " + std::to_string(nbCancelled) + " block evaluation(s) in progress for main thread " + std::to_string(mainThreadNum);
+    NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_DEBUG);
+    OUTPUT_DEBUG_END
+}
+
+
+void NOMAD::EvaluatorControl::start()
+{
+    NOMAD::EvalQueueCheckpoint::Counters counters;
+    std::vector<NOMAD::EvalQueueCheckpoint::MainThreadRecord> mainThreads;
+    if (!_evalQueueCheckpoint.read(counters, mainThreads))
+    {
+        return;
+    }
+
+    // The previous run stopped before its end. Continue its counts.
+    _bbEval = counters._bbEval;
+    _bbEvalNotOk = counters._bbEvalNotOk;
+    _feasBBEval = counters._feasBBEval;
+    _infBBEval = counters._infBBEval;
+    _surrogateEval = counters._surrogateEval;
+    _totalModelEval = counters._totalModelEval;
+    _blockEval = counters._blockEval;
+    _nbEvalSentToEvaluator = counters._nbEvalSentToEvaluator;
+
+    std::string s = "Restart from evaluation queue checkpoint " + _evalQueueCheckpoint.getFileName();
+    s += ": " + NOMAD::itos(counters._bbEval) + " blackbox evaluations done.";
+    NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_NORMAL);
+    for (const auto& mainThread : mainThreads)
+    {
+        s = "Main thread " + NOMAD::itos(mainThread._mainThreadNum) + ": ";
+        s += NOMAD::itos(mainThread._nbPointsInProgress) + " points in progress and ";
+        s += NOMAD::itos(mainThread._nbPointsInQueue) + " points in queue are evaluated again.";
+        NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_NORMAL);
+    }
+}
+
+
+void NOMAD::EvaluatorControl::writeCheckpoint()
+{
+    if (!_evalQueueCheckpoint.startWrite())
+    {
+        return;
+    }
+
+    std::vector<NOMAD::EvalQueueCheckpoint::PointRecord> queuedPoints;
+#ifdef _OPENMP
+    _evalQueueLock.set();
+#endif // _OPENMP
+    for (const auto& evalQueuePoint : _evalPointQueue)
+    {
+        queuedPoints.push_back({evalQueuePoint->getTag(),
+                                evalQueuePoint->getThreadAlgo(),
+                                false,
+                                *evalQueuePoint->getX()});
+    }
+#ifdef _OPENMP
+    _evalQueueLock.unset();
+#endif // _OPENMP
+
+    NOMAD::EvalQueueCheckpoint::Counters counters;
+    counters._bbEval = _bbEval;
+    counters._bbEvalNotOk = _bbEvalNotOk;
+    counters._feasBBEval = _feasBBEval;
+    counters._infBBEval = _infBBEval;
+    counters._surrogateEval = _surrogateEval;
+    counters._totalModelEval = _totalModelEval;
+    counters._blockEval = _blockEval;
+    counters._nbEvalSentToEvaluator = _nbEvalSentToEvaluator;
+
+    // Keep the completed evaluations. The cache file is written first: a
+    // point of the checkpoint that is in the cache is not evaluated again.
+    if (!NOMAD::CacheBase::getInstance()->getFileName().empty())
+    {
+        NOMAD::CacheBase::getInstance()->write();
+    }
+    _evalQueueCheckpoint.write(queuedPoints, counters);
+
+    OUTPUT_DEBUG_START
+    std::string s = "Evaluation queue checkpoint written: " + NOMAD::itos(queuedPoints.size()) + " points in queue.";
+    NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_DEBUG);
+    OUTPUT_DEBUG_END
+
+    _evalQueueCheckpoint.endWrite();
+}
+
+
 void NOMAD::EvaluatorControl::restart()
 {
     _allDoneWithEval = false;
@@ -1773,10 +2133,10 @@ bool NOMAD::EvaluatorControl::reachedMaxStepEval(const int mainThreadNum) const
 void NOMAD::EvaluatorControl::debugDisplayQueue() const
 {
 #ifdef _OPENMP
-    omp_set_lock(&_evalQueueLock);
-    #pragma omp critical(displayQueue)
+    _evalQueueLock.set();
 #endif // _OPENMP
     {
+        NOMAD_CRITICAL(displayQueue);
         std::cout << "Evaluation Queue" << (_evalPointQueue.empty() ? " is empty." : ":") << std::endl;
         for (const auto& eqp : _evalPointQueue)
         {
@@ -1784,7 +2144,7 @@ void NOMAD::EvaluatorControl::debugDisplayQueue() const
         }
     }
 #ifdef _OPENMP
-    omp_unset_lock(&_evalQueueLock);
+    _evalQueueLock.unset();
 #endif // _OPENMP
 }
 
@@ -1867,6 +2227,7 @@ void NOMAD::EvaluatorControl::addStatsInfo(const NOMAD::BlockForEval& block)
 
         // Evaluation info for output
         NOMAD::StatsInfoUPtr stats(new NOMAD::StatsInfo());
+        const auto& outputQueue = NOMAD::OutputQueue::getInstance();
 
         const int threadNum = NOMAD::getThreadNum();
 
@@ -1888,7 +2249,11 @@ void NOMAD::EvaluatorControl::addStatsInfo(const NOMAD::BlockForEval& block)
         stats->setSurrogateEval(_surrogateEval);
         stats->setBlkEva(_blockEval);
         stats->setBlkSize(block.size());
-        stats->setBBO(evalQueuePoint->getBBO(evalType));
+        // Members that are costly to copy are set only if they are displayed.
+        if (outputQueue->usesStatsType(NOMAD::DisplayStatsType::DS_BBO))
+        {
+            stats->setBBO(evalQueuePoint->getBBO(evalType));
+        }
         stats->setEval(getNbEval());
         stats->setNbRelativeSuccess(_nbRelativeSuccess);
         stats->setPhaseOneSuccess(_nbPhaseOneSuccess);
@@ -1896,27 +2261,55 @@ void NOMAD::EvaluatorControl::addStatsInfo(const NOMAD::BlockForEval& block)
         stats->setCacheSize(NOMAD::CacheBase::getInstance()->size());
         stats->setIterNum(evalQueuePoint->getK());
         stats->setTime(NOMAD::Clock::getTimeSinceStart());
+        stats->setOverhead(NOMAD::OverheadAccounting::getOverheadPerEval());
         if ( nullptr != evalQueuePoint->getMesh())
         {
-            stats->setMeshIndex(evalQueuePoint->getMesh()->getMeshIndex());
-            stats->setMeshSize(evalQueuePoint->getMesh()->getdeltaMeshSize());
-            stats->setFrameSize(evalQueuePoint->getMesh()->getDeltaFrameSize());
+            if (outputQueue->usesStatsType(NOMAD::DisplayStatsType::DS_MESH_INDEX))
+            {
+                stats->setMeshIndex(evalQueuePoint->getMesh()->getMeshIndex());
+            }
+            if (outputQueue->usesStatsType(NOMAD::DisplayStatsType::DS_MESH_SIZE)
+                || outputQueue->usesStatsType(NOMAD::DisplayStatsType::DS_DELTA_M))
+            {
+                stats->setMeshSize(evalQueuePoint->getMesh()->getdeltaMeshSize());
+            }
+            if (outputQueue->usesStatsType(NOMAD::DisplayStatsType::DS_FRAME_SIZE)
+                || outputQueue->usesStatsType(NOMAD::DisplayStatsType::DS_DELTA_F))
+            {
+                stats->setFrameSize(evalQueuePoint->getMesh()->getDeltaFrameSize());
+            }
+        }
+        if (outputQueue->usesStatsType(NOMAD::DisplayStatsType::DS_FRAME_CENTER))
+        {
+            auto frameCenter = evalQueuePoint->getPointFrom();
+            stats->setFrameCenter(frameCenter ? *frameCenter : NOMAD::Point(evalQueuePoint->size()));
+        }
+        if (outputQueue->usesStatsType(NOMAD::DisplayStatsType::DS_DIRECTION))
+        {
+            auto direction = evalQueuePoint->getDirection();
+            stats->setDirection(direction ? *direction : NOMAD::Direction(evalQueuePoint->size()));
+        }
+        if (outputQueue->usesStatsType(NOMAD::DisplayStatsType::DS_SOL))
+        {
+            stats->setSol(*(evalQueuePoint->getX()));
         }
-        auto frameCenter = evalQueuePoint->getPointFrom();
-        stats->setFrameCenter(frameCenter ? *frameCenter : NOMAD::Point(evalQueuePoint->size()));
-        auto direction = evalQueuePoint->getDirection();
-        stats->setDirection(direction ? *direction : NOMAD::Direction(evalQueuePoint->size()));
-        stats->setSol(*(evalQueuePoint->getX()));
         stats->setSuccessType(evalQueuePoint->getSuccess());
         stats->setThreadAlgo(mainThreadNum);
         stats->setThreadNum(threadNum);
         stats->setRelativeSuccess(evalQueuePoint->getRelativeSuccess());
         stats->setTag(evalQueuePoint->getTag());
         stats->setComment(evalQueuePoint->getComment());
-        stats->setGenStep(NOMAD::StepTypeListToString(evalQueuePoint->getGenSteps()));
+        if (outputQueue->usesStatsType(NOMAD::DisplayStatsType::DS_GEN_STEP))
+        {
+            stats->setGenStep(NOMAD::StepTypeListToString(evalQueuePoint->getGenSteps()));
+        }
 
-        std::string s = "Evaluated point: " + evalQueuePoint->displayAll(NOMAD::defaultFHComputeTypeS);
-        NOMAD::OutputInfo outputInfo("EvaluatorControl", s, NOMAD::OutputLevel::LEVEL_STATS);
+        // The point is formatted only if the message is displayed.
+        auto formatter = [evalQueuePoint]()
+        {
+            return "Evaluated point: " + evalQueuePoint->displayAll(NOMAD::defaultFHComputeTypeS);
+        };
+        NOMAD::OutputInfo outputInfo("EvaluatorControl", formatter, NOMAD::OutputLevel::LEVEL_STATS);
         outputInfo.setStatsInfo(std::move(stats));
         NOMAD::OutputQueue::Add(std::move(outputInfo));
 
@@ -1925,12 +2318,15 @@ void NOMAD::EvaluatorControl::addStatsInfo(const NOMAD::BlockForEval& block)
 }
 
 // Eval a block (vector) of EvalQueuePointPtr
-bool NOMAD::EvaluatorControl::evalBlock(NOMAD::BlockForEval& blockForEval)
+bool NOMAD::EvaluatorControl::evalBlock(NOMAD::BlockForEval& blockForEval,
+                                        NOMAD::BlockCommitOrder* commitOrder,
+                                        const size_t blockIndex)
 {
     if (blockForEval.empty())
     {
         return false;
     }
+    NOMAD::TraceScope traceScope("Evaluation of a block", "eval");
 
     // All EvalPoints in blockForEval have the same mainThreadNum, and are to be evaluated
     // with the same evaluator, using the same EvalType.
@@ -1944,6 +2340,16 @@ bool NOMAD::EvaluatorControl::evalBlock(NOMAD::BlockForEval& blockForEval)
 
     const NOMAD::Double hMax = getHMax(mainThreadNum);
 
+    // Time spent by the points in the evaluation queue.
+    const auto evalBlockStartTime = std::chrono::steady_clock::now();
+    std::vector<double> queueWaits;
+    for (const auto& evalQueuePoint : blockForEval)
+    {
+        const std::chrono::duration<double> queueWait = evalBlockStartTime - evalQueuePoint->getQueueTime();
+        queueWaits.push_back(queueWait.count());
+    }
+    _evalTelemetry.addQueueWaits(evalType, mainThreadNum, queueWaits);
+
     // Create a block of EvalPoints (Block) from the given block of EvalQueuePoints (BlockForEval),
     // to give to the Evaluator.
     // If a point is rejected by user we store it in a special block for processing.
@@ -2021,10 +2427,21 @@ bool NOMAD::EvaluatorControl::evalBlock(NOMAD::BlockForEval& blockForEval)
         if (block.size() != 0 )
         {
             getMainThreadInfo(mainThreadNum).incCurrentlyRunning(block.size());
-            evalOk = evalBlockOfPoints(block, *evaluator, hMax);
+            evalOk = evalBlockOfPoints(block, *evaluator, hMax, commitOrder, blockIndex);
         }
     }
 
+    // With DETERMINISTIC_PARALLEL, the turn of the block is taken in evalBlockOfPoints(),
+    // when it is called.
+    if (nullptr != commitOrder && block.empty())
+    {
+        beginBlockCommit(*commitOrder, blockIndex, mainThreadNum);
+    }
+    if (nullptr != commitOrder && commitOrder->isDiscarded())
+    {
+        return false;
+    }
+
     // User callback just after evaluation
     for (size_t i = 0; i < blockForEval.size(); i++)
     {
@@ -2192,10 +2609,8 @@ void NOMAD::EvaluatorControl::computeSuccess(const NOMAD::EvalQueuePointPtr& eva
         }
 
 
-#ifdef _OPENMP
-#pragma omp critical(updateBestIncumbent)
-#endif
         {
+            NOMAD_CRITICAL(updateBestIncumbent);
             if (evalTypeAsBB(evalType, mainThreadNum) && success >= NOMAD::SuccessType::PARTIAL_SUCCESS)
             {
 
@@ -2278,7 +2693,9 @@ bool NOMAD::EvaluatorControl::evalSinglePoint(NOMAD::EvalPoint &evalPoint,
 std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
                                     NOMAD::Block &block,
                                     const NOMAD::Evaluator& evaluator,
-                                    const NOMAD::Double &hMax)
+                                    const NOMAD::Double &hMax,
+                                    NOMAD::BlockCommitOrder* commitOrder,
+                                    const size_t blockIndex)
 {
     auto evalType = evaluator.getEvalType();
 
@@ -2306,13 +2723,56 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
     // Use "EvaluatorControl" as originator.
     NOMAD::OutputInfo evalInfo("EvaluatorControl", s_thread_info, NOMAD::OutputLevel::LEVEL_DEBUG);
 
+    // Token to stop the evaluation of the block on timeout or cancellation.
+    // Only blackbox and static surrogate evaluations may be stopped.
+    const size_t evalTimeout = evalTypeCounts(evalType) ? evaluator.getEvalTimeout() : NOMAD::INF_SIZE_T;
+    auto cancelToken = std::make_shared<NOMAD::EvalCancelToken>(evalTimeout, block[0]->getThreadAlgo());
+
+    // With BB_EVAL_STAGED, the evaluation of a point stops as soon as its
+    // first outputs show that it cannot be a success. With BB_EVAL_MULTI_FIDELITY,
+    // it stops when its intermediate estimates are dominated by the reference run.
+    NOMAD::StagedEvalRejectionPtr stagedEvalRejection = nullptr;
+    if (NOMAD::EvalType::BB == evalType && (evaluator.getEvalStaged() || evaluator.getEvalMultiFidelity()))
+    {
+        const int mainThreadNum = block[0]->getThreadAlgo();
+        const auto& computeTypeS = getFHComputeTypeS(mainThreadNum);
+        NOMAD::Double fIncumbent;
+        auto barrier = getBarrier(mainThreadNum);
+        if (nullptr != barrier && nullptr != barrier->getCurrentIncumbentFeas())
+        {
+            fIncumbent = barrier->getCurrentIncumbentFeas()->getF({evalType, computeTypeS});
+        }
+        stagedEvalRejection = std::make_shared<NOMAD::StagedEvalRejection>(evaluator.getBBOutputTypeList(),
+                                                                          evalType,
+                                                                          computeTypeS,
+                                                                          hMax,
+                                                                          fIncumbent);
+        if (evaluator.getEvalMultiFidelity())
+        {
+            NOMAD::EvalTrajectoryPtr refTrajectory;
+            {
+                NOMAD_CRITICAL(evalTrajectory);
+                refTrajectory = _refTrajectory;
+            }
+            stagedEvalRejection->setReferenceTrajectory(refTrajectory,
+                                                        evaluator.getEvalParams()->getAttributeValue<NOMAD::Double>("BB_EVAL_TRUNCATION_MARGIN"));
+        }
+    }
+
+    std::vector<bool> toEval(block.size(), false);
+    size_t nbPointsToEval = 0;
+    NOMAD::HedgedBlockPtr hedgedBlock = nullptr;
+    bool duplicateWon = false;
+    std::chrono::steady_clock::time_point evalStartWallTime;
+    std::chrono::duration<double> evalWallTime(0.0);
+
     // Evaluation of the block
     try
     {
         for (const auto& evalPoint : block)
         {
             if ( NOMAD::EvalStatusType::EVAL_USER_REJECTED != evalPoint->getEvalStatus(evalType) &&
-                !updateEvalStatusBeforeEval(*evalPoint) )
+                !updateEvalStatusBeforeEval(*evalPoint, evalType) )
             {
                 // evalPoint's evaluation is already in progress from another main thread.
                 // Set eval status to wait.
@@ -2331,21 +2791,73 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
         std::string startMsg = "Start evaluation of block of " + NOMAD::itos(block.size()) + " points.";
         evalInfo.addMsg(startMsg);
         OUTPUT_INFO_END
+
+        // Points actually evaluated, for the measure of evaluation times.
+        for (size_t index = 0; index < block.size(); index++)
+        {
+            toEval[index] = (NOMAD::EvalStatusType::EVAL_IN_PROGRESS == block[index]->getEvalStatus(evalType));
+        }
+        nbPointsToEval = std::count(toEval.begin(), toEval.end(), true);
+        evalStartWallTime = std::chrono::steady_clock::now();
+
+        // The block may be duplicated by an idle thread if it is a straggler.
+        if (NOMAD::EvalType::BB == evalType && _evalHedging.isEnabled() && nbPointsToEval > 0)
+        {
+            hedgedBlock = std::make_shared<NOMAD::HedgedBlock>(block, nbPointsToEval, cancelToken);
+            _evalHedging.addRunningBlock(hedgedBlock);
+        }
 #ifdef TIME_STATS
         double evalStartTime = NOMAD::Clock::getCPUTime();
 #endif // TIME_STATS
+        {
+            NOMAD_CRITICAL(evalCancelTokens);
+            _evalCancelTokens.push_back(cancelToken);
+        }
+        NOMAD::EvalCancelToken::setCurrent(cancelToken);
+        NOMAD::StagedEvalRejection::setCurrent(stagedEvalRejection);
+
         evalOk = evaluator.eval_block(block, hMax, countEval);
+
+        NOMAD::StagedEvalRejection::setCurrent(nullptr);
+        removeEvalCancelToken(cancelToken);
+        if (nullptr != stagedEvalRejection)
+        {
+            _nbEvalRejectedEarly += stagedEvalRejection->getNbRejected();
+        }
+        evalWallTime = std::chrono::steady_clock::now() - evalStartWallTime;
+        // Model evaluations are part of the time of the algorithm.
+        if (NOMAD::EvalType::BB == evalType || NOMAD::EvalType::SURROGATE == evalType)
+        {
+            NOMAD::OverheadAccounting::addEvalTime(evalWallTime.count(), nbPointsToEval);
+        }
+
+        if (nullptr != hedgedBlock)
+        {
+            _evalHedging.removeRunningBlock(hedgedBlock);
+            if (hedgedBlock->originalDone())
+            {
+                // The duplicate completed first. The original evaluation was cancelled.
+                hedgedBlock->adoptDuplicate(block, evalOk, countEval, evalType);
+                duplicateWon = true;
+            }
+        }
 #ifdef TIME_STATS
-#ifdef _OPENMP
-#pragma omp critical(computeEvalTime)
-#endif // _OPENMP
         {
+            NOMAD_CRITICAL(computeEvalTime);
             _evalTime += NOMAD::Clock::getCPUTime() - evalStartTime;
         }
 #endif // TIME_STATS
     }
     catch (std::exception &e)
     {
+        NOMAD::StagedEvalRejection::setCurrent(nullptr);
+        removeEvalCancelToken(cancelToken);
+        if (nullptr != hedgedBlock)
+        {
+            _evalHedging.removeRunningBlock(hedgedBlock);
+            hedgedBlock->originalDone();
+        }
+
         std::string err("EvaluatorControl: Eval Block of Points: eval_x returned an exception: ");
         err += e.what();
         err += " \n Blackbox evaluation maybe the cause of this exception. Raw bb outputs obtained: \"";
@@ -2357,6 +2869,90 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
         throw NOMAD::Exception(__FILE__, __LINE__, err);
     }
 
+    // With DETERMINISTIC_PARALLEL, the results are committed in the order of the blocks.
+    bool discarded = false;
+    if (nullptr != commitOrder)
+    {
+        discarded = beginBlockCommit(*commitOrder, blockIndex, block[0]->getThreadAlgo());
+    }
+
+    // Evaluations stopped in a user eval_x or eval_block (library mode).
+    // When BB_EXE is used, the Evaluator already set the status.
+    const NOMAD::EvalStatusType stopEvalStatus = duplicateWon ? NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED
+                                                              : cancelToken->getStopEvalStatus();
+    if (discarded)
+    {
+        // A single evaluation thread would not have evaluated this block.
+        // The evaluations are cancelled: they are not counted, and the
+        // points may be evaluated again.
+        for (size_t index = 0; index < block.size(); index++)
+        {
+            const NOMAD::EvalStatusType evalStatus = block[index]->getEvalStatus(evalType);
+            if (   NOMAD::EvalStatusType::EVAL_WAIT != evalStatus
+                && NOMAD::EvalStatusType::EVAL_USER_REJECTED != evalStatus)
+            {
+                block[index]->setEvalStatus(NOMAD::EvalStatusType::EVAL_CANCELLED, evalType);
+                evalOk[index] = false;
+                countEval[index] = false;
+            }
+        }
+    }
+    else if (NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED != stopEvalStatus)
+    {
+        for (size_t index = 0; index < block.size(); index++)
+        {
+            const NOMAD::EvalStatusType evalStatus = block[index]->getEvalStatus(evalType);
+            if (!evalOk[index]
+                && (   NOMAD::EvalStatusType::EVAL_IN_PROGRESS == evalStatus
+                    || NOMAD::EvalStatusType::EVAL_FAILED == evalStatus
+                    || NOMAD::EvalStatusType::EVAL_ERROR == evalStatus))
+            {
+                block[index]->setEvalStatus(stopEvalStatus, evalType);
+                if (NOMAD::EvalStatusType::EVAL_CANCELLED == stopEvalStatus)
+                {
+                    countEval[index] = false;
+                }
+            }
+        }
+    }
+    else if (nbPointsToEval > 0)
+    {
+        // Stopped evaluations do not give the time of a block.
+        _evalTelemetry.addBlock(evalType, block[0]->getThreadAlgo(), nbPointsToEval, evalWallTime.count());
+        _evalTelemetry.writeMetrics();
+
+        if (NOMAD::EvalType::BB == evalType && _bbAdaptiveBlockSize->getValue())
+        {
+            {
+                NOMAD_CRITICAL(blockSizeAdapter);
+                _blockSizeAdapter.addMeasure(nbPointsToEval, evalWallTime.count());
+            }
+        }
+
+        // The time of each point is not known inside a block.
+        const double wallTimePerPoint = evalWallTime.count() / static_cast<double>(nbPointsToEval);
+        if (nullptr != hedgedBlock && !duplicateWon)
+        {
+            _evalHedging.addLatency(wallTimePerPoint);
+        }
+        for (size_t index = 0; index < block.size(); index++)
+        {
+            NOMAD::Eval* eval = block[index]->getEval(evalType);
+            if (!toEval[index] || nullptr == eval)
+            {
+                continue;
+            }
+            eval->setWallTime(wallTimePerPoint);
+            if (NOMAD::EvalType::BB == evalType && _evalCostAwareDispatch->getValue())
+            {
+                {
+                    NOMAD_CRITICAL(evalTimeModel);
+                    _evalTimeModel.addEvalTime(*block[index]->getX(), wallTimePerPoint);
+                }
+            }
+        }
+    }
+
 
     for (size_t index = 0; index < block.size(); index++)
     {
@@ -2392,6 +2988,13 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
                 }
             }
 
+            // A truncated evaluation has low fidelity outputs: it is not ok (library mode).
+            const bool evalTruncated = (NOMAD::EvalStatusType::EVAL_TRUNCATED == evalPoint->getEvalStatus(evalType));
+            if (evalTruncated)
+            {
+                evalOk[index] = false;
+            }
+
             // Start by setting EVAL_OK if evalOk is true. The eval status might be modified later.
             if (evalOk[index])
             {
@@ -2404,6 +3007,10 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
                 evalOk[index] = checkIfEvalOk(evaluator, evalPoint, &evalInfo);
             }
 
+            // Timed out and cancelled evaluations are not failures. The point may be evaluated again.
+            const bool evalStopped = (   NOMAD::EvalStatusType::EVAL_TIMEOUT == evalPoint->getEvalStatus(evalType)
+                                      || NOMAD::EvalStatusType::EVAL_CANCELLED == evalPoint->getEvalStatus(evalType));
+
             // Update all counters
             // Note: _bbEval, and EvcMainThreadInfo members _lapBbEval, _modelEval, _subBbEval, are atomic.
             if (NOMAD::EvalType::MODEL == evalType)
@@ -2413,20 +3020,59 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
             }
             else if (NOMAD::EvalType::BB == evalType)
             {
-                getMainThreadInfo(mainThreadNum).incBbEvalInSubproblem(1);
-                getMainThreadInfo(mainThreadNum).incLapBbEval(1);
+                if (NOMAD::EvalStatusType::EVAL_CANCELLED != evalPoint->getEvalStatus(evalType))
+                {
+                    getMainThreadInfo(mainThreadNum).incBbEvalInSubproblem(1);
+                    getMainThreadInfo(mainThreadNum).incLapBbEval(1);
+                }
                 _bbEval += (countEval[index]);
                 if (evalOk[index])
                 {
                     (evalPoint->isFeasible(completeComputeType)) ?  _feasBBEval++ : _infBBEval++;
                 }
-                else
+                else if (evalTruncated)
+                {
+                    _nbEvalTruncated++;
+                }
+                else if (!evalStopped)
                 {
                     _bbEvalNotOk++;
                 }
-                // All bb evals count for _nbEvalSentToEvaluator.
-                _nbEvalSentToEvaluator++;
-                evalPoint->incNumberBBEval();
+                else if (NOMAD::EvalStatusType::EVAL_CANCELLED == evalPoint->getEvalStatus(evalType)
+                         && _opportunisticCancel->getValue())
+                {
+                    _nbEvalCancelled++;
+                }
+
+                // The best feasible evaluation with intermediate estimates
+                // is the reference to truncate the next evaluations.
+                if (   nullptr != stagedEvalRejection
+                    && evalOk[index]
+                    && evalPoint->isFeasible(completeComputeType))
+                {
+                    auto trajectory = stagedEvalRejection->getTrajectory(evalPoint->getTag());
+                    const NOMAD::Double f = evalPoint->getF(completeComputeType);
+                    if (nullptr != trajectory && f.isDefined())
+                    {
+                        {
+                            NOMAD_CRITICAL(evalTrajectory);
+                            if (!_refTrajectoryF.isDefined() || f < _refTrajectoryF)
+                            {
+                                _refTrajectory = trajectory;
+                                _refTrajectoryF = f;
+                            }
+                        }
+                    }
+                }
+                // All bb evals count for _nbEvalSentToEvaluator, except the discarded ones.
+                if (!discarded)
+                {
+                    _nbEvalSentToEvaluator++;
+                }
+                if (!evalStopped)
+                {
+                    evalPoint->incNumberBBEval();
+                }
                 NOMAD::OutputQueue::getInstance()->setTotalEval(_nbEvalSentToEvaluator);
             }
             else if (NOMAD::EvalType::SURROGATE == evalType)
@@ -2435,9 +3081,9 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
                 size_t surrogateCost = _evalContGlobalParams->getAttributeValue<size_t>("EVAL_SURROGATE_COST");
                 if (countEval[index])
                 {
-                    _surrogateEval++;
                     // When surrogateCost surrogate evaluations have been done, increment _bbEval and _nbEvalSentToEvaluator.
-                    if (0 == _surrogateEval % surrogateCost)
+                    // Use the incremented value: _surrogateEval may be incremented meanwhile by another thread.
+                    if (0 == ++_surrogateEval % surrogateCost)
                     {
                         _bbEval++;
                         _nbEvalSentToEvaluator++;
@@ -2448,10 +3094,14 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
 
         // Update eval status if needed.
         // Point with EVAL_WAIT status are handled in this function
-        updateEvalStatusAfterEval(*evalPoint, evalOk.begin() + index);
+        updateEvalStatusAfterEval(*evalPoint, evalOk.begin() + index, evalType);
 
         // User callback for fail evaluation (only for BB).
-        if (!evalOk[index] && NOMAD::EvalType::BB == evalType)
+        // Timed out, cancelled and truncated evaluations are not failures.
+        if (!evalOk[index] && NOMAD::EvalType::BB == evalType
+            && NOMAD::EvalStatusType::EVAL_TIMEOUT != evalPoint->getEvalStatus(evalType)
+            && NOMAD::EvalStatusType::EVAL_CANCELLED != evalPoint->getEvalStatus(evalType)
+            && NOMAD::EvalStatusType::EVAL_TRUNCATED != evalPoint->getEvalStatus(evalType))
         {
             if(NOMAD::EvaluatorControl::_cbFailEvalCheckIsDefault!=true)
             {
@@ -2476,7 +3126,7 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
         }
 
         // User callback for global stop
-        if (NOMAD::EvalType::BB == evalType)
+        if (NOMAD::EvalType::BB == evalType && !discarded)
         {
             bool globalStop=false;
             runEvalCallback<NOMAD::CallbackType::EVAL_STOP_CHECK>(evalQueuePoint, globalStop);
@@ -2509,7 +3159,7 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
         }
     }
 
-    if (evalTypeCounts(evalType))
+    if (evalTypeCounts(evalType) && !discarded)
     {
         // One more block evaluated (count only blocks of BB or SURROGATE evaluations).
         _blockEval++;
@@ -2522,6 +3172,155 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
     return evalOk;
 }
 
+bool NOMAD::EvaluatorControl::beginBlockCommit(NOMAD::BlockCommitOrder& commitOrder,
+                                               const size_t blockIndex,
+                                               const int mainThreadNum)
+{
+    commitOrder.waitTurn(blockIndex);
+
+    // Same check as before the evaluation of a block with a single evaluation thread.
+    // The previous blocks are committed.
+    const bool discarded = stopMainEval(mainThreadNum, false) || reachedMaxEval();
+    commitOrder.setDiscarded(discarded);
+
+    OUTPUT_DEBUG_START
+    if (discarded)
+    {
+        std::string s = "Evaluations stopped by a previous block: results of block " + NOMAD::itos(blockIndex) + " are discarded.";
+        NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_DEBUG);
+    }
+    OUTPUT_DEBUG_END
+
+    return discarded;
+}
+
+
+NOMAD::EvalQueuePointPtr NOMAD::EvaluatorControl::screenBlock(NOMAD::BlockForEval& blockForEval,
+                                                            const NOMAD::Evaluator& surrogateEvaluator,
+                                                            const NOMAD::OrderByEval& orderBySurrogate)
+{
+    // The points already evaluated with the surrogate (for instance, from cache) are not evaluated again.
+    NOMAD::Block block;
+    for (const auto& evalQueuePoint : blockForEval)
+    {
+        if (nullptr == evalQueuePoint->getEval(NOMAD::EvalType::SURROGATE))
+        {
+            block.push_back(evalQueuePoint);
+        }
+    }
+
+    if (!block.empty())
+    {
+        const int mainThreadNum = blockForEval[0]->getThreadAlgo();
+        evalBlockOfPoints(block, surrogateEvaluator, getHMax(mainThreadNum));
+    }
+
+    NOMAD::EvalQueuePointPtr bestPoint = nullptr;
+    for (auto evalQueuePoint : blockForEval)
+    {
+        if (nullptr == evalQueuePoint->getEval(NOMAD::EvalType::SURROGATE))
+        {
+            continue;
+        }
+        if (nullptr == bestPoint || orderBySurrogate.comp(bestPoint, evalQueuePoint))
+        {
+            bestPoint = evalQueuePoint;
+        }
+    }
+
+    return bestPoint;
+}
+
+
+void NOMAD::EvaluatorControl::hedgeStragglers(const int mainThreadNum,
+                                              const std::atomic<size_t>& nbBlocksRunning,
+                                              const std::atomic<bool>& conditionForStop)
+{
+    const NOMAD::Evaluator* evaluator = getMainThreadInfo(mainThreadNum).getCurrentEvaluator();
+    if (nullptr == evaluator || NOMAD::EvalType::BB != evaluator->getEvalType())
+    {
+        return;
+    }
+
+    while (nbBlocksRunning > 0 && !conditionForStop)
+    {
+        auto duplicateToken = std::make_shared<NOMAD::EvalCancelToken>(evaluator->getEvalTimeout(), mainThreadNum);
+        auto straggler = _evalHedging.startDuplicateOfStraggler(mainThreadNum, duplicateToken);
+        if (nullptr == straggler)
+        {
+            usleep(10000);
+            continue;
+        }
+        evalDuplicate(straggler, duplicateToken);
+    }
+}
+
+
+void NOMAD::EvaluatorControl::evalDuplicate(const NOMAD::HedgedBlockPtr& hedgedBlock,
+                                            const NOMAD::EvalCancelTokenPtr& duplicateToken)
+{
+    const int mainThreadNum = hedgedBlock->getMainThreadNum();
+    const NOMAD::Evaluator* evaluator = getMainThreadInfo(mainThreadNum).getCurrentEvaluator();
+    const NOMAD::Double hMax = getHMax(mainThreadNum);
+    NOMAD::Block& block = hedgedBlock->getDuplicateBlock();
+
+    OUTPUT_INFO_START
+    std::string s = "Straggler block of " + NOMAD::itos(block.size()) + " points: start a duplicate evaluation.";
+    NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_INFO);
+    OUTPUT_INFO_END
+
+    // The duplicate may be cancelled like the original evaluation.
+    {
+        NOMAD_CRITICAL(evalCancelTokens);
+        _evalCancelTokens.push_back(duplicateToken);
+    }
+    NOMAD::EvalCancelToken::setCurrent(duplicateToken);
+
+    std::vector<bool> evalOk;
+    std::vector<bool> countEval(block.size(), false);
+    bool completed = true;
+    const auto evalStartWallTime = std::chrono::steady_clock::now();
+    try
+    {
+        evalOk = evaluator->eval_block(block, hMax, countEval);
+    }
+    catch (std::exception &e)
+    {
+        // The original evaluation goes on.
+        completed = false;
+    }
+    removeEvalCancelToken(duplicateToken);
+    // The points are counted by the original evaluation.
+    const std::chrono::duration<double> evalWallTime = std::chrono::steady_clock::now() - evalStartWallTime;
+    NOMAD::OverheadAccounting::addEvalTime(evalWallTime.count(), 0);
+
+    // The results are used by the thread of the original evaluation.
+    if (   completed
+        && NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED == duplicateToken->getStopEvalStatus()
+        && hedgedBlock->duplicateDone(evalOk, countEval))
+    {
+        _evalHedging.incNbDuplicateWins();
+        OUTPUT_INFO_START
+        NOMAD::OutputQueue::Add("Duplicate evaluation completed first.", NOMAD::OutputLevel::LEVEL_INFO);
+        OUTPUT_INFO_END
+    }
+}
+
+
+void NOMAD::EvaluatorControl::removeEvalCancelToken(const NOMAD::EvalCancelTokenPtr& cancelToken)
+{
+    NOMAD::EvalCancelToken::setCurrent(nullptr);
+    {
+        NOMAD_CRITICAL(evalCancelTokens);
+        auto it = std::find(_evalCancelTokens.begin(), _evalCancelTokens.end(), cancelToken);
+        if (it != _evalCancelTokens.end())
+        {
+            _evalCancelTokens.erase(it);
+        }
+    }
+}
+
+
 bool NOMAD::EvaluatorControl::checkIfEvalOk(const NOMAD::Evaluator& evaluator, const NOMAD::EvalPointPtr& evalPoint,NOMAD::OutputInfo * evalInfo) const
 {
     bool isEvalOk = true;
@@ -2574,7 +3373,8 @@ bool NOMAD::EvaluatorControl::checkIfEvalOk(const NOMAD::Evaluator& evaluator, c
 
 }
 
-bool NOMAD::EvaluatorControl::updateEvalStatusBeforeEval(NOMAD::EvalPoint &evalPoint) const
+bool NOMAD::EvaluatorControl::updateEvalStatusBeforeEval(NOMAD::EvalPoint &evalPoint,
+                                                         NOMAD::EvalType evalType) const
 {
     bool goodForEval = true;
     std::string err;
@@ -2595,12 +3395,12 @@ bool NOMAD::EvaluatorControl::updateEvalStatusBeforeEval(NOMAD::EvalPoint &evalP
         foundEvalPoint = evalPoint;
     }
 
-    NOMAD::EvalType evalType = getCurrentEvalType(mainThreadNum);
     NOMAD::EvalStatusType evalStatus = foundEvalPoint.getEvalStatus(evalType);
     NOMAD::EvalStatusType preEvalStatus = foundEvalPoint.getPreEvalStatus(evalType);
     if (evalStatus == NOMAD::EvalStatusType::EVAL_FAILED
         || evalStatus == NOMAD::EvalStatusType::EVAL_ERROR
         || evalStatus == NOMAD::EvalStatusType::EVAL_OK
+        || evalStatus == NOMAD::EvalStatusType::EVAL_TRUNCATED
         || preEvalStatus == NOMAD::EvalStatusType::EVAL_USER_REJECTED)
     {
         if (evalTypeAsBB(evalType, mainThreadNum))
@@ -2634,6 +3434,8 @@ bool NOMAD::EvaluatorControl::updateEvalStatusBeforeEval(NOMAD::EvalPoint &evalP
         goodForEval = false;
     }
     else if (evalStatus == NOMAD::EvalStatusType::EVAL_NOT_STARTED
+             || evalStatus == NOMAD::EvalStatusType::EVAL_TIMEOUT
+             || evalStatus == NOMAD::EvalStatusType::EVAL_CANCELLED
              || evalStatus == NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED)
     {
         // All good
@@ -2665,15 +3467,17 @@ bool NOMAD::EvaluatorControl::updateEvalStatusBeforeEval(NOMAD::EvalPoint &evalP
 
 
 void NOMAD::EvaluatorControl::updateEvalStatusAfterEval(NOMAD::EvalPoint &evalPoint,
-                                                        std::vector<bool>::iterator itEvalOk)
+                                                        std::vector<bool>::iterator itEvalOk,
+                                                        NOMAD::EvalType evalType)
 {
-    const int mainThreadNum = evalPoint.getThreadAlgo();
-    NOMAD::EvalType evalType = getCurrentEvalType(mainThreadNum);
     NOMAD::EvalStatusType evalStatus = evalPoint.getEvalStatus(evalType);
     NOMAD::EvalStatusType preEvalStatus = evalPoint.getPreEvalStatus(evalType);
     if (evalStatus == NOMAD::EvalStatusType::EVAL_FAILED
         || evalStatus == NOMAD::EvalStatusType::EVAL_ERROR
         || evalStatus == NOMAD::EvalStatusType::EVAL_OK
+        || evalStatus == NOMAD::EvalStatusType::EVAL_TIMEOUT
+        || evalStatus == NOMAD::EvalStatusType::EVAL_CANCELLED
+        || evalStatus == NOMAD::EvalStatusType::EVAL_TRUNCATED
         || preEvalStatus == NOMAD::EvalStatusType::EVAL_USER_REJECTED)
     {
         // Nothing to do
@@ -2705,6 +3509,13 @@ void NOMAD::EvaluatorControl::updateEvalStatusAfterEval(NOMAD::EvalPoint &evalPo
             evalPoint.setThreadAlgo(threadAlgo);
             *itEvalOk = true;
         }
+        else if (foundEvalStatus == NOMAD::EvalStatusType::EVAL_TIMEOUT
+                 || foundEvalStatus == NOMAD::EvalStatusType::EVAL_CANCELLED
+                 || foundEvalStatus == NOMAD::EvalStatusType::EVAL_TRUNCATED)
+        {
+            // Keep the status: not a failure.
+            *itEvalOk = false;
+        }
         else
         {
             evalPoint.setEvalStatus(NOMAD::EvalStatusType::EVAL_FAILED, evalType);
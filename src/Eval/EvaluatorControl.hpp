@@ -56,8 +56,18 @@
 #define __NOMAD_4_5_EVALUATORCONTROL__
 
 #include "../Eval/BarrierBase.hpp"
+#include "../Eval/BlockCommitOrder.hpp"
+#include "../Eval/BlockSizeAdapter.hpp"
 #include "../Eval/SuccessStats.hpp"
+#include "../Eval/SurrogatePipeline.hpp"
 #include "../Eval/ComparePriority.hpp"
+#include "../Eval/EvalCancelToken.hpp"
+#include "../Eval/EvalHedging.hpp"
+#include "../Eval/EvalQueueCheckpoint.hpp"
+#include "../Eval/EvalTelemetry.hpp"
+#include "../Eval/WorkStealingQueue.hpp"
+#include "../Eval/EvalTimeModel.hpp"
+#include "../Eval/EvalTrajectory.hpp"
 #include "../Eval/EvalQueuePoint.hpp"
 #include "../Eval/EvcMainThreadInfo.hpp"
 #include "../Param/EvaluatorControlGlobalParameters.hpp"
@@ -177,9 +187,11 @@ private:
 
     static std::shared_ptr<ComparePriorityMethod>  _userCompMethod;    ///< User-implemented comparison method to sort points before evaluation
 
+    std::vector<EvalCancelTokenPtr> _evalCancelTokens;  ///< Tokens of the blocks currently evaluated. Access in critical section evalCancelTokens.
+
 #ifdef _OPENMP
     /// To lock the queue
-    mutable omp_lock_t _evalQueueLock;
+    mutable InstrumentedLock _evalQueueLock;
 #endif // _OPENMP
 
     /// The number of blackbox evaluations performed
@@ -242,6 +254,36 @@ private:
      */
     std::atomic<size_t> _blockEval;
 
+    /// The number of blocks evaluated by another thread than the one they were first assigned to
+    /**
+     \remark Atomic for thread-safety.
+     */
+    std::atomic<size_t> _nbBlockSteals;
+
+    /// The number of blocks evaluated before a block that came before them, with NB_THREADS_SURROGATE_EVAL
+    /**
+     \remark Atomic for thread-safety.
+     */
+    std::atomic<size_t> _nbBlocksReprioritized;
+
+    /// The number of blackbox evaluations stopped early with BB_EVAL_STAGED
+    /**
+     \remark Atomic for thread-safety.
+     */
+    std::atomic<size_t> _nbEvalRejectedEarly;
+
+    /// The number of blackbox evaluations truncated with BB_EVAL_MULTI_FIDELITY
+    /**
+     \remark Atomic for thread-safety.
+     */
+    std::atomic<size_t> _nbEvalTruncated;
+
+    /// The number of blackbox evaluations cancelled after an opportunistic success, with EVAL_OPPORTUNISTIC_CANCEL
+    /**
+     \remark Atomic for thread-safety.
+     */
+    std::atomic<size_t> _nbEvalCancelled;
+
     /// The index of the last successful evaluation block
     /**
      \remark Atomic for thread-safety.
@@ -292,6 +334,28 @@ private:
     SPAttribute<size_t>  _maxBBEval, _maxSurrogateEval, _maxEval, _maxBlockEval;
     SPAttribute<bool> _useCacheFileForRerun; ///< Flag to use cache file for evaluation during rerun.
     SPAttribute<int> _nbThreadsForParallelEval; ///< The number of threads for parallel run evaluations. Parallel eval available only when OpenMP is available.
+    SPAttribute<bool> _bbAdaptiveBlockSize; ///< Flag to adapt the size of blocks of blackbox evaluations.
+
+    BlockSizeAdapter _blockSizeAdapter; ///< Block sizes for BB_ADAPTIVE_BLOCK_SIZE. Access in critical section blockSizeAdapter.
+
+    SPAttribute<bool> _evalCostAwareDispatch; ///< Flag to dispatch blackbox evaluations using predicted evaluation times.
+
+    EvalTimeModel _evalTimeModel; ///< Blackbox evaluation times, for EVAL_COST_AWARE_DISPATCH. Access in critical section evalTimeModel.
+
+    EvalHedging _evalHedging; ///< Duplicate execution of straggler blocks, for BB_HEDGING_PERCENTILE.
+
+    EvalQueueCheckpoint _evalQueueCheckpoint; ///< Checkpoint of the evaluations not completed, for EVAL_QUEUE_CHECKPOINT_FILE.
+
+    EvalTelemetry _evalTelemetry; ///< Histograms of the evaluation latencies and of the queue depth, for the detailed stats and EVAL_METRICS_FILE.
+
+    EvalTrajectoryPtr _refTrajectory; ///< Trajectory of the best feasible evaluation with intermediate estimates, for BB_EVAL_MULTI_FIDELITY. Access in critical section evalTrajectory.
+    Double _refTrajectoryF; ///< f of the evaluation of _refTrajectory.
+
+    SPAttribute<bool> _deterministicParallel; ///< Flag to commit the results of the blocks in their order.
+
+    SPAttribute<bool> _opportunisticCancel; ///< Flag to cancel the evaluations in progress after an opportunistic success.
+
+    SPAttribute<size_t> _nbThreadsSurrogateEval; ///< The number of threads for static surrogate evaluations in a pipeline with blackbox evaluations.
 
 
     // Default callback function. Does nothing.
@@ -324,6 +388,9 @@ private:
     // Flag to indicate if callback for eval fail check has been set by user
     static bool _cbFailEvalCheckIsDefault;
 
+    // Flag to indicate if callback for eval opportunistic check has been set by user
+    static bool _cbEvalOpportunisticCheckIsDefault;
+
 #ifdef TIME_STATS
     double _evalTime;  ///< Total time spent running evaluations
 #endif // TIME_STATS
@@ -336,6 +403,7 @@ public:
     static void resetCallbacks()
     {
         _cbEvalOpportunisticCheck = NOMAD::EvaluatorControl::defaultEvalCB<bool&,bool&>;
+        _cbEvalOpportunisticCheckIsDefault = true;
         _cbPreEvalUpdate = NOMAD::EvaluatorControl::defaultEvalCB<const Double &, bool &>;
         _cbPreEvalBlockUpdate = NOMAD::EvaluatorControl::defaultEvalBlockCB;
         _cbPostEvalUpdate = NOMAD::EvaluatorControl::defaultEvalCB<>;
@@ -356,7 +424,7 @@ public:
         _mainThreadInfo(),
         _evalPointQueue(),
 #ifdef _OPENMP
-        _evalQueueLock(),
+        _evalQueueLock("evalQueueLock"),
 #endif // _OPENMP
         _bbEval(0),
         _bbEvalFromCacheForRerun(0),
@@ -367,6 +435,11 @@ public:
         _surrogateEvalFromCacheForRerun(0),
         _totalModelEval(0),
         _blockEval(0),
+        _nbBlockSteals(0),
+        _nbBlocksReprioritized(0),
+        _nbEvalRejectedEarly(0),
+        _nbEvalTruncated(0),
+        _nbEvalCancelled(0),
         _indexSuccBlockEval(0),
         _indexBestFeasEval(0),
         _indexBestInfeasEval(0),
@@ -374,7 +447,12 @@ public:
         _nbRelativeSuccess(0),
         _nbPhaseOneSuccess(0),
         _nbRevealingIter(0),
-        _allDoneWithEval(false)
+        _allDoneWithEval(false),
+        _blockSizeAdapter(),
+        _evalTimeModel(),
+        _evalHedging(),
+        _refTrajectory(nullptr),
+        _refTrajectoryF()
 #ifdef TIME_STATS
         ,_evalTime(0.0)
 #endif // TIME_STATS
@@ -397,7 +475,7 @@ public:
         _mainThreadInfo(),
         _evalPointQueue(),
 #ifdef _OPENMP
-        _evalQueueLock(),
+        _evalQueueLock("evalQueueLock"),
 #endif // _OPENMP
         _bbEval(0),
         _bbEvalFromCacheForRerun(0),
@@ -408,6 +486,11 @@ public:
         _surrogateEvalFromCacheForRerun(0),
         _totalModelEval(0),
         _blockEval(0),
+        _nbBlockSteals(0),
+        _nbBlocksReprioritized(0),
+        _nbEvalRejectedEarly(0),
+        _nbEvalTruncated(0),
+        _nbEvalCancelled(0),
         _indexSuccBlockEval(0),
         _indexBestFeasEval(0),
         _indexBestInfeasEval(0),
@@ -415,7 +498,12 @@ public:
         _nbRelativeSuccess(0),
         _nbPhaseOneSuccess(0),
         _nbRevealingIter(0),
-        _allDoneWithEval(false)
+        _allDoneWithEval(false),
+        _blockSizeAdapter(),
+        _evalTimeModel(),
+        _evalHedging(),
+        _refTrajectory(nullptr),
+        _refTrajectoryF()
 #ifdef TIME_STATS
         ,_evalTime(0.0)
 #endif // TIME_STATS
@@ -482,9 +570,33 @@ public:
     /// Get the number of block evaluations.
     size_t getBlockEval() const { return _blockEval; }
 
+    /// Get the number of blocks stolen by an idle evaluation thread.
+    size_t getNbBlockSteals() const { return _nbBlockSteals; }
+
+    /// Get the number of blocks of blackbox evaluations moved ahead by their static surrogate values.
+    size_t getNbBlocksReprioritized() const { return _nbBlocksReprioritized; }
+
+    /// Get the number of blackbox evaluations stopped early with BB_EVAL_STAGED.
+    size_t getNbEvalRejectedEarly() const { return _nbEvalRejectedEarly; }
+
+    /// Get the number of blackbox evaluations truncated with BB_EVAL_MULTI_FIDELITY.
+    size_t getNbEvalTruncated() const { return _nbEvalTruncated; }
+
+    /// Get the number of blackbox evaluations cancelled after an opportunistic success.
+    size_t getNbEvalCancelled() const { return _nbEvalCancelled; }
+
     /// Get the index  of block evaluations.
     size_t getIndexSuccBlockEval() const { return _indexSuccBlockEval; }
 
+    /// Get the block sizes chosen with BB_ADAPTIVE_BLOCK_SIZE, and the measured times.
+    const BlockSizeAdapter& getBlockSizeAdapter() const { return _blockSizeAdapter; }
+
+    /// Get the number of duplicates launched with BB_HEDGING_PERCENTILE, and the number of duplicates that completed first.
+    const EvalHedging& getEvalHedging() const { return _evalHedging; }
+
+    /// Get the histograms of the evaluation latencies and of the queue depth.
+    const EvalTelemetry& getEvalTelemetry() const { return _evalTelemetry; }
+
     /** Get the total number of evaluations.
      * Total number of evaluations, including:
         - blackbox evaluations (EvaluatorControl::_bbEval),
@@ -565,8 +677,10 @@ public:
     bool remainsEvaluatedPoints(const int threadNum) const;
     void clearEvaluatedPoints(const int threadNum);
 
-    const SuccessType& getSuccessType(const int threadNum) const;
+    SuccessType getSuccessType(const int threadNum) const;
     void setSuccessType(const int threadNum, const SuccessType& success);
+    /// Keep the best of the current and the given success type (lock-free max-reduction)
+    void updateSuccessType(const int threadNum, const SuccessType& success);
 
     /// Get the max infeasibility to keep a point in barrier
     Double getHMax(const int threadNum) const;
@@ -595,6 +709,8 @@ public:
     /// Get or Set the value of some parameters (those are associated to a Main Thread)
     EvalSortType getEvalSortType(const int mainThreadNum =-1) const;
     void setEvalSortType(EvalSortType evalSortType);
+    /// Are the points ranked by the static surrogate during the blackbox evaluations (NB_THREADS_SURROGATE_EVAL)?
+    bool useSurrogatePipeline(const int mainThreadNum = -1) const;
     bool getOpportunisticEval(const int mainThreadNum = -1) const;
     void setOpportunisticEval(const bool opportunistic);
     bool getUseCache(const int mainThreadNum = -1) const;
@@ -655,7 +771,24 @@ public:
     size_t clearQueue(const int mainThreadNum, const bool showDebug = false);
 
     /// Start evaluation.
-    void start() {}
+    /**
+     * With EVAL_QUEUE_CHECKPOINT_FILE, restore the counters and the points
+     * not completed by a previous run that stopped before its end.
+     */
+    void start();
+
+    /// Take the points restored from the checkpoint, to be evaluated again.
+    /**
+     \param fixedVariable   The fixed variables of the subproblem -- \b IN.
+     \return                The points that are in the subproblem, in its dimension.
+     */
+    std::vector<Point> popCheckpointPoints(const Point& fixedVariable) { return _evalQueueCheckpoint.popRestoredPoints(fixedVariable); }
+
+    /// The run is complete: remove the checkpoint file.
+    void removeCheckpoint() { _evalQueueCheckpoint.remove(); }
+
+    /// The run is complete: write the last metrics (EVAL_METRICS_FILE).
+    void writeEvalMetrics() { _evalTelemetry.writeMetrics(true); }
 
     /// Continuous evaluation - running on all threads simultaneously.
     /**
@@ -668,6 +801,14 @@ public:
     /// Stop evaluation
     void stop();
 
+    /// Cancel the evaluations in progress for a main thread.
+    /**
+     * Blackbox executables are killed. The points that were not completed get
+     * the status EVAL_CANCELLED and may be evaluated again later.
+     \param mainThreadNum   Main thread of the evaluations to cancel -- \b IN.
+     */
+    void cancelEvaluations(const int mainThreadNum);
+
     /// Restart
     void restart();
 
@@ -676,10 +817,14 @@ public:
      Updates the Eval members of the evaluation points.
      Also updates the fields specific to EvalQueuePoints.
 
-    \param block   The block of points to evaluate -- \b IN/OUT.
-    \return        \c true if at least one evaluation worked (evalOk), \c false otherwise.
+    \param block       The block of points to evaluate -- \b IN/OUT.
+    \param commitOrder For DETERMINISTIC_PARALLEL: the results are committed in the order of the blocks. \c nullptr otherwise -- \b IN/OUT.
+    \param blockIndex  For DETERMINISTIC_PARALLEL: the index of the block -- \b IN.
+    \return            \c true if at least one evaluation worked (evalOk), \c false otherwise.
      */
-    bool evalBlock(BlockForEval& block);
+    bool evalBlock(BlockForEval& block,
+                   BlockCommitOrder* commitOrder = nullptr,
+                   const size_t blockIndex = 0);
 
     /// Evaluates a single point.
     /**
@@ -701,29 +846,36 @@ public:
      \param block   The block of points to evaluate -- \b IN/OUT.
      \param evaluator   Evaluator to be used for all these points
      \param hMax    The max infeasibility threshold to keep a point in barrier -- \b IN.
+     \param commitOrder For DETERMINISTIC_PARALLEL: wait for the turn of the block before updating the counters and the cache. \c nullptr otherwise -- \b IN/OUT.
+     \param blockIndex  For DETERMINISTIC_PARALLEL: the index of the block -- \b IN.
      \return        A vector of booleans, of the same size as block.
      */
     std::vector<bool> evalBlockOfPoints(Block &block,
                                         const Evaluator& evaluator,
-                                        const Double &hMax );
+                                        const Double &hMax,
+                                        BlockCommitOrder* commitOrder = nullptr,
+                                        const size_t blockIndex = 0);
 
     /// Updates eval status.
     /**
      Find the point in the cache and update its evalStatus
       to IN_PROGRESS, knowing that the evaluation is about to start.
      \param evalPoint   The evaluation point -- \b IN/OUT.
+     \param evalType    The type of the evaluation -- \b IN.
      \return \c true if the point must be evaluated, \c false otherwise.
      */
-    bool updateEvalStatusBeforeEval(EvalPoint &evalPoint) const;
+    bool updateEvalStatusBeforeEval(EvalPoint &evalPoint, EvalType evalType) const;
 
     /// Updates eval status.
     /**
      Update point's evalStatus, knowing that the evaluation has just ended.
      \param evalPoint       The evalPoint -- \b IN/OUT.
      \param itEvalOk          Status of evaluation -- \b IN/OUT.
+     \param evalType          The type of the evaluation -- \b IN.
      */
     void updateEvalStatusAfterEval(EvalPoint &evalPoint,
-                                   std::vector<bool>::iterator itEvalOk);
+                                   std::vector<bool>::iterator itEvalOk,
+                                   EvalType evalType);
 
     /// Did we reach one of the evaluation parameters: MAX_EVAL, MAX_BB_EVAL, MAX_BLOCK_EVAL ?
     bool reachedMaxEval() const;
@@ -781,6 +933,9 @@ private:
     /// Helper for destructor
     void destroy();
 
+    /// Write the checkpoint of the evaluations not completed, if EVAL_QUEUE_CHECKPOINT_INTERVAL has elapsed.
+    void writeCheckpoint();
+
     /// Helper for run
     /**
      * If either f value or h value of evalPoint is not well defined or eval part is nullptr, change eval status of eval point to fail and return false
@@ -790,6 +945,41 @@ private:
      */
     bool checkIfEvalOk(const NOMAD::Evaluator& evaluator, const NOMAD::EvalPointPtr& evalPoint, NOMAD::OutputInfo* evalInfoPtr) const;
 
+    /// Helper for evalBlockOfPoints(): the block evaluation is done, its token can no longer be cancelled.
+    void removeEvalCancelToken(const EvalCancelTokenPtr& cancelToken);
+
+    /// Helper for evalBlock() and evalBlockOfPoints(): wait for the turn of a block to commit its results.
+    /**
+     The block is discarded if the evaluations were stopped by the previous blocks.
+     \return    \c true if the block is discarded.
+     */
+    bool beginBlockCommit(BlockCommitOrder& commitOrder, const size_t blockIndex, const int mainThreadNum);
+
+    /// Helper for run(): evaluate a block with the static surrogate, for NB_THREADS_SURROGATE_EVAL.
+    /**
+     The points keep their blackbox evaluation type. Their static surrogate evaluation is used to rank the block.
+     \param blockForEval       The block of points -- \b IN/OUT.
+     \param surrogateEvaluator The static surrogate evaluator -- \b IN.
+     \param orderBySurrogate   The comparison of points using their static surrogate evaluation -- \b IN.
+     \return                   The best point of the block, or \c nullptr if no point has a static surrogate evaluation.
+     */
+    EvalQueuePointPtr screenBlock(BlockForEval& blockForEval,
+                                  const Evaluator& surrogateEvaluator,
+                                  const OrderByEval& orderBySurrogate);
+
+    /// Helper for run(): a thread with no more blocks duplicates the stragglers of the main thread.
+    /**
+     \param mainThreadNum       The main thread -- \b IN.
+     \param nbBlocksRunning     Number of blocks of the main thread being evaluated. Updated by the other threads -- \b IN.
+     \param conditionForStop    The evaluations of the main thread are stopped. Updated by the other threads -- \b IN.
+     */
+    void hedgeStragglers(const int mainThreadNum,
+                         const std::atomic<size_t>& nbBlocksRunning,
+                         const std::atomic<bool>& conditionForStop);
+
+    /// Helper for hedgeStragglers(): evaluate the duplicate of a straggler.
+    void evalDuplicate(const HedgedBlockPtr& hedgedBlock, const EvalCancelTokenPtr& duplicateToken);
+
     /// Get the EvcMainThreadInfo associated with this thread number.
     /**
      * Get EvcMainThreadInfo associated with this thread number.
@@ -47,6 +47,7 @@
 
 #include "../Eval/EvcMainThreadInfo.hpp"
 #include "../Output/OutputQueue.hpp"
+#include "../Util/InstrumentedLock.hpp"
 #include "../Util/MicroSleep.hpp"
 
 /*-------------------------*/
@@ -81,6 +82,13 @@ bool NOMAD::EvcMainThreadInfo::hasEvaluator(NOMAD::EvalType evalType) const
     return true;
 }
 
+const NOMAD::Evaluator* NOMAD::EvcMainThreadInfo::findEvaluator(NOMAD::EvalType evalType) const
+{
+    auto it = std::find_if(_evaluators.begin(),_evaluators.end(), [evalType](const NOMAD::EvaluatorPtr& e){ return e->getEvalType() == evalType; });
+
+    return ( _evaluators.end() == it ) ? nullptr : it->get();
+}
+
 const NOMAD::Evaluator* NOMAD::EvcMainThreadInfo::getCurrentEvaluator() const
 {
     if (_evaluators.empty())
@@ -254,10 +262,8 @@ std::vector<NOMAD::EvalPoint> NOMAD::EvcMainThreadInfo::retrieveAllEvaluatedPoin
 
 void NOMAD::EvcMainThreadInfo::addEvaluatedPoint(const NOMAD::EvalPoint& evaluatedPoint)
 {
-#ifdef _OPENMP
-    #pragma omp critical(addEvaluatedPoint)
-#endif // _OPENMP
     {
+        NOMAD_CRITICAL(addEvaluatedPoint);
         _evaluatedPoints.push_back(evaluatedPoint);
     }
 }
@@ -265,12 +271,22 @@ void NOMAD::EvcMainThreadInfo::addEvaluatedPoint(const NOMAD::EvalPoint& evaluat
 
 void NOMAD::EvcMainThreadInfo::setSuccessType(const NOMAD::SuccessType& success)
 {
-    // Note setSuccessType is already called inside a critical section, so do not
-    // add another critical section here.
     _success = success;
 }
 
 
+void NOMAD::EvcMainThreadInfo::updateSuccessType(const NOMAD::SuccessType& success)
+{
+    // Max-reduction: retry until the stored value is at least success.
+    // On failure, compare_exchange_weak reloads currentSuccess.
+    NOMAD::SuccessType currentSuccess = _success.load();
+    while (success > currentSuccess
+           && !_success.compare_exchange_weak(currentSuccess, success))
+    {
+    }
+}
+
+
 void NOMAD::EvcMainThreadInfo::incCurrentlyRunning(size_t k)
 {
     _currentlyRunning += k;
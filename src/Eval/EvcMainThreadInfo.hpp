@@ -83,7 +83,7 @@ private:
     std::shared_ptr<BarrierBase>    _barrier;
     EvalPointPtr                    _bestIncumbent;     ///< Temporary value useful for display only. The best feasible if available, otherwise, the best infeasible.
     std::vector<EvalPoint>          _evaluatedPoints;   ///< Where evaluated points are put temporarily
-    SuccessType                     _success;           ///< Success type of the last run
+    std::atomic<SuccessType>        _success;           ///< Success type of the last run. Updated with a lock-free max-reduction.
     std::atomic<size_t>             _currentlyRunning;  ///< Count number of evaluations currently running.
     size_t                          _lapMaxBbEval;      ///< The maximum number of blackbox evaluations that can be performed by a sub algorithm.
     std::atomic<size_t>             _lapBbEval;         ///< The number of blackbox evaluations performed by a given sub algorithm (reset at Algorithm start).
@@ -142,6 +142,13 @@ public:
      \param evalType       The evaluator type (real blackbox, surrogate blackbox or model evaluations)-- \b IN.
      */
     bool hasEvaluator(EvalType evalType ) const;
+
+    /// Get the evalType evaluator without changing the current evaluator type.
+    /**
+     \param evalType       The evaluator type (real blackbox, surrogate blackbox or model evaluations)-- \b IN.
+     \return               The evaluator, or \c nullptr if it does not exist.
+     */
+    const Evaluator* findEvaluator(EvalType evalType) const;
     
     /// Select current evaluator type.
     /// NOTE: The evaluator MAY NOT have been added yet
@@ -213,8 +220,10 @@ public:
     void clearEvaluatedPoints() { _evaluatedPoints.clear(); }
     size_t getNbEvaluatedPoints() const { return _evaluatedPoints.size(); }
 
-    const SuccessType& getSuccessType() const { return _success; }
+    SuccessType getSuccessType() const { return _success; }
     void setSuccessType(const SuccessType& success);
+    /// Keep the best of the current success type and the given success type. Lock-free.
+    void updateSuccessType(const SuccessType& success);
     
     /// Access to collected success type stats
     const SuccessStats & getSuccessStats() const { return _successStats;}
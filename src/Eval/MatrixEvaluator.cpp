@@ -0,0 +1,161 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   MatrixEvaluator.cpp
+ \brief  Evaluation of blocks of points given as contiguous matrices
+ \author Christophe Tribes
+ \date   October 2026
+ \see    MatrixEvaluator.hpp
+ */
+#include "../Eval/MatrixEvaluator.hpp"
+
+#include <algorithm>
+#include <memory>
+
+
+namespace {
+    // Matrices of the blocks evaluated by this thread. They only grow.
+    struct MatrixBuffers
+    {
+        std::vector<double>     inputs;
+        std::vector<double>     outputs;
+        std::unique_ptr<bool[]> evalOk;
+        std::unique_ptr<bool[]> countEval;
+        size_t                  nbPointsAllocated = 0;
+
+        void resize(const size_t nbPoints, const size_t nbInputs, const size_t nbOutputs)
+        {
+            inputs.resize(nbPoints * nbInputs);
+            outputs.resize(nbPoints * nbOutputs);
+            if (nbPoints > nbPointsAllocated)
+            {
+                evalOk = std::make_unique<bool[]>(nbPoints);
+                countEval = std::make_unique<bool[]>(nbPoints);
+                nbPointsAllocated = nbPoints;
+            }
+        }
+    };
+}
+
+// NOTE: not a static member, for the same reason as tmp files in Evaluator.cpp (Windows VS build).
+static thread_local MatrixBuffers _matrixBuffers;
+
+
+std::vector<bool> NOMAD::MatrixEvaluator::eval_block(NOMAD::Block &block,
+                                                     const NOMAD::Double &hMax,
+                                                     std::vector<bool> &countEval) const
+{
+    std::vector<bool> evalOk(block.size(), false);
+    countEval.resize(block.size(), false);
+
+    if (block.empty())
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "MatrixEvaluator: eval_block called with an empty block");
+    }
+
+    // Rows of the matrices. EVAL_WAIT -> no need to evaluate, it is already in progress by another thread.
+    std::vector<size_t> rowIndex;
+    rowIndex.reserve(block.size());
+    for (size_t index = 0; index < block.size(); index++)
+    {
+        if (!block[index]->isComplete())
+        {
+            throw NOMAD::Exception(__FILE__, __LINE__, "MatrixEvaluator: Incomplete point " + block[index]->display());
+        }
+        if (NOMAD::EvalStatusType::EVAL_WAIT == block[index]->getEvalStatus(_evalType))
+        {
+            evalOk[index] = true;
+        }
+        else
+        {
+            rowIndex.push_back(index);
+        }
+    }
+    if (rowIndex.empty())
+    {
+        return evalOk;
+    }
+
+    const size_t nbPoints = rowIndex.size();
+    const size_t nbInputs = block[rowIndex[0]]->size();
+    const size_t nbOutputs = _bbOutputTypeList.size();
+    _matrixBuffers.resize(nbPoints, nbInputs, nbOutputs);
+
+    double* inputs = _matrixBuffers.inputs.data();
+    for (size_t row = 0; row < nbPoints; row++)
+    {
+        const NOMAD::EvalPoint& x = *block[rowIndex[row]];
+        for (size_t i = 0; i < nbInputs; i++)
+        {
+            inputs[row * nbInputs + i] = x[i].todouble();
+        }
+    }
+    std::fill(_matrixBuffers.outputs.begin(), _matrixBuffers.outputs.end(), NOMAD::INF);
+    std::fill(_matrixBuffers.evalOk.get(), _matrixBuffers.evalOk.get() + nbPoints, false);
+    std::fill(_matrixBuffers.countEval.get(), _matrixBuffers.countEval.get() + nbPoints, false);
+
+    eval_matrix(nbPoints, nbInputs, inputs,
+                nbOutputs, _matrixBuffers.outputs.data(),
+                _matrixBuffers.evalOk.get(), _matrixBuffers.countEval.get());
+
+    // The outputs are set as values: no string to format and parse.
+    NOMAD::ArrayOfDouble bbo(nbOutputs);
+    const double* outputs = _matrixBuffers.outputs.data();
+    for (size_t row = 0; row < nbPoints; row++)
+    {
+        for (size_t j = 0; j < nbOutputs; j++)
+        {
+            bbo[j] = outputs[row * nbOutputs + j];
+        }
+        const size_t index = rowIndex[row];
+        block[index]->setBBO(bbo, _bbOutputTypeList, _evalType);
+        evalOk[index] = _matrixBuffers.evalOk[row];
+        countEval[index] = _matrixBuffers.countEval[row];
+    }
+
+    return evalOk;
+}
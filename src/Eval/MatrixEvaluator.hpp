@@ -0,0 +1,114 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   MatrixEvaluator.hpp
+ \brief  Evaluation of blocks of points given as contiguous matrices
+ \author Christophe Tribes
+ \date   October 2026
+ \see    MatrixEvaluator.cpp
+ */
+#ifndef __NOMAD_4_5_MATRIXEVALUATOR__
+#define __NOMAD_4_5_MATRIXEVALUATOR__
+
+#include "../Eval/Evaluator.hpp"
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Evaluator for blocks of points given as contiguous matrices.
+/**
+ The user implements eval_matrix() instead of eval_x() or eval_block(). The
+ points of a block are passed as a row-major matrix of doubles, one row per
+ point, and the outputs are written in a row-major matrix, one row per point,
+ in the order of BB_OUTPUT_TYPE. Vectorized or batched numerical code can use
+ the matrices directly: there is no EvalPoint to read and no output string to
+ build.
+
+ The matrices are allocated once per evaluation thread and reused from one
+ block to the next. Points with status EVAL_WAIT (evaluated by another thread)
+ are not part of the matrices.
+ */
+class DLL_EVAL_API MatrixEvaluator : public Evaluator
+{
+public:
+    /// Constructor
+    /**
+     \param evalParams  The parameters to control the behavior of the evaluator -- \b IN.
+     \param evalType    Which type of Eval will be updated by this Evaluator -- \b IN.
+     */
+    explicit MatrixEvaluator(const std::shared_ptr<EvalParameters> &evalParams,
+                             EvalType evalType = EvalType::BB)
+      : Evaluator(evalParams, evalType, EvalXDefined::EVAL_BLOCK_DEFINED_BY_USER)
+    {}
+
+    /// Evaluate the blackbox functions for a block of points given as a matrix. Defined by the user.
+    /**
+     \param nbPoints    The number of points (rows of the matrices) -- \b IN.
+     \param nbInputs    The dimension of the points -- \b IN.
+     \param inputs      The points: nbPoints x nbInputs, row-major -- \b IN.
+     \param nbOutputs   The number of outputs of a point -- \b IN.
+     \param outputs     The outputs: nbPoints x nbOutputs, row-major. Initialized to INF -- \b OUT.
+     \param evalOk      For each point, \c true if the evaluation succeeded. Initialized to \c false -- \b OUT.
+     \param countEval   For each point, \c true if the evaluation is counted. Initialized to \c false -- \b OUT.
+     */
+    virtual void eval_matrix(const size_t nbPoints,
+                             const size_t nbInputs,
+                             const double *inputs,
+                             const size_t nbOutputs,
+                             double *outputs,
+                             bool *evalOk,
+                             bool *countEval) const = 0;
+
+    /// Evaluate a block of points with eval_matrix().
+    std::vector<bool> eval_block(Block &block,
+                                 const Double &hMax,
+                                 std::vector<bool> &countEval) const override;
+};
+
+#include "../nomad_nsend.hpp"
+
+#endif // __NOMAD_4_5_MATRIXEVALUATOR__
@@ -0,0 +1,484 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   SocketEvaluator.cpp
+ \brief  Evaluation of blocks of points by remote nomad_worker daemons
+ \author Christophe Tribes
+ \date   October 2026
+ \see    SocketEvaluator.hpp
+ */
+#include "../Eval/SocketEvaluator.hpp"
+#include "../Output/OutputQueue.hpp"
+#include "../Util/ArrayOfString.hpp"
+#include "../Util/MicroSleep.hpp"
+
+#include <sstream>
+
+// Period for checking messages from a busy worker, in milliseconds.
+static const int WORKER_POLL_PERIOD_MS = 100;
+
+
+NOMAD::SocketEvaluator::SocketEvaluator(const std::shared_ptr<NOMAD::EvalParameters> &evalParams,
+                                        const NOMAD::EvalType evalType)
+  : NOMAD::Evaluator(evalParams, evalType, NOMAD::EvalXDefined::USE_BB_EVAL),
+    _workers(),
+    _jobId(0)
+#ifdef _OPENMP
+    ,_workersLock("workersLock")
+#endif // _OPENMP
+{
+#ifdef _WIN32
+    throw NOMAD::Exception(__FILE__, __LINE__, "SocketEvaluator: BB_WORKERS is not supported on Windows.");
+#endif
+
+    auto addresses = _evalParams->getAttributeValue<NOMAD::ArrayOfString>("BB_WORKERS");
+    if (addresses.empty())
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "SocketEvaluator: parameter BB_WORKERS must be set.");
+    }
+    for (size_t i = 0; i < addresses.size(); i++)
+    {
+        WorkerConnection worker;
+        worker.address = addresses[i];
+        worker.socket = nullptr;
+        worker.busy = false;
+        // Connect on first use.
+        worker.lastConnectAttempt = std::chrono::steady_clock::now() - std::chrono::seconds(WORKER_RECONNECT_PERIOD);
+        worker.timePerPoint = -1.0;
+        worker.nbBlocks = 0;
+        _workers.push_back(worker);
+    }
+}
+
+
+NOMAD::SocketEvaluator::~SocketEvaluator()
+{
+    for (auto& worker : _workers)
+    {
+        if (nullptr != worker.socket)
+        {
+            worker.socket->close();
+        }
+    }
+}
+
+
+NOMAD::SocketPtr NOMAD::SocketEvaluator::connectWorker(const std::string& address) const
+{
+    auto socket = std::make_shared<NOMAD::Socket>();
+    std::string errMsg;
+    bool connected = socket->connect(address, errMsg);
+
+    if (connected)
+    {
+        // The worker greets first.
+        std::string hello;
+        if (NOMAD::SocketReadStatus::LINE_READ != socket->readLine(hello, 1000 * static_cast<int>(WORKER_TIMEOUT))
+            || 0 != hello.compare(0, std::string(MSG_HELLO).size(), MSG_HELLO))
+        {
+            errMsg = "Unexpected greeting \"" + hello + "\"";
+            connected = false;
+        }
+    }
+
+    if (!connected)
+    {
+        OUTPUT_INFO_START
+        NOMAD::OutputQueue::Add("Worker " + address + " not available: " + errMsg, NOMAD::OutputLevel::LEVEL_INFO);
+        OUTPUT_INFO_END
+        return nullptr;
+    }
+
+    OUTPUT_INFO_START
+    NOMAD::OutputQueue::Add("Connected to worker " + address, NOMAD::OutputLevel::LEVEL_INFO);
+    OUTPUT_INFO_END
+
+    return socket;
+}
+
+
+int NOMAD::SocketEvaluator::acquireWorker() const
+{
+    const auto& cancelToken = NOMAD::EvalCancelToken::getCurrent();
+
+    while (nullptr == cancelToken || !cancelToken->stopRequested())
+    {
+        int workerIndex = -1;
+        int toConnect = -1;
+        bool anyBusy = false;
+
+#ifdef _OPENMP
+        _workersLock.set();
+#endif // _OPENMP
+        const auto now = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < _workers.size(); i++)
+        {
+            const WorkerConnection& worker = _workers[i];
+            if (worker.busy)
+            {
+                anyBusy = true;
+            }
+            else if (nullptr != worker.socket)
+            {
+                // Load balancing: prefer the fastest worker. Workers without stats are tried first.
+                if (workerIndex < 0 || worker.timePerPoint < _workers[workerIndex].timePerPoint)
+                {
+                    workerIndex = static_cast<int>(i);
+                }
+            }
+            else if (toConnect < 0
+                     && now - worker.lastConnectAttempt >= std::chrono::seconds(WORKER_RECONNECT_PERIOD))
+            {
+                toConnect = static_cast<int>(i);
+            }
+        }
+        if (workerIndex < 0 && toConnect >= 0)
+        {
+            // Reserve the worker while connecting, outside of the lock.
+            _workers[toConnect].busy = true;
+            _workers[toConnect].lastConnectAttempt = now;
+        }
+        else if (workerIndex >= 0)
+        {
+            _workers[workerIndex].busy = true;
+        }
+#ifdef _OPENMP
+        _workersLock.unset();
+#endif // _OPENMP
+
+        if (workerIndex >= 0)
+        {
+            return workerIndex;
+        }
+
+        if (toConnect >= 0)
+        {
+            auto socket = connectWorker(_workers[toConnect].address);
+            if (nullptr != socket)
+            {
+#ifdef _OPENMP
+                _workersLock.set();
+#endif // _OPENMP
+                _workers[toConnect].socket = socket;
+#ifdef _OPENMP
+                _workersLock.unset();
+#endif // _OPENMP
+                return toConnect;
+            }
+            releaseWorker(toConnect, true, -1.0);
+            continue;
+        }
+
+        if (!anyBusy)
+        {
+            // All workers are lost and were tried recently.
+            bool allTried = true;
+#ifdef _OPENMP
+            _workersLock.set();
+#endif // _OPENMP
+            for (const auto& worker : _workers)
+            {
+                if (worker.busy || nullptr != worker.socket)
+                {
+                    allTried = false;
+                }
+            }
+#ifdef _OPENMP
+            _workersLock.unset();
+#endif // _OPENMP
+            if (allTried)
+            {
+                return -1;
+            }
+        }
+
+        // Wait for a worker to be released.
+        usleep(1000);
+    }
+
+    return -1;
+}
+
+
+void NOMAD::SocketEvaluator::releaseWorker(const int workerIndex, const bool lost, const double timePerPoint) const
+{
+#ifdef _OPENMP
+    _workersLock.set();
+#endif // _OPENMP
+    WorkerConnection& worker = _workers[workerIndex];
+    if (lost && nullptr != worker.socket)
+    {
+        worker.socket->close();
+        worker.socket = nullptr;
+        worker.lastConnectAttempt = std::chrono::steady_clock::now();
+    }
+    if (timePerPoint >= 0)
+    {
+        // Moving average, to follow changes in evaluation time.
+        worker.timePerPoint = (worker.nbBlocks > 0) ? 0.7 * worker.timePerPoint + 0.3 * timePerPoint : timePerPoint;
+        worker.nbBlocks++;
+    }
+    worker.busy = false;
+#ifdef _OPENMP
+    _workersLock.unset();
+#endif // _OPENMP
+}
+
+
+NOMAD::SocketEvaluator::JobStatus NOMAD::SocketEvaluator::runJob(NOMAD::Socket& socket,
+                                                                 const std::vector<std::string>& inputs,
+                                                                 std::vector<std::string>& outputs,
+                                                                 int& exitStatus) const
+{
+    outputs.clear();
+    exitStatus = 0;
+
+    size_t jobId = 0;
+#ifdef _OPENMP
+    _workersLock.set();
+#endif // _OPENMP
+    jobId = ++_jobId;
+#ifdef _OPENMP
+    _workersLock.unset();
+#endif // _OPENMP
+
+    bool sent = socket.sendLine(std::string(MSG_EVAL) + " " + std::to_string(jobId) + " " + std::to_string(inputs.size()));
+    for (size_t i = 0; sent && i < inputs.size(); i++)
+    {
+        sent = socket.sendLine(inputs[i]);
+    }
+    if (!sent)
+    {
+        return JobStatus::LOST;
+    }
+
+    const auto& cancelToken = NOMAD::EvalCancelToken::getCurrent();
+    bool cancelSent = false;
+    auto lastNews = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        if (!cancelSent && nullptr != cancelToken && cancelToken->stopRequested())
+        {
+            // The worker kills its blackbox and answers with an empty result.
+            cancelSent = true;
+            if (!socket.sendLine(std::string(MSG_CANCEL) + " " + std::to_string(jobId)))
+            {
+                return JobStatus::LOST;
+            }
+        }
+
+        std::string line;
+        auto readStatus = socket.readLine(line, WORKER_POLL_PERIOD_MS);
+        if (NOMAD::SocketReadStatus::TIMEOUT == readStatus)
+        {
+            if (std::chrono::steady_clock::now() - lastNews > std::chrono::seconds(WORKER_TIMEOUT))
+            {
+                return JobStatus::LOST;
+            }
+            continue;
+        }
+        if (NOMAD::SocketReadStatus::LINE_READ != readStatus)
+        {
+            return JobStatus::LOST;
+        }
+        lastNews = std::chrono::steady_clock::now();
+
+        std::istringstream iss(line);
+        std::string keyword;
+        size_t resultJobId = 0, nbLines = 0;
+        iss >> keyword;
+        if (MSG_HEARTBEAT == keyword)
+        {
+            continue;
+        }
+        if (MSG_RESULT != keyword || !(iss >> resultJobId >> exitStatus >> nbLines))
+        {
+            OUTPUT_INFO_START
+            NOMAD::OutputQueue::Add("Unexpected message from worker: \"" + line + "\"", NOMAD::OutputLevel::LEVEL_INFO);
+            OUTPUT_INFO_END
+            return JobStatus::LOST;
+        }
+
+        for (size_t i = 0; i < nbLines; i++)
+        {
+            std::string output;
+            if (NOMAD::SocketReadStatus::LINE_READ != socket.readLine(output, 1000 * static_cast<int>(WORKER_TIMEOUT)))
+            {
+                return JobStatus::LOST;
+            }
+            outputs.push_back(output);
+        }
+
+        if (resultJobId != jobId)
+        {
+            // Late answer to a previous job. Ignore it.
+            outputs.clear();
+            continue;
+        }
+
+        return cancelSent ? JobStatus::STOPPED : JobStatus::DONE;
+    }
+}
+
+
+std::vector<bool> NOMAD::SocketEvaluator::evalXBBExe(NOMAD::Block &block,
+                                                     const NOMAD::Double &hMax,
+                                                     std::vector<bool> &countEval) const
+{
+    std::vector<bool> evalOk(block.size(), false);
+
+    // One line per point to evaluate. EVAL_WAIT points are not evaluated.
+    const auto& bbEvalFormat = getBBEvalFormat();
+    std::vector<std::string> inputs;
+    std::vector<size_t> inputIndex;
+    for (size_t index = 0; index < block.size(); index++)
+    {
+        const auto& x = block[index];
+        if (NOMAD::EvalStatusType::EVAL_IN_PROGRESS == x->getEvalStatus(_evalType))
+        {
+            std::string line;
+            for (size_t i = 0; i < x->size(); i++)
+            {
+                if (i != 0)
+                {
+                    line += " ";
+                }
+                line += (*x)[i].display(static_cast<int>(bbEvalFormat[i].todouble()));
+            }
+            inputs.push_back(line);
+            inputIndex.push_back(index);
+        }
+    }
+
+    if (inputs.empty())
+    {
+        std::fill(countEval.begin(), countEval.end(), false); // no eval should be counted
+        return std::vector<bool>(countEval.size(), true); // no eval is ok
+    }
+
+    // Dispatch. A block on a lost worker is sent to another worker.
+    std::vector<std::string> outputs;
+    int exitStatus = 0;
+    JobStatus jobStatus = JobStatus::LOST;
+    for (size_t attempt = 0; attempt <= _workers.size() && JobStatus::LOST == jobStatus; attempt++)
+    {
+        int workerIndex = acquireWorker();
+        if (workerIndex < 0)
+        {
+            break;
+        }
+
+        const auto startTime = std::chrono::steady_clock::now();
+        jobStatus = runJob(*_workers[workerIndex].socket, inputs, outputs, exitStatus);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+        const bool lost = (JobStatus::LOST == jobStatus);
+        releaseWorker(workerIndex, lost, (JobStatus::DONE == jobStatus) ? elapsed.count() / inputs.size() : -1.0);
+        if (lost)
+        {
+            std::string s = "Warning: lost worker " + _workers[workerIndex].address + ". Block of " + std::to_string(inputs.size());
+            s += " points is sent to another worker.";
+            NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_WARNING);
+        }
+    }
+
+    const auto& cancelToken = NOMAD::EvalCancelToken::getCurrent();
+    NOMAD::EvalStatusType stopEvalStatus = NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED;
+    if (nullptr != cancelToken && JobStatus::DONE != jobStatus)
+    {
+        stopEvalStatus = cancelToken->getStopEvalStatus();
+    }
+
+    for (size_t k = 0; k < inputIndex.size(); k++)
+    {
+        const size_t index = inputIndex[k];
+        const auto& x = block[index];
+
+        if (NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED != stopEvalStatus)
+        {
+            x->setEvalStatus(stopEvalStatus, _evalType);
+            countEval[index] = (NOMAD::EvalStatusType::EVAL_TIMEOUT == stopEvalStatus);
+        }
+        else if (JobStatus::DONE != jobStatus)
+        {
+            // No worker available. Point could be re-submitted.
+            x->setEvalStatus(NOMAD::EvalStatusType::EVAL_ERROR, _evalType);
+            NOMAD::OutputQueue::Add("Warning: no worker available to evaluate point " + x->display(), NOMAD::OutputLevel::LEVEL_WARNING);
+        }
+        else if (k >= outputs.size() || outputs[k].empty())
+        {
+            x->setEvalStatus(NOMAD::EvalStatusType::EVAL_ERROR, _evalType);
+            std::string s = "Warning: Evaluation error with point " + x->display();
+            s += ": output is empty. Let's count eval anyway (worker).";
+            NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_WARNING);
+            countEval[index] = true;
+        }
+        else
+        {
+            x->setBBO(outputs[k], _bbOutputTypeList, _evalType);
+            auto bbOutput = x->getEval(_evalType)->getBBOutput();
+            evalOk[index] = bbOutput.getEvalOk();
+            countEval[index] = bbOutput.getCountEval(_bbOutputTypeList);
+
+            if (exitStatus)
+            {
+                evalOk[index] = false;
+                x->setEvalStatus(NOMAD::EvalStatusType::EVAL_ERROR, _evalType);
+                std::string s = "Warning: Worker blackbox returned exit status " + std::to_string(exitStatus);
+                s += " for point: " + x->getX()->NOMAD::Point::display();
+                NOMAD::OutputQueue::Add(s, NOMAD::OutputLevel::LEVEL_WARNING);
+            }
+            else
+            {
+                x->setEvalStatus(evalOk[index] ? NOMAD::EvalStatusType::EVAL_OK : NOMAD::EvalStatusType::EVAL_FAILED, _evalType);
+            }
+        }
+    }
+
+    return evalOk;
+}
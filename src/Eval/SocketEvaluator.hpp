@@ -0,0 +1,192 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   SocketEvaluator.hpp
+ \brief  Evaluation of blocks of points by remote nomad_worker daemons
+ \author Christophe Tribes
+ \date   October 2026
+ \see    SocketEvaluator.cpp
+ */
+
+#ifndef __NOMAD_4_5_SOCKETEVALUATOR__
+#define __NOMAD_4_5_SOCKETEVALUATOR__
+
+#include <chrono>
+
+#include "../Eval/Evaluator.hpp"
+#include "../Util/InstrumentedLock.hpp"
+#include "../Util/Socket.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include "../nomad_nsbegin.hpp"
+
+/// Evaluator that dispatches blocks of points to \c nomad_worker daemons.
+/**
+ * Used in batch mode when parameter BB_WORKERS is set. Each block of points is
+ * sent to an idle worker, over a TCP or Unix-domain socket (see Socket). The
+ * worker runs its blackbox executable (or plugin) on the block, and sends back
+ * the blackbox outputs, one line per point.
+ *
+ * - Load balancing: an idle worker is chosen by lowest average time per point.
+ *   To use all workers, set NB_THREADS_PARALLEL_EVAL to the number of workers.
+ * - Heartbeat: a busy worker sends a heartbeat every second. A worker that is
+ *   silent for more than WORKER_TIMEOUT seconds, or that closes its connection,
+ *   is lost: its block is re-dispatched to another worker. A lost worker is
+ *   reconnected when it becomes available again.
+ * - Cancellation and BB_EVAL_TIMEOUT are forwarded to the worker, which kills
+ *   its blackbox.
+ *
+ * \note Not available on Windows.
+ */
+class DLL_EVAL_API SocketEvaluator : public Evaluator
+{
+private:
+    /// Info on the connection to a worker
+    struct WorkerConnection
+    {
+        std::string     address;
+        SocketPtr       socket;         ///< nullptr when not connected
+        bool            busy;           ///< A thread is using this worker
+        std::chrono::steady_clock::time_point lastConnectAttempt;
+        double          timePerPoint;   ///< Average evaluation time per point, in seconds. Negative if unknown.
+        size_t          nbBlocks;       ///< Number of blocks evaluated by this worker
+    };
+
+    mutable std::vector<WorkerConnection> _workers;
+
+    mutable size_t  _jobId;             ///< Identification of the last block sent
+
+#ifdef _OPENMP
+    /// To lock _workers and _jobId
+    mutable InstrumentedLock _workersLock;
+#endif // _OPENMP
+
+public:
+    /// Constructor
+    /**
+     \param evalParams      The parameters to control the behavior of the evaluator. BB_WORKERS must be set.
+     \param evalType        Which type of Eval will be updated by this Evaluator.
+     */
+    explicit SocketEvaluator(const std::shared_ptr<EvalParameters> &evalParams,
+                             EvalType evalType = EvalType::BB);
+
+    /// Destructor. Closes the connections to the workers.
+    virtual ~SocketEvaluator();
+
+    /// Seconds without news from a busy worker before it is considered lost.
+    static constexpr size_t WORKER_TIMEOUT = 10;
+
+    /// Seconds between attempts to reconnect to a lost worker.
+    static constexpr size_t WORKER_RECONNECT_PERIOD = 5;
+
+    /// Seconds between heartbeats of a busy worker.
+    static constexpr size_t WORKER_HEARTBEAT_PERIOD = 1;
+
+    /** \name Protocol
+     * Messages are lines of text.
+     * - Worker, on connection: \c NOMAD_WORKER
+     * - Evaluator: \c EVAL \c jobId \c nbPoints, followed by one line per point
+     * - Worker, while busy: \c HEARTBEAT
+     * - Evaluator, to stop a job: \c CANCEL \c jobId
+     * - Worker: \c RESULT \c jobId \c exitStatus \c nbLines, followed by
+     *   the output lines of the blackbox. A cancelled job has no output lines.
+     */
+    ///@{
+    static constexpr const char* MSG_HELLO     = "NOMAD_WORKER";
+    static constexpr const char* MSG_EVAL      = "EVAL";
+    static constexpr const char* MSG_HEARTBEAT = "HEARTBEAT";
+    static constexpr const char* MSG_CANCEL    = "CANCEL";
+    static constexpr const char* MSG_RESULT    = "RESULT";
+    ///@}
+
+private:
+
+    /// Dispatch a block to the workers. Replaces the system call of the Evaluator.
+    std::vector<bool> evalXBBExe(Block &block,
+                                 const Double &hMax,
+                                 std::vector<bool> &countEval) const override;
+
+    /// Get an idle worker, connecting to it if needed.
+    /**
+     Wait if all connected workers are busy.
+     \return The index of the worker in _workers, or -1 if no worker is available.
+     */
+    int acquireWorker() const;
+
+    /// Release a worker after use, and update its stats.
+    void releaseWorker(const int workerIndex, const bool lost, const double timePerPoint) const;
+
+    /// Connect to a worker and check its greeting. Return nullptr on failure.
+    SocketPtr connectWorker(const std::string& address) const;
+
+    /// Status of a block sent to a worker.
+    enum class JobStatus
+    {
+        DONE,       ///< The outputs were received
+        STOPPED,    ///< The evaluation was cancelled or timed out
+        LOST        ///< The worker was lost
+    };
+
+    /// Send a block to a worker and wait for its outputs.
+    /**
+     \param socket      Connection to the worker -- \b IN.
+     \param inputs      One line per point -- \b IN.
+     \param outputs     One line per point -- \b OUT.
+     \param exitStatus  Exit status of the blackbox on the worker -- \b OUT.
+     */
+    JobStatus runJob(Socket& socket,
+                     const std::vector<std::string>& inputs,
+                     std::vector<std::string>& outputs,
+                     int& exitStatus) const;
+};
+
+#include "../nomad_nsend.hpp"
+
+#endif // __NOMAD_4_5_SOCKETEVALUATOR__
@@ -0,0 +1,243 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   StagedEvalRejection.cpp
+ \brief  Early rejection of evaluations with staged or intermediate outputs
+ \author Christophe Tribes
+ \date   October 2026
+ \see    StagedEvalRejection.hpp
+ */
+#include "../Eval/StagedEvalRejection.hpp"
+#include "../Util/ArrayOfString.hpp"
+
+#include <algorithm>
+
+// Object of the block being evaluated by this thread.
+// NOTE: not a static member, for the same reason as tmp files in Evaluator.cpp (Windows VS build).
+static thread_local NOMAD::StagedEvalRejectionPtr _currentStagedEvalRejection = nullptr;
+
+
+NOMAD::StagedEvalRejection::StagedEvalRejection(const NOMAD::BBOutputTypeList& bbOutputTypeList,
+                                                const NOMAD::EvalType evalType,
+                                                const NOMAD::FHComputeTypeS& computeTypeS,
+                                                const NOMAD::Double& hMax,
+                                                const NOMAD::Double& fIncumbent)
+  : _bbOutputTypeList(bbOutputTypeList),
+    _evalType(evalType),
+    _computeTypeS(computeTypeS),
+    _hMax(hMax),
+    _fIncumbent(fIncumbent),
+    _fIsFinal(false),
+    _objIndex(NOMAD::INF_SIZE_T),
+    _refTrajectory(nullptr),
+    _truncationMargin(0.0),
+    _trajectories(),
+    _nbRejected(0)
+{
+    // A point with a worse objective may still improve the infeasible
+    // incumbent when there are PB constraints.
+    size_t nbObj = 0, objIndex = 0;
+    bool hasPB = false;
+    for (size_t i = 0; i < _bbOutputTypeList.size(); i++)
+    {
+        const NOMAD::BBOutputType& bbOutputType = _bbOutputTypeList[i];
+        if (bbOutputType.isObjective())
+        {
+            nbObj++;
+            objIndex = i;
+        }
+        else if (   bbOutputType == NOMAD::BBOutputType::Type::PB
+                 || bbOutputType == NOMAD::BBOutputType::Type::RPB)
+        {
+            hasPB = true;
+        }
+    }
+    _fIsFinal = (1 == nbObj && !hasPB);
+
+    // Objective estimates are compared directly with STANDARD f.
+    if (1 == nbObj && NOMAD::ComputeType::STANDARD == _computeTypeS.computeType)
+    {
+        _objIndex = objIndex;
+    }
+}
+
+
+bool NOMAD::StagedEvalRejection::reject(const NOMAD::ArrayOfDouble& partialBBO) const
+{
+    const NOMAD::ComputeType computeType = _computeTypeS.computeType;
+    if (   NOMAD::ComputeType::STANDARD != computeType
+        && NOMAD::ComputeType::DMULTI_COMBINE_F != computeType
+        && NOMAD::ComputeType::PHASE_ONE != computeType)
+    {
+        return false;
+    }
+
+    // Violation of the constraints read so far: PB for h, EB for f in PhaseOne.
+    // It can only grow with the next outputs.
+    NOMAD::Double violation = 0.0;
+    const size_t n = std::min(partialBBO.size(), _bbOutputTypeList.size());
+    for (size_t i = 0; i < n; i++)
+    {
+        const NOMAD::BBOutputType& bbOutputType = _bbOutputTypeList[i];
+        const NOMAD::Double& bboI = partialBBO[i];
+        if (!bboI.isDefined())
+        {
+            // Let the evaluation complete. It will be handled as usual.
+            return false;
+        }
+
+        const bool isEB = (bbOutputType == NOMAD::BBOutputType::Type::EB);
+        const bool isPB = (   bbOutputType == NOMAD::BBOutputType::Type::PB
+                           || bbOutputType == NOMAD::BBOutputType::Type::RPB);
+        if (NOMAD::ComputeType::PHASE_ONE == computeType ? isEB : isPB)
+        {
+            if (bboI > 0.0)
+            {
+                switch (_computeTypeS.hNormType)
+                {
+                    case NOMAD::HNormType::L2:
+                        violation += bboI * bboI;
+                        break;
+                    case NOMAD::HNormType::L1:
+                        violation += bboI;
+                        break;
+                    case NOMAD::HNormType::Linf:
+                        violation = NOMAD::max(violation, bboI);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+        else if (NOMAD::ComputeType::PHASE_ONE != computeType)
+        {
+            if (isEB && bboI > 0.0)
+            {
+                // Violated extreme barrier constraint.
+                return true;
+            }
+            if (   _fIsFinal
+                && NOMAD::ComputeType::STANDARD == computeType
+                && bbOutputType.isObjective()
+                && _fIncumbent.isDefined()
+                && bboI >= _fIncumbent)
+            {
+                // Feasible or not, the point cannot improve the incumbent.
+                return true;
+            }
+        }
+    }
+
+    if (NOMAD::ComputeType::PHASE_ONE == computeType)
+    {
+        return (_fIncumbent.isDefined() && violation > 0.0 && violation >= _fIncumbent);
+    }
+
+    return (_hMax.isDefined() && violation > _hMax);
+}
+
+
+std::string NOMAD::StagedEvalRejection::completeBBO(const std::string& partialBBO) const
+{
+    std::string bbo = partialBBO;
+    const NOMAD::ArrayOfString partial(partialBBO);
+    for (size_t i = partial.size(); i < _bbOutputTypeList.size(); i++)
+    {
+        // The evaluation of a rejected point is counted.
+        bbo += (_bbOutputTypeList[i] == NOMAD::BBOutputType::Type::CNT_EVAL) ? " 1" : " INF";
+    }
+    return bbo;
+}
+
+
+void NOMAD::StagedEvalRejection::setReferenceTrajectory(const NOMAD::EvalTrajectoryPtr& refTrajectory,
+                                                        const NOMAD::Double& truncationMargin)
+{
+    _refTrajectory = refTrajectory;
+    _truncationMargin = truncationMargin;
+}
+
+
+bool NOMAD::StagedEvalRejection::truncate(const int tag,
+                                          const size_t iteration,
+                                          const NOMAD::ArrayOfDouble& bbo)
+{
+    if (NOMAD::INF_SIZE_T == _objIndex || _objIndex >= bbo.size())
+    {
+        return false;
+    }
+
+    // The trajectory is kept even without reference: the point may become the reference.
+    const NOMAD::Double& estimate = bbo[_objIndex];
+    _trajectories[tag].add(iteration, estimate);
+
+    return (nullptr != _refTrajectory
+            && _refTrajectory->dominates(iteration, estimate, _truncationMargin));
+}
+
+
+NOMAD::EvalTrajectoryPtr NOMAD::StagedEvalRejection::getTrajectory(const int tag) const
+{
+    const auto it = _trajectories.find(tag);
+    if (_trajectories.end() == it || it->second.empty())
+    {
+        return nullptr;
+    }
+    return std::make_shared<const NOMAD::EvalTrajectory>(it->second);
+}
+
+
+void NOMAD::StagedEvalRejection::setCurrent(const NOMAD::StagedEvalRejectionPtr& stagedEvalRejection)
+{
+    _currentStagedEvalRejection = stagedEvalRejection;
+}
+
+
+const NOMAD::StagedEvalRejectionPtr& NOMAD::StagedEvalRejection::getCurrent()
+{
+    return _currentStagedEvalRejection;
+}
@@ -0,0 +1,170 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   StagedEvalRejection.hpp
+ \brief  Early rejection of evaluations with staged or intermediate outputs
+ \author Christophe Tribes
+ \date   October 2026
+ \see    StagedEvalRejection.cpp
+ */
+#ifndef __NOMAD_4_5_STAGEDEVALREJECTION__
+#define __NOMAD_4_5_STAGEDEVALREJECTION__
+
+#include <atomic>
+#include <map>
+#include <memory>
+
+#include "../Eval/EvalTrajectory.hpp"
+#include "../Math/ArrayOfDouble.hpp"
+#include "../Type/BBOutputType.hpp"
+#include "../Type/ComputeType.hpp"
+#include "../Type/EvalType.hpp"
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Class to decide if an evaluation with staged outputs can be abandoned.
+/**
+ With parameter BB_EVAL_STAGED, the blackbox reports its outputs in stages,
+ in the order of BB_OUTPUT_TYPE. EvaluatorControl creates an object of this
+ class for each block of points, with the maximum infeasibility and the
+ feasible incumbent at that time.
+
+ After each stage, reject() tells if the point can still be a success:
+ - STANDARD and DMULTI_COMBINE_F: the point is rejected when an EB constraint
+   is violated, or when the violation of the PB constraints already read
+   exceeds hMax. With a single objective and no PB constraint, the point is
+   also rejected when its objective is not better than the incumbent's.
+ - PHASE_ONE: the point is rejected when the violation of the EB constraints
+   already read is not better than the incumbent's.
+ - USER: f and h are unknown, the point is never rejected.
+
+ With parameter BB_EVAL_MULTI_FIDELITY, the blackbox also reports estimates of
+ its outputs along its iterations. truncate() keeps the trajectory of the
+ objective estimates of each point, and tells if the evaluation is dominated by
+ the reference trajectory. Only used with a single objective and the STANDARD
+ computation of f.
+
+ The object of the block evaluated by the current thread is available through
+ getCurrent(). It is nullptr when BB_EVAL_STAGED and BB_EVAL_MULTI_FIDELITY are
+ false. It is only used by that thread.
+ */
+class DLL_EVAL_API StagedEvalRejection
+{
+private:
+    const BBOutputTypeList  _bbOutputTypeList;
+    const EvalType          _evalType;
+    const FHComputeTypeS    _computeTypeS;
+    const Double            _hMax;
+    const Double            _fIncumbent;    ///< f of the feasible incumbent. Undefined if there is none.
+    bool                    _fIsFinal;      ///< The objective read is the final f (single objective, no PB constraint).
+    size_t                  _objIndex;      ///< Index of the objective for multi-fidelity. INF_SIZE_T if not applicable.
+
+    EvalTrajectoryPtr       _refTrajectory;     ///< Trajectory of the reference evaluation. May be nullptr.
+    Double                  _truncationMargin;
+    std::map<int, EvalTrajectory> _trajectories;    ///< Trajectories of the points of the block, by tag.
+
+    std::atomic<size_t>     _nbRejected;
+
+public:
+    /// Constructor
+    /**
+     \param bbOutputTypeList    The blackbox output types -- \b IN.
+     \param evalType            The type of evaluation -- \b IN.
+     \param computeTypeS        How f and h are computed -- \b IN.
+     \param hMax                Maximum infeasibility of the barrier -- \b IN.
+     \param fIncumbent          f of the feasible incumbent, undefined if none -- \b IN.
+     */
+    StagedEvalRejection(const BBOutputTypeList& bbOutputTypeList,
+                        const EvalType evalType,
+                        const FHComputeTypeS& computeTypeS,
+                        const Double& hMax,
+                        const Double& fIncumbent);
+
+    const BBOutputTypeList& getBBOutputTypeList() const { return _bbOutputTypeList; }
+    EvalType getEvalType() const { return _evalType; }
+
+    /// Can the evaluation be abandoned, given its first outputs?
+    /**
+     \param partialBBO  The first outputs of a point, in the order of BB_OUTPUT_TYPE -- \b IN.
+     \return            \c true if the point cannot be a success.
+     */
+    bool reject(const ArrayOfDouble& partialBBO) const;
+
+    /// The outputs of a rejected evaluation: the missing outputs are set to INF.
+    std::string completeBBO(const std::string& partialBBO) const;
+
+    /// Set the trajectory of the reference evaluation, for multi-fidelity.
+    void setReferenceTrajectory(const EvalTrajectoryPtr& refTrajectory, const Double& truncationMargin);
+
+    /// Add an intermediate estimate of a point and tell if its evaluation can be stopped.
+    /**
+     \param tag         The tag of the point -- \b IN.
+     \param iteration   The iteration of the blackbox -- \b IN.
+     \param bbo         The estimate of all the outputs -- \b IN.
+     \return            \c true if the estimate is dominated by the reference trajectory.
+     */
+    bool truncate(const int tag, const size_t iteration, const ArrayOfDouble& bbo);
+
+    /// The trajectory of a point of the block. nullptr if the point has no intermediate estimate.
+    EvalTrajectoryPtr getTrajectory(const int tag) const;
+
+    /// Count a rejected evaluation. Thread-safe.
+    void countRejected() { _nbRejected++; }
+    size_t getNbRejected() const { return _nbRejected; }
+
+    /// Set the object for the evaluations done by the current thread. Use nullptr to reset.
+    static void setCurrent(const std::shared_ptr<StagedEvalRejection>& stagedEvalRejection);
+
+    /// Get the object for the evaluations done by the current thread. May be nullptr.
+    static const std::shared_ptr<StagedEvalRejection>& getCurrent();
+};
+
+typedef std::shared_ptr<StagedEvalRejection> StagedEvalRejectionPtr;
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_STAGEDEVALREJECTION__
@@ -0,0 +1,182 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   SurrogatePipeline.cpp
+ \brief  Blocks of evaluations screened by a static surrogate while the blackbox evaluates them
+ \author Christophe Tribes
+ \date   October 2026
+ \see    SurrogatePipeline.hpp
+ */
+#include "../Eval/SurrogatePipeline.hpp"
+
+#include <chrono>
+#include <thread>
+
+
+NOMAD::SurrogatePipeline::SurrogatePipeline(const size_t nbTasks, LowerPriorityFunc lowerPriority)
+  : _toScreen(),
+    _screened(),
+    _nbScreening(0),
+    _nbReordered(0),
+    _lowerPriority(std::move(lowerPriority))
+#ifdef _OPENMP
+    ,_lock("surrogatePipelineLock")
+#endif // _OPENMP
+{
+    for (size_t task = 0; task < nbTasks; task++)
+    {
+        _toScreen.push_back(task);
+    }
+}
+
+
+NOMAD::SurrogatePipeline::~SurrogatePipeline()
+{
+}
+
+
+bool NOMAD::SurrogatePipeline::popToScreen(size_t& task)
+{
+    bool popOk = false;
+#ifdef _OPENMP
+    _lock.set();
+#endif // _OPENMP
+    if (!_toScreen.empty())
+    {
+        task = _toScreen.front();
+        _toScreen.pop_front();
+        _nbScreening++;
+        popOk = true;
+    }
+#ifdef _OPENMP
+    _lock.unset();
+#endif // _OPENMP
+    return popOk;
+}
+
+
+void NOMAD::SurrogatePipeline::pushScreened(const size_t task)
+{
+#ifdef _OPENMP
+    _lock.set();
+#endif // _OPENMP
+    _screened.push_back(task);
+    _nbScreening--;
+#ifdef _OPENMP
+    _lock.unset();
+#endif // _OPENMP
+}
+
+
+bool NOMAD::SurrogatePipeline::popBest(size_t& task, const std::atomic<bool>& stop)
+{
+    while (!stop)
+    {
+        bool popOk = false, done = false;
+#ifdef _OPENMP
+        _lock.set();
+#endif // _OPENMP
+        if (!_screened.empty())
+        {
+            // Few tasks are waiting: a linear search is enough.
+            size_t iBest = 0;
+            for (size_t i = 1; i < _screened.size(); i++)
+            {
+                if (_lowerPriority(_screened[iBest], _screened[i]))
+                {
+                    iBest = i;
+                }
+            }
+            task = _screened[iBest];
+            _screened.erase(_screened.begin() + iBest);
+            for (const auto& waitingTask : _screened)
+            {
+                if (waitingTask < task)
+                {
+                    _nbReordered++;
+                    break;
+                }
+            }
+            popOk = true;
+        }
+        else
+        {
+            done = (_toScreen.empty() && 0 == _nbScreening);
+        }
+#ifdef _OPENMP
+        _lock.unset();
+#endif // _OPENMP
+
+        if (popOk)
+        {
+            return true;
+        }
+        if (done)
+        {
+            return false;
+        }
+        // Wait for a screening to complete. The wait is short compared to
+        // a blackbox evaluation.
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    return false;
+}
+
+
+size_t NOMAD::SurrogatePipeline::getNbReordered() const
+{
+    size_t nbReordered = 0;
+#ifdef _OPENMP
+    _lock.set();
+#endif // _OPENMP
+    nbReordered = _nbReordered;
+#ifdef _OPENMP
+    _lock.unset();
+#endif // _OPENMP
+    return nbReordered;
+}
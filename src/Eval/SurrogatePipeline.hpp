@@ -0,0 +1,135 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   SurrogatePipeline.hpp
+ \brief  Blocks of evaluations screened by a static surrogate while the blackbox evaluates them
+ \author Christophe Tribes
+ \date   October 2026
+ \see    SurrogatePipeline.cpp
+ */
+#ifndef __NOMAD_4_5_SURROGATEPIPELINE__
+#define __NOMAD_4_5_SURROGATEPIPELINE__
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include "../Util/InstrumentedLock.hpp"
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Two-stage pipeline of tasks (blocks of evaluations): screening, then evaluation.
+/**
+ The tasks are first given, in their order, to the screening threads (static
+ surrogate evaluations). A screened task is ranked with the other screened
+ tasks. The evaluation threads (blackbox evaluations) always take the best
+ ranked task available. A task screened later with a better rank is
+ evaluated before the tasks already waiting.
+
+ Thread-safe.
+ */
+class DLL_EVAL_API SurrogatePipeline
+{
+public:
+    /// Return true if the first task has a lower priority than the second task.
+    typedef std::function<bool(size_t, size_t)> LowerPriorityFunc;
+
+private:
+    std::deque<size_t>  _toScreen;      ///< Tasks waiting for screening, in their order
+    std::vector<size_t> _screened;      ///< Tasks screened, waiting for evaluation
+    size_t              _nbScreening;   ///< Number of tasks currently screened
+    size_t              _nbReordered;   ///< Number of tasks evaluated before a task that came before them
+    LowerPriorityFunc   _lowerPriority; ///< Rank of the screened tasks
+
+#ifdef _OPENMP
+    mutable InstrumentedLock  _lock;
+#endif // _OPENMP
+
+public:
+    /// Constructor
+    /**
+     \param nbTasks         Number of tasks, indexed from 0 to nbTasks-1 -- \b IN.
+     \param lowerPriority   Comparison of two screened tasks -- \b IN.
+     */
+    explicit SurrogatePipeline(const size_t nbTasks, LowerPriorityFunc lowerPriority);
+
+    /// Destructor
+    virtual ~SurrogatePipeline();
+
+    SurrogatePipeline(const SurrogatePipeline&) = delete;
+    SurrogatePipeline& operator=(const SurrogatePipeline&) = delete;
+
+    /// Get the next task to screen.
+    /**
+     \param task    The task index -- \b OUT.
+     \return        \c false if there are no more tasks to screen.
+     */
+    bool popToScreen(size_t& task);
+
+    /// The task is screened. It can be evaluated.
+    void pushScreened(const size_t task);
+
+    /// Get the best ranked screened task. Wait while the tasks are screened.
+    /**
+     \param task    The task index -- \b OUT.
+     \param stop    Stop waiting when true -- \b IN.
+     \return        \c false if there are no more tasks, or on stop.
+     */
+    bool popBest(size_t& task, const std::atomic<bool>& stop);
+
+    size_t getNbReordered() const;
+};
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_SURROGATEPIPELINE__
@@ -0,0 +1,166 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   WorkStealingQueue.cpp
+ \brief  Dynamic distribution of blocks of evaluations to the evaluation threads
+ \author Christophe Tribes
+ \date   October 2026
+ \see    WorkStealingQueue.hpp
+ */
+#include "../Eval/WorkStealingQueue.hpp"
+
+#include <algorithm>
+
+
+NOMAD::WorkStealingQueue::WorkStealingQueue(const size_t nbTasks, const size_t nbThreads)
+  : _deques(std::max(nbThreads, (size_t)1)),
+    _nbSteals(0)
+#ifdef _OPENMP
+    ,_locks()
+#endif // _OPENMP
+{
+    for (size_t task = 0; task < nbTasks; task++)
+    {
+        _deques[task % _deques.size()].push_back(task);
+    }
+#ifdef _OPENMP
+    for (size_t i = 0; i < _deques.size(); i++)
+    {
+        _locks.emplace_back("workStealingQueueLock");
+    }
+#endif // _OPENMP
+}
+
+
+NOMAD::WorkStealingQueue::~WorkStealingQueue()
+{
+}
+
+
+bool NOMAD::WorkStealingQueue::pop(const size_t threadNum, size_t& task)
+{
+    // The team may have less threads than requested. The deques
+    // of the missing threads are emptied by stealing.
+    if (threadNum < _deques.size() && popDeque(threadNum, true, task))
+    {
+        return true;
+    }
+
+    return steal(threadNum, task);
+}
+
+
+bool NOMAD::WorkStealingQueue::steal(const size_t threadNum, size_t& task)
+{
+    while (true)
+    {
+        // Find the longest deque. Sizes may change until the deque is locked.
+        size_t victim = _deques.size();
+        size_t maxSize = 0;
+        for (size_t i = 0; i < _deques.size(); i++)
+        {
+            if (i == threadNum)
+            {
+                continue;
+            }
+#ifdef _OPENMP
+            _locks[i].set();
+#endif // _OPENMP
+            const size_t size = _deques[i].size();
+#ifdef _OPENMP
+            _locks[i].unset();
+#endif // _OPENMP
+            if (size > maxSize)
+            {
+                maxSize = size;
+                victim = i;
+            }
+        }
+
+        if (victim == _deques.size())
+        {
+            // All deques are empty. Tasks are never added back.
+            return false;
+        }
+
+        if (popDeque(victim, false, task))
+        {
+            _nbSteals++;
+            return true;
+        }
+        // The victim was emptied in the meantime. Try again.
+    }
+}
+
+
+bool NOMAD::WorkStealingQueue::popDeque(const size_t dequeNum, const bool front, size_t& task)
+{
+    bool popped = false;
+#ifdef _OPENMP
+    _locks[dequeNum].set();
+#endif // _OPENMP
+    auto& deque = _deques[dequeNum];
+    if (!deque.empty())
+    {
+        if (front)
+        {
+            task = deque.front();
+            deque.pop_front();
+        }
+        else
+        {
+            task = deque.back();
+            deque.pop_back();
+        }
+        popped = true;
+    }
+#ifdef _OPENMP
+    _locks[dequeNum].unset();
+#endif // _OPENMP
+
+    return popped;
+}
@@ -0,0 +1,124 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   WorkStealingQueue.hpp
+ \brief  Dynamic distribution of blocks of evaluations to the evaluation threads
+ \author Christophe Tribes
+ \date   October 2026
+ \see    WorkStealingQueue.cpp
+ */
+#ifndef __NOMAD_4_5_WORKSTEALINGQUEUE__
+#define __NOMAD_4_5_WORKSTEALINGQUEUE__
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include "../Util/InstrumentedLock.hpp"
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Distribution of tasks (blocks of evaluations) to the evaluation threads.
+/**
+ Each thread has its own deque of task indices, filled round-robin in the
+ order of the tasks, that is by decreasing priority. A thread takes the tasks
+ at the front of its own deque. When its deque is empty, it steals the task
+ at the back of the longest deque of the other threads. A thread that gets
+ slow tasks thus does not delay the tasks waiting behind it.
+
+ Thread-safe.
+ */
+class DLL_EVAL_API WorkStealingQueue
+{
+private:
+    std::vector<std::deque<size_t>> _deques;    ///< Task indices, one deque per thread
+    std::atomic<size_t>             _nbSteals;  ///< Number of tasks taken from the deque of another thread
+
+#ifdef _OPENMP
+    std::deque<InstrumentedLock>    _locks;     ///< One lock per deque
+#endif // _OPENMP
+
+public:
+    /// Constructor
+    /**
+     \param nbTasks     Number of tasks, indexed from 0 to nbTasks-1 -- \b IN.
+     \param nbThreads   Number of threads -- \b IN.
+     */
+    explicit WorkStealingQueue(const size_t nbTasks, const size_t nbThreads);
+
+    /// Destructor
+    virtual ~WorkStealingQueue();
+
+    WorkStealingQueue(const WorkStealingQueue&) = delete;
+    WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+    /// Get the next task of a thread, stolen from another thread if needed.
+    /**
+     \param threadNum   The thread -- \b IN.
+     \param task        The task index -- \b OUT.
+     \return            \c false if there are no more tasks.
+     */
+    bool pop(const size_t threadNum, size_t& task);
+
+    size_t getNbSteals() const { return _nbSteals; }
+
+private:
+    /// Helper for pop(): take the task at the back of the longest deque of the other threads.
+    bool steal(const size_t threadNum, size_t& task);
+
+    /// Helper for pop(): take a task at the front or at the back of a deque.
+    bool popDeque(const size_t dequeNum, const bool front, size_t& task);
+};
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_WORKSTEALINGQUEUE__
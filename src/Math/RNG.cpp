@@ -53,8 +53,13 @@
  */
 
 #include "../Math/RNG.hpp"
+#include "../Util/InstrumentedLock.hpp"
 #include <cmath>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
 #ifdef _MSC_VER
 #include <io.h>
 #include <process.h>
@@ -74,12 +79,20 @@ uint32_t NOMAD::RNG::_x = x_def;
 uint32_t NOMAD::RNG::_y = y_def;
 uint32_t NOMAD::RNG::_z = z_def;
 
+NOMAD::RNG::StreamCounter NOMAD::RNG::_streamCounters[NOMAD::RNG::NB_STREAMS];
+
+// SplitMix64 finalizer.
+static uint64_t mix64(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
 void NOMAD::RNG::setSeed(int s)
 {
-#ifdef _OPENMP
-#pragma omp critical
-#endif
     {
+        NOMAD_CRITICAL(unnamed);
         if (s == -1)
         {
 #ifdef _MSC_VER
@@ -124,6 +137,9 @@ void NOMAD::RNG::reset()
     // Reset the private seed to default values
     resetPrivateSeedToDefault();
 
+    // The streams of the other threads restart at their first draw.
+    resetStreams();
+
     // Roll the random generator s times.
     if (!_seedSetsXDef)
     {
@@ -137,23 +153,66 @@ void NOMAD::RNG::reset()
 
 uint32_t NOMAD::RNG::rand()
 {
+    const size_t streamNum = getStreamNum();
+    if (0 != streamNum)
+    {
+        return streamRand(streamNum);
+    }
+
+    // Thread 0 only: no lock.
     // http://madrabbit.org/~ray/code/xorshf96.c //period 2^96-1
+    uint32_t t;
+    _x ^= _x << 16;
+    _x ^= _x >> 5;
+    _x ^= _x << 1;
+
+    t = _x;
+    _x = _y;
+    _y = _z;
+    _z = t ^ _x ^ _y;
+
+    return _z;
+}
+
+
+size_t NOMAD::RNG::getStreamNum()
+{
+    size_t streamNum = 0;
 #ifdef _OPENMP
-#pragma omp critical
-#endif
+    const int level = omp_get_level();
+    for (int l = 1; l <= level; l++)
+    {
+        streamNum = streamNum * MAX_THREADS_PER_LEVEL + omp_get_ancestor_thread_num(l);
+    }
+    if (streamNum >= NB_STREAMS)
     {
-        uint32_t t;
-        _x ^= _x << 16;
-        _x ^= _x >> 5;
-        _x ^= _x << 1;
-
-        t = _x;
-        _x = _y;
-        _y = _z;
-        _z = t ^ _x ^ _y;
+        // Very large or deeply nested teams. Stream 0 is kept for thread 0.
+        streamNum = 1 + streamNum % (NB_STREAMS - 1);
     }
+#endif // _OPENMP
+    return streamNum;
+}
 
-    return _z;
+
+NOMAD::RNG::result_type NOMAD::RNG::streamRand(const size_t streamNum)
+{
+    // The counter is atomic in case two threads share a stream.
+    const uint64_t n = _streamCounters[streamNum]._n.fetch_add(1, std::memory_order_relaxed);
+
+    // Key of the stream, from the seed and the stream number.
+    const uint64_t seed = (static_cast<uint64_t>(x_def) << 32) | static_cast<uint32_t>(_s);
+    const uint64_t key = mix64(seed ^ mix64(streamNum));
+
+    return static_cast<result_type>(mix64(key + n * 0x9e3779b97f4a7c15ULL) >> 32);
+}
+
+
+void NOMAD::RNG::resetStreams()
+{
+    for (auto& streamCounter : _streamCounters)
+    {
+        streamCounter._n = 0;
+    }
 }
 
 /*----------------------------------------*/
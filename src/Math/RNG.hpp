@@ -55,8 +55,11 @@
 #ifndef __NOMAD_4_5_RNG__
 #define __NOMAD_4_5_RNG__
 
+#include <atomic>
+
 #include "../Util/defines.hpp"
 #include "../Util/Exception.hpp"
+#include "../Util/InstrumentedLock.hpp"
 
 using namespace std;
 
@@ -67,6 +70,14 @@ using namespace std;
 /**
 This class is used to set a seed for the random number generator and get a random integer or a random double between two values. \n
  http://madrabbit.org/~ray/code/xorshf96.c with period 2^96-1
+
+ Thread 0 (at every level of nested parallel regions) draws from this
+ generator. The other OpenMP threads each draw from their own stream, without
+ locking. A stream is counter-based: the n-th draw of a stream is a hash of
+ the seed, of the stream number and of n. The stream number is given by the
+ position of the thread in the team and in the enclosing teams. The draws of a
+ thread thus do not depend on the interleaving with the other threads.
+ The private seed (getPrivateSeed(), setPrivateSeed()) is the state of thread 0.
  */
 class RNG
 {
@@ -150,10 +161,8 @@ public:
     /// Reset seed to its default value
     static void resetPrivateSeedToDefault()
     {
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-        {            
+        {
+            NOMAD_CRITICAL(unnamed);
             _x = x_def;
             _y = y_def;
             _z = z_def;
@@ -180,10 +189,8 @@ public:
      */
     static void setPrivateSeed(uint32_t x, uint32_t y, uint32_t z)
     {
-#ifdef _OPENMP
-#pragma omp critical
-#endif
         {
+            NOMAD_CRITICAL(unnamed);
             _x = x;
             _y = y;
             _z = z;
@@ -199,10 +206,8 @@ public:
         istringstream ss(private_seeds);
         uint32_t ps;
         ss >> ps;
-#ifdef _OPENMP
-#pragma omp critical
-#endif
         {
+            NOMAD_CRITICAL(unnamed);
             if (ps <= UINT32_MAX)
                 _x = ps;
             ss >> ps;
@@ -221,6 +226,25 @@ private:
     DLL_UTIL_API static int _s;
     
     DLL_UTIL_API static bool _seedSetsXDef;
+
+    static constexpr size_t NB_STREAMS = 1024;          ///< Number of streams for threads other than 0
+    static constexpr size_t MAX_THREADS_PER_LEVEL = 32; ///< Base used to number the streams of nested threads
+
+    /// Counter of a stream. Padded to avoid false sharing between threads.
+    struct alignas(64) StreamCounter
+    {
+        std::atomic<uint64_t> _n{0};
+    };
+    DLL_UTIL_API static StreamCounter _streamCounters[NB_STREAMS];
+
+    /// Stream of the current thread. 0 for thread 0 at every level.
+    static size_t getStreamNum();
+
+    /// Next draw in the stream of a thread other than 0.
+    static result_type streamRand(const size_t streamNum);
+
+    /// Reset the counters of the streams.
+    static void resetStreams();
 };
 
 #include "../nomad_nsend.hpp"
@@ -0,0 +1,442 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   BinaryHistory.cpp
+ \brief  Binary columnar history file (parameter HISTORY_FILE_BINARY)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    BinaryHistory.hpp
+ */
+#include "../Output/BinaryHistory.hpp"
+#include "../Util/MicroSleep.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+
+const char NOMAD::BinaryHistoryFormat::MAGIC[8] = {'N','O','M','A','D','H','S','T'};
+const uint32_t NOMAD::BinaryHistoryFormat::VERSION = 1;
+const size_t NOMAD::BinaryHistoryFormat::HEADER_SIZE = 8 + 4 * sizeof(uint32_t);
+const size_t NOMAD::BinaryHistoryFormat::DEFAULT_BLOCK_SIZE = 1024;
+
+// Number of blocks waiting for the writer thread. When it is reached, add() waits.
+static const size_t NB_BLOCKS_IN_QUEUE = 8;
+
+
+// Helpers to write and read native binary values.
+namespace
+{
+    template<typename T>
+    void writeValue(std::ofstream& out, const T& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool readValue(std::ifstream& in, T& value)
+    {
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return !in.fail();
+    }
+}
+
+
+//
+// BinaryHistoryWriter
+//
+NOMAD::BinaryHistoryWriter::BinaryHistoryWriter(const size_t blockSize)
+  : _fileName(),
+    _stream(),
+    _blockSize(std::max(blockSize, (size_t)1)),
+    _nbSolColumns(0),
+    _nbBBOColumns(0),
+    _hasColumns(false),
+    _headerWritten(false),
+    _currentBlock(),
+    _nbBlocks(0),
+    _ringBuffer(),
+    _writer(),
+    _stopWriter(false),
+    _nbPushed(0),
+    _nbWritten(0)
+{
+}
+
+
+NOMAD::BinaryHistoryWriter::~BinaryHistoryWriter()
+{
+    close();
+}
+
+
+bool NOMAD::BinaryHistoryWriter::open(const std::string& fileName)
+{
+    close();
+
+    _stream.open(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (_stream.fail())
+    {
+        return false;
+    }
+
+    _fileName = fileName;
+    _hasColumns = false;
+    _headerWritten = false;
+    _currentBlock.reset();
+    _nbBlocks = 0;
+    _nbPushed = 0;
+    _nbWritten = 0;
+
+    _ringBuffer.reset(new NOMAD::RingBuffer<BlockUPtr>(NB_BLOCKS_IN_QUEUE));
+    _stopWriter = false;
+    _writer = std::thread(&NOMAD::BinaryHistoryWriter::writerLoop, this);
+
+    return true;
+}
+
+
+void NOMAD::BinaryHistoryWriter::add(const NOMAD::Point& x, const std::string& bbo)
+{
+    if (!isOpen())
+    {
+        return;
+    }
+
+    // Blackbox outputs that are not numbers are NaN.
+    std::vector<double> bboValues;
+    std::istringstream iss(bbo);
+    std::string token;
+    while (iss >> token)
+    {
+        char* end = nullptr;
+        const double value = std::strtod(token.c_str(), &end);
+        bboValues.push_back((end != token.c_str() && '\0' == *end) ? value : std::numeric_limits<double>::quiet_NaN());
+    }
+
+    if (!_hasColumns)
+    {
+        _nbSolColumns = x.size();
+        _nbBBOColumns = bboValues.size();
+        _hasColumns = true;
+    }
+
+    if (nullptr == _currentBlock)
+    {
+        newBlock();
+    }
+
+    const size_t r = _currentBlock->_nbRecords;
+    double* values = _currentBlock->_values.data();
+    for (size_t i = 0; i < _nbSolColumns && i < x.size(); i++)
+    {
+        values[i * _blockSize + r] = x[i].isDefined() ? x[i].todouble() : std::numeric_limits<double>::quiet_NaN();
+    }
+    for (size_t i = 0; i < _nbBBOColumns && i < bboValues.size(); i++)
+    {
+        values[(_nbSolColumns + i) * _blockSize + r] = bboValues[i];
+    }
+    _currentBlock->_nbRecords++;
+
+    if (_currentBlock->_nbRecords >= _blockSize)
+    {
+        pushBlock(std::move(_currentBlock));
+    }
+}
+
+
+void NOMAD::BinaryHistoryWriter::flush()
+{
+    if (!isOpen())
+    {
+        return;
+    }
+
+    if (nullptr != _currentBlock && _currentBlock->_nbRecords > 0)
+    {
+        // Write a copy of the partial block. It is written again at the same
+        // place when it is complete.
+        pushBlock(BlockUPtr(new Block(*_currentBlock)));
+    }
+
+    const size_t nbPushed = _nbPushed.load();
+    while (_nbWritten.load() < nbPushed)
+    {
+        usleep(50);
+    }
+}
+
+
+void NOMAD::BinaryHistoryWriter::close()
+{
+    if (!isOpen())
+    {
+        return;
+    }
+
+    flush();
+
+    _stopWriter = true;
+    if (_writer.joinable())
+    {
+        _writer.join();
+    }
+    _ringBuffer.reset();
+    _currentBlock.reset();
+
+    if (!_headerWritten)
+    {
+        // No record: the file has only a header.
+        writeHeader();
+    }
+    _stream.close();
+    _fileName.clear();
+}
+
+
+void NOMAD::BinaryHistoryWriter::newBlock()
+{
+    _currentBlock.reset(new Block());
+    _currentBlock->_index = _nbBlocks++;
+    _currentBlock->_nbRecords = 0;
+    _currentBlock->_values.assign((_nbSolColumns + _nbBBOColumns) * _blockSize,
+                                  std::numeric_limits<double>::quiet_NaN());
+}
+
+
+void NOMAD::BinaryHistoryWriter::pushBlock(BlockUPtr block)
+{
+    // The writer thread is slower than the evaluations: wait for room.
+    while (!_ringBuffer->tryPush(std::move(block)))
+    {
+        usleep(50);
+    }
+    _nbPushed++;
+}
+
+
+void NOMAD::BinaryHistoryWriter::writerLoop()
+{
+    BlockUPtr block;
+    while (true)
+    {
+        // Read the stop flag before emptying the queue, so that a block pushed
+        // before the stop request is written.
+        const bool stop = _stopWriter.load();
+        bool popped = false;
+        while (_ringBuffer->tryPop(block))
+        {
+            popped = true;
+            writeBlock(*block);
+            block.reset();
+            _nbWritten++;
+        }
+        if (popped)
+        {
+            _stream.flush();
+        }
+        else if (stop)
+        {
+            break;
+        }
+        else
+        {
+            usleep(200);
+        }
+    }
+}
+
+
+void NOMAD::BinaryHistoryWriter::writeBlock(const Block& block)
+{
+    if (!_headerWritten)
+    {
+        writeHeader();
+    }
+
+    const size_t nbColumns = _nbSolColumns + _nbBBOColumns;
+    _stream.seekp(NOMAD::BinaryHistoryFormat::HEADER_SIZE
+                  + block._index * NOMAD::BinaryHistoryFormat::blockBytes(nbColumns, _blockSize));
+    writeValue<uint64_t>(_stream, block._nbRecords);
+    _stream.write(reinterpret_cast<const char*>(block._values.data()),
+                  block._values.size() * sizeof(double));
+    if (_stream.fail())
+    {
+        std::cerr << "Warning: could not write binary history file " << _fileName << std::endl;
+        _stream.clear();
+    }
+}
+
+
+void NOMAD::BinaryHistoryWriter::writeHeader()
+{
+    _stream.seekp(0);
+    _stream.write(NOMAD::BinaryHistoryFormat::MAGIC, sizeof(NOMAD::BinaryHistoryFormat::MAGIC));
+    writeValue<uint32_t>(_stream, NOMAD::BinaryHistoryFormat::VERSION);
+    writeValue<uint32_t>(_stream, static_cast<uint32_t>(_nbSolColumns));
+    writeValue<uint32_t>(_stream, static_cast<uint32_t>(_nbBBOColumns));
+    writeValue<uint32_t>(_stream, static_cast<uint32_t>(_blockSize));
+    _headerWritten = true;
+}
+
+
+//
+// BinaryHistoryReader
+//
+NOMAD::BinaryHistoryReader::BinaryHistoryReader()
+  : _stream(),
+    _nbSolColumns(0),
+    _nbBBOColumns(0),
+    _blockSize(0),
+    _nbRecords(0)
+{
+}
+
+
+bool NOMAD::BinaryHistoryReader::open(const std::string& fileName, std::string& errMsg)
+{
+    _stream.close();
+    _stream.open(fileName.c_str(), std::ios::in | std::ios::binary);
+    if (_stream.fail())
+    {
+        errMsg = "cannot open file " + fileName;
+        return false;
+    }
+
+    char magic[sizeof(NOMAD::BinaryHistoryFormat::MAGIC)];
+    uint32_t version = 0, nbSolColumns = 0, nbBBOColumns = 0, blockSize = 0;
+    _stream.read(magic, sizeof(magic));
+    if (_stream.fail() || 0 != std::memcmp(magic, NOMAD::BinaryHistoryFormat::MAGIC, sizeof(magic)))
+    {
+        errMsg = fileName + " is not a binary history file";
+        return false;
+    }
+    if (!readValue(_stream, version) || !readValue(_stream, nbSolColumns)
+        || !readValue(_stream, nbBBOColumns) || !readValue(_stream, blockSize))
+    {
+        errMsg = "cannot read the header of " + fileName;
+        return false;
+    }
+    if (NOMAD::BinaryHistoryFormat::VERSION != version)
+    {
+        errMsg = fileName + " has version " + std::to_string(version) + " of the format. Expected version is "
+                 + std::to_string(NOMAD::BinaryHistoryFormat::VERSION);
+        return false;
+    }
+    _nbSolColumns = nbSolColumns;
+    _nbBBOColumns = nbBBOColumns;
+    _blockSize = blockSize;
+    _nbRecords = 0;
+
+    // Only the last complete block may be partial.
+    _stream.seekg(0, std::ios::end);
+    const size_t fileSize = static_cast<size_t>(_stream.tellg());
+    const size_t blockBytes = NOMAD::BinaryHistoryFormat::blockBytes(getNbColumns(), _blockSize);
+    const size_t nbBlocks = (fileSize > NOMAD::BinaryHistoryFormat::HEADER_SIZE)
+                            ? (fileSize - NOMAD::BinaryHistoryFormat::HEADER_SIZE) / blockBytes : 0;
+    if (nbBlocks > 0 && _blockSize > 0)
+    {
+        uint64_t nbRecordsLastBlock = 0;
+        _stream.seekg(NOMAD::BinaryHistoryFormat::HEADER_SIZE + (nbBlocks - 1) * blockBytes);
+        if (!readValue(_stream, nbRecordsLastBlock) || nbRecordsLastBlock > _blockSize)
+        {
+            errMsg = "cannot read the last block of " + fileName;
+            return false;
+        }
+        _nbRecords = (nbBlocks - 1) * _blockSize + nbRecordsLastBlock;
+    }
+
+    return true;
+}
+
+
+bool NOMAD::BinaryHistoryReader::read(const size_t first,
+                                      size_t count,
+                                      const std::vector<size_t>& columns,
+                                      std::vector<std::vector<double>>& values)
+{
+    count = (first < _nbRecords) ? std::min(count, _nbRecords - first) : 0;
+
+    values.assign(columns.size(), std::vector<double>(count));
+    if (0 == count)
+    {
+        return true;
+    }
+
+    const size_t blockBytes = NOMAD::BinaryHistoryFormat::blockBytes(getNbColumns(), _blockSize);
+    size_t r = 0;
+    while (r < count)
+    {
+        // Records of this block in the slice.
+        const size_t record = first + r;
+        const size_t blockIndex = record / _blockSize;
+        const size_t posInBlock = record % _blockSize;
+        const size_t nbInBlock = std::min(_blockSize - posInBlock, count - r);
+        const size_t blockStart = NOMAD::BinaryHistoryFormat::HEADER_SIZE + blockIndex * blockBytes + sizeof(uint64_t);
+
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            if (columns[i] >= getNbColumns())
+            {
+                return false;
+            }
+            _stream.clear();
+            _stream.seekg(blockStart + (columns[i] * _blockSize + posInBlock) * sizeof(double));
+            _stream.read(reinterpret_cast<char*>(&values[i][r]), nbInBlock * sizeof(double));
+            if (_stream.fail())
+            {
+                return false;
+            }
+        }
+        r += nbInBlock;
+    }
+
+    return true;
+}
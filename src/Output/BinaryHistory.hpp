@@ -0,0 +1,239 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   BinaryHistory.hpp
+ \brief  Binary columnar history file (parameter HISTORY_FILE_BINARY)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    BinaryHistory.cpp
+ */
+#ifndef __NOMAD_4_5_BINARYHISTORY__
+#define __NOMAD_4_5_BINARYHISTORY__
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Math/Point.hpp"
+#include "../Util/RingBuffer.hpp"
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Layout of the binary history file.
+/**
+ The file starts with a header:
+ - 8 chars: "NOMADHST"
+ - uint32: version of the format
+ - uint32: number of SOL columns (n)
+ - uint32: number of BBO columns (m)
+ - uint32: number of records in a block (blockSize)
+
+ It is followed by blocks of records, all of the same size:
+ - uint64: number of records in this block. Only the last block may be partial.
+ - n + m columns, each of blockSize doubles: the first column holds the first
+   coordinate of all the records of the block, and so on. The BBO columns come
+   after the SOL columns. The unused slots of a partial block, undefined values
+   and the blackbox outputs that are not numbers are NaN.
+
+ Record r is in block r / blockSize, so a slice of records or columns is read
+ without reading the whole file. The values are in the native binary
+ representation: the file is not portable between platforms.
+ */
+class DLL_UTIL_API BinaryHistoryFormat
+{
+public:
+    static const char       MAGIC[8];
+    static const uint32_t   VERSION;
+    static const size_t     HEADER_SIZE;    ///< Size of the header, in bytes
+    static const size_t     DEFAULT_BLOCK_SIZE;
+
+    /// Size of a block, in bytes.
+    static size_t blockBytes(const size_t nbColumns, const size_t blockSize)
+    {
+        return sizeof(uint64_t) + nbColumns * blockSize * sizeof(double);
+    }
+};
+
+
+/// Writer of a binary history file.
+/**
+ The records are added in the current block. A full block is handed to a
+ background thread that writes it: the thread that adds a record does not wait
+ for the file.
+
+ The numbers of columns are set by the first record. The blackbox outputs of
+ the next records are truncated or completed with NaN to the same number of
+ columns.
+
+ add() and flush() are not thread-safe: OutputDirectToFile calls them under its lock.
+ */
+class DLL_UTIL_API BinaryHistoryWriter
+{
+private:
+    /// Block of records, by column.
+    struct Block
+    {
+        size_t              _index;     ///< Position of the block in the file
+        size_t              _nbRecords;
+        std::vector<double> _values;    ///< Value of column c for record r is _values[c * blockSize + r]
+    };
+    typedef std::unique_ptr<Block> BlockUPtr;
+
+    std::string             _fileName;
+    std::ofstream           _stream;        ///< Access by the writer thread only, when it runs
+    size_t                  _blockSize;
+    size_t                  _nbSolColumns;
+    size_t                  _nbBBOColumns;
+    bool                    _hasColumns;    ///< The numbers of columns are set by the first record
+    bool                    _headerWritten; ///< Access by the writer thread only, when it runs
+
+    BlockUPtr               _currentBlock;  ///< Block receiving the records
+    size_t                  _nbBlocks;      ///< Number of blocks started
+
+    std::unique_ptr<RingBuffer<BlockUPtr>>  _ringBuffer;    ///< Blocks to write
+    std::thread             _writer;
+    std::atomic<bool>       _stopWriter;
+    std::atomic<size_t>     _nbPushed;      ///< Number of blocks given to the writer thread
+    std::atomic<size_t>     _nbWritten;     ///< Number of blocks written by the writer thread
+
+public:
+    /// Constructor
+    /**
+     \param blockSize   Number of records in a block -- \b IN.
+     */
+    explicit BinaryHistoryWriter(const size_t blockSize = BinaryHistoryFormat::DEFAULT_BLOCK_SIZE);
+
+    /// Destructor. The file is closed.
+    virtual ~BinaryHistoryWriter();
+
+    BinaryHistoryWriter(const BinaryHistoryWriter&) = delete;
+    BinaryHistoryWriter& operator=(const BinaryHistoryWriter&) = delete;
+
+    /// Create the file, and start the writer thread.
+    /**
+     \param fileName    The file name. An existing file is overwritten -- \b IN.
+     \return            \c false if the file cannot be opened.
+     */
+    bool open(const std::string& fileName);
+
+    bool isOpen() const { return !_fileName.empty(); }
+
+    /// Add a record.
+    /**
+     \param x       The evaluated point -- \b IN.
+     \param bbo     The blackbox outputs, as given by the blackbox -- \b IN.
+     */
+    void add(const Point& x, const std::string& bbo);
+
+    /// Write the records added, and wait until they are in the file.
+    void flush();
+
+    /// Write the records added and close the file.
+    void close();
+
+private:
+    void newBlock();
+    void pushBlock(BlockUPtr block);
+    void writerLoop();
+    void writeBlock(const Block& block);
+    void writeHeader();
+};
+
+
+/// Reader of a binary history file.
+class DLL_UTIL_API BinaryHistoryReader
+{
+private:
+    std::ifstream   _stream;
+    size_t          _nbSolColumns;
+    size_t          _nbBBOColumns;
+    size_t          _blockSize;
+    size_t          _nbRecords;
+
+public:
+    /// Constructor
+    BinaryHistoryReader();
+
+    /// Open the file and read its header.
+    /**
+     The records of an incomplete block at the end of the file (for example
+     when the run was killed while writing) are ignored.
+     \param fileName    The file name -- \b IN.
+     \param errMsg      The reason of a failure -- \b OUT.
+     \return            \c false if the file is not a binary history file.
+     */
+    bool open(const std::string& fileName, std::string& errMsg);
+
+    size_t getNbSolColumns() const { return _nbSolColumns; }
+    size_t getNbBBOColumns() const { return _nbBBOColumns; }
+    size_t getNbColumns() const { return _nbSolColumns + _nbBBOColumns; }
+    size_t getBlockSize() const { return _blockSize; }
+    size_t getNbRecords() const { return _nbRecords; }
+
+    /// Read some columns of a slice of records.
+    /**
+     Only the blocks of the slice, and in them only the given columns, are read.
+     \param first       Index of the first record -- \b IN.
+     \param count       Number of records. Reduced to the number of records available -- \b IN.
+     \param columns     Indexes of the columns. The BBO columns follow the SOL columns -- \b IN.
+     \param values      values[i][r] is the value of columns[i] for record first + r -- \b OUT.
+     \return            \c false if the file cannot be read.
+     */
+    bool read(const size_t first,
+              size_t count,
+              const std::vector<size_t>& columns,
+              std::vector<std::vector<double>>& values);
+};
+
+#include "../nomad_nsend.hpp"
+
+#endif // __NOMAD_4_5_BINARYHISTORY__
@@ -51,7 +51,7 @@
 
 // Static members initialization
 #ifdef _OPENMP
-omp_lock_t NOMAD::OutputDirectToFile::_s_output_lock;
+NOMAD::InstrumentedLock NOMAD::OutputDirectToFile::_s_output_lock("s_output_lock");
 #endif // _OPENMP
 
 std::unique_ptr<NOMAD::OutputDirectToFile> NOMAD::OutputDirectToFile::_single(nullptr);
@@ -64,6 +64,8 @@ NOMAD::OutputDirectToFile::OutputDirectToFile()
     _outputFileFormat(DisplayStatsTypeList("SOL BBO")),
     _solutionFile(),
     _historyFile(),
+    _historyBinary(false),
+    _historyBinaryWriter(),
     _enabledSolutionFile(true)
 {
 }
@@ -73,12 +75,10 @@ NOMAD::OutputDirectToFile::OutputDirectToFile()
 NOMAD::OutputDirectToFile::~OutputDirectToFile()
 {
 
-#ifdef _OPENMP
-    omp_destroy_lock(&_s_output_lock);
-#endif // _OPENMP
     if (!_historyFile.empty())
     {
         _historyStream.close();
+        _historyBinaryWriter.close();
     }
     if (!_solutionFile.empty())
     {
@@ -91,19 +91,12 @@ NOMAD::OutputDirectToFile::~OutputDirectToFile()
 // Access to singleton
 std::unique_ptr<NOMAD::OutputDirectToFile>& NOMAD::OutputDirectToFile::getInstance()
 {
-#ifdef _OPENMP
-    #pragma omp critical(initODTFLock)
     {
-#endif // _OPENMP
+        NOMAD_CRITICAL(initODTFLock);
         if (nullptr == _single)
         {
-#ifdef _OPENMP
-            omp_init_lock(&_s_output_lock);
-#endif // _OPENMP
             _single = std::unique_ptr<OutputDirectToFile> (new OutputDirectToFile());
-#ifdef _OPENMP
         }
-#endif // _OPENMP
     } // end of critical section
 
     return _single;
@@ -127,6 +120,7 @@ void NOMAD::OutputDirectToFile::init(const std::shared_ptr<NOMAD::DisplayParamet
        throw NOMAD::Exception(__FILE__, __LINE__, "OutputQueue::initParameters: Initialization cannot be performed more than once with the same history_file. The history file will be overwritten! Call OutputDirectToFile::getInstance()->reset() to allow this.");
     }
     _historyFile = historyFileTmp;
+    _historyBinary = params->getAttributeValue<bool>("HISTORY_FILE_BINARY");
     _solutionFile = params->getAttributeValue<std::string>("SOLUTION_FILE");
     _outputSize = params->getAttributeValue<NOMAD::ArrayOfDouble>("SOL_FORMAT").size();
 
@@ -136,6 +130,18 @@ void NOMAD::OutputDirectToFile::init(const std::shared_ptr<NOMAD::DisplayParamet
 }
 
 
+void NOMAD::OutputDirectToFile::flushHistoryFile()
+{
+#ifdef _OPENMP
+    _s_output_lock.set();
+#endif // _OPENMP
+    _historyBinaryWriter.flush();
+#ifdef _OPENMP
+    _s_output_lock.unset();
+#endif // _OPENMP
+}
+
+
 bool NOMAD::OutputDirectToFile::goodToWrite() const
 {
     return ( !_historyFile.empty() || !_solutionFile.empty());
@@ -143,10 +149,20 @@ bool NOMAD::OutputDirectToFile::goodToWrite() const
 
 void NOMAD::OutputDirectToFile::initHistoryFile()
 {
-    if (!_historyFile.empty())
+    _historyStream.close();
+    _historyBinaryWriter.close();
+
+    if (!_historyFile.empty() && _historyBinary)
+    {
+        // Open binary history file and clear it
+        if (!_historyBinaryWriter.open(_historyFile))
+        {
+            std::cout << "Warning: could not open history file " << _historyFile << std::endl;
+        }
+    }
+    else if (!_historyFile.empty())
     {
         // Open history file and clear it (trunc)
-        _historyStream.close();
         _historyStream.open(_historyFile.c_str(), std::ofstream::out | std::ios::trunc);
         if (_historyStream.fail())
         {
@@ -174,13 +190,17 @@ void NOMAD::OutputDirectToFile::write(const NOMAD::StatsInfo &info, bool writeIn
 
 #ifdef _OPENMP
     // Lock queue before writing in file
-    omp_set_lock(&_s_output_lock);
+    _s_output_lock.set();
 #endif
 
     NOMAD::ArrayOfDouble solFormatStats(_outputSize, NOMAD::DISPLAY_PRECISION_FULL);
 
     // Add information in history file.
-    if (writeInHistoryFile)
+    if (writeInHistoryFile && _historyBinary)
+    {
+        _historyBinaryWriter.add(info.getSol(), info.getBBO());
+    }
+    else if (writeInHistoryFile)
     {
         _historyStream << info.display(_outputFileFormat, solFormatStats, 0, 0, false, false) << std::endl;
     }
@@ -212,7 +232,7 @@ void NOMAD::OutputDirectToFile::write(const NOMAD::StatsInfo &info, bool writeIn
     }
 
 #ifdef _OPENMP
-    omp_unset_lock(&_s_output_lock);
+    _s_output_lock.unset();
 #endif // _OPENMP
 
 }
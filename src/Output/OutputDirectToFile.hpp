@@ -53,8 +53,10 @@
 #endif // _OPENMP
 
 #include "../Param/DisplayParameters.hpp"
+#include "../Output/BinaryHistory.hpp"
 #include "../Output/OutputInfo.hpp"
 #include "../Output/StatsInfo.hpp"
+#include "../Util/InstrumentedLock.hpp"
 
 #include "../nomad_platform.hpp"
 #include "../nomad_nsbegin.hpp"
@@ -88,6 +90,9 @@ public:
         getInstance()->write(outInfo,writeInSolutionFile,writeInHistoryFile,appendInSolutionFile);
     }
 
+    /// Write the records of the binary history file that are still in memory.
+    void flushHistoryFile();
+
     /// Good to write in history and/or solution files when the file names have been defined.
     bool goodToWrite() const;
     static bool GoodToWrite()
@@ -119,7 +124,7 @@ private:
     // NOTE It does not seem relevant for the lock to be static,
     // because OutputDirectToFile is a singleton anyway. If staticity causes problems,
     // we could remove the static keyword.
-    static omp_lock_t  _s_output_lock;
+    static InstrumentedLock  _s_output_lock;
 #endif // _OPENMP
 
     /// Helper for init
@@ -143,6 +148,8 @@ private:
 
     std::string                     _historyFile;
     std::ofstream                   _historyStream;
+    bool                            _historyBinary;         ///< Write the history file with _historyBinaryWriter (HISTORY_FILE_BINARY)
+    BinaryHistoryWriter             _historyBinaryWriter;
 
     /// Even if solution file is provided we can temporarily disable solution file (PhaseOne)
     bool                            _enabledSolutionFile;
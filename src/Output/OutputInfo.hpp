@@ -47,6 +47,7 @@
 #ifndef __NOMAD_4_5_OUTPUTINFO__
 #define __NOMAD_4_5_OUTPUTINFO__
 
+#include <functional>
 #include <vector>
 #include "../Output/StatsInfo.hpp"
 
@@ -69,6 +70,9 @@ enum class OutputLevel {
 };
 
 
+/// Function building a message when it is written (deferred formatting).
+typedef std::function<std::string()> OutputMsgFormatter;
+
 /**
  All information that may be useful for one output.
 Used by OutputQueue.
@@ -77,7 +81,8 @@ class OutputInfo
 {
 private:
     std::string          _originator;
-    ArrayOfString        _msg;
+    mutable ArrayOfString        _msg;
+    mutable OutputMsgFormatter   _msgFormatter;  ///< Deferred first message, built by getMsg()
     OutputLevel          _outputLevel;
     bool                 _blockStart;
     bool                 _blockEnd;
@@ -97,6 +102,26 @@ public:
         {
             _msg.add(msg);
         }
+
+    /// Constructor with a deferred message.
+    /**
+     The message is built by msgFormatter only when it is written, for example
+     never for LEVEL_STATS output information. The values used by msgFormatter
+     must be captured by copy (a shared pointer to a point is cheap), because
+     the message may be built after the caller returns.
+     */
+    explicit OutputInfo(const std::string& originator, OutputMsgFormatter msgFormatter,
+                        OutputLevel outputLevel = OutputLevel::LEVEL_INFO,
+                        bool blockStart = false, bool blockEnd = false)
+      : _originator(originator),
+        _msg(),
+        _msgFormatter(std::move(msgFormatter)),
+        _outputLevel(outputLevel),
+        _blockStart(blockStart),
+        _blockEnd(blockEnd),
+        _statsInfo()
+        {
+        }
     // Do not specify destructor, so that default is used for destructor, move, copy.
     // virtual ~OutputInfo() {}
 
@@ -106,7 +131,22 @@ public:
     const std::string& getOriginator() const { return _originator; }
     void setOriginator(const std::string& originator) { _originator = originator; }
 
-    const ArrayOfString& getMsg() const { return _msg; }
+    const ArrayOfString& getMsg() const
+    {
+        if (_msgFormatter)
+        {
+            // Build the deferred message. It comes before the messages added by addMsg().
+            ArrayOfString msg;
+            msg.add(_msgFormatter());
+            for (size_t i = 0; i < _msg.size(); i++)
+            {
+                msg.add(_msg[i]);
+            }
+            _msg = std::move(msg);
+            _msgFormatter = nullptr;
+        }
+        return _msg;
+    }
     void addMsg(const std::string& msg) { _msg.add(msg); }
 
     const OutputLevel& getOutputLevel() const { return _outputLevel; }
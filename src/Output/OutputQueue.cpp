@@ -45,13 +45,15 @@
 /*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
 /*---------------------------------------------------------------------------------*/
 
+#include <algorithm>
 #include <fstream>
 #include "../Output/OutputQueue.hpp"
 #include "../Util/Exception.hpp"
+#include "../Util/MicroSleep.hpp"
 
 // Static members initialization
 #ifdef _OPENMP
-omp_lock_t NOMAD::OutputQueue::_s_queue_lock;
+NOMAD::InstrumentedLock NOMAD::OutputQueue::_s_queue_lock("s_queue_lock");
 #endif // _OPENMP
 
 std::unique_ptr<NOMAD::OutputQueue> NOMAD::OutputQueue::_single(nullptr);
@@ -61,11 +63,19 @@ bool NOMAD::OutputQueue::_hasBeenInitialized = false;
 // Private constructor
 NOMAD::OutputQueue::OutputQueue()
   : _queue(),
+    _async(false),
+    _ringBuffer(),
+    _writer(),
+    _stopWriter(false),
+    _nbAdded(0),
+    _nbWritten(0),
+    _nbDropped(0),
     _params(),
     _statsFile(),
     _statsWritten(false),
     _totalEval(0),
     _statsFileFormat(),
+    _usedStatsTypes(static_cast<size_t>(NOMAD::DisplayStatsType::DS_UNDEFINED) + 1, true),
     _statsLineCount(0),
     _objWidth(),
     _hWidth(),
@@ -81,6 +91,8 @@ NOMAD::OutputQueue::OutputQueue()
 // Destructor
 NOMAD::OutputQueue::~OutputQueue()
 {
+    stopWriter();
+
     // Always flush on destruction. In fact, the queue should be
     // empty at this point.
     if (! _queue.empty())
@@ -88,15 +100,12 @@ NOMAD::OutputQueue::~OutputQueue()
         //std::cerr << "Calling destructor on a non-empty OutputQueue." << std::endl;
         flush();
     }
-#ifdef _OPENMP
-    omp_destroy_lock(&_s_queue_lock);
-#endif // _OPENMP
     // Close stats file
     if (!_statsFile.empty())
     {
         if (!_statsWritten)
         {
-            _statsStream << "no feasible solution has been found after " << NOMAD::itos(_totalEval) << " evaluations" << std::endl;
+            _statsStream << "no feasible solution has been found after " << NOMAD::itos(_totalEval.load()) << " evaluations" << std::endl;
         }
         _statsStream.close();
     }
@@ -106,13 +115,14 @@ void NOMAD::OutputQueue::reset()
 {
     // Flush the queue
     flush();
+    stopWriter();
 
     // Close stats file
     if (!_statsFile.empty())
     {
         if (!_statsWritten)
         {
-            _statsStream << "no feasible solution has been found after " << NOMAD::itos(_totalEval) << " evaluations" << std::endl;
+            _statsStream << "no feasible solution has been found after " << NOMAD::itos(_totalEval.load()) << " evaluations" << std::endl;
         }
         _statsStream.close();
     }
@@ -125,20 +135,13 @@ void NOMAD::OutputQueue::reset()
 // Access to singleton
 std::unique_ptr<NOMAD::OutputQueue>& NOMAD::OutputQueue::getInstance()
 {
-#ifdef _OPENMP
-    #pragma omp critical(initOutputQueueLock)
     {
-#endif // _OPENMP
+        NOMAD_CRITICAL(initOutputQueueLock);
         if (nullptr == _single)
         {
-#ifdef _OPENMP
-            omp_init_lock(&_s_queue_lock);
-#endif // _OPENMP
             _single = std::unique_ptr<OutputQueue> (new OutputQueue());
         }
-#ifdef _OPENMP
     } // end of critical section
-#endif // _OPENMP
 
     return _single;
 }
@@ -187,6 +190,23 @@ void NOMAD::OutputQueue::initParameters(const std::shared_ptr<NOMAD::DisplayPara
     initStatsFile();
     setStatsFileFormat(statsFileFormat);
 
+    // Stats types to fill in the StatsInfo of each evaluation.
+    std::fill(_usedStatsTypes.begin(), _usedStatsTypes.end(), false);
+    for (const auto& format : { _params->getAttributeValue<NOMAD::ArrayOfString>("DISPLAY_STATS"), statsFileFormat })
+    {
+        for (size_t i = 0; i < format.size(); i++)
+        {
+            std::string doubleFormat;
+            const auto statsType = NOMAD::StatsInfo::stringToDisplayStatsType(format[i], doubleFormat);
+            _usedStatsTypes[static_cast<size_t>(statsType)] = true;
+        }
+    }
+
+    if (_params->getAttributeValue<bool>("DISPLAY_ASYNC"))
+    {
+        startWriter(_params->getAttributeValue<size_t>("DISPLAY_ASYNC_BUFFER_SIZE"));
+    }
+
     _hasBeenInitialized = true;
 
 }
@@ -255,13 +275,19 @@ void NOMAD::OutputQueue::add(NOMAD::OutputInfo outputInfo)
         return;
     }
 
+    if (_async)
+    {
+        addAsync(std::move(outputInfo));
+        return;
+    }
+
 #ifdef _OPENMP
     // Acquire lock before adding a new element to the queue
-    omp_set_lock(&_s_queue_lock);
+    _s_queue_lock.set();
 #endif // _OPENMP
     _queue.push_back(std::move(outputInfo));
 #ifdef _OPENMP
-    omp_unset_lock(&_s_queue_lock);
+    _s_queue_lock.unset();
 #endif // _OPENMP
 }
 
@@ -282,6 +308,17 @@ void NOMAD::OutputQueue::add(const std::string & s, NOMAD::OutputLevel outputLev
 // Print all in the queue and flush.
 void NOMAD::OutputQueue::flush()
 {
+    if (_async)
+    {
+        // Wait until the writer thread has displayed all that was added before this call.
+        const size_t nbAdded = _nbAdded.load();
+        while (_nbWritten.load() < nbAdded)
+        {
+            usleep(50);
+        }
+        return;
+    }
+
     if (_queue.empty())
     {
         return;
@@ -295,7 +332,7 @@ void NOMAD::OutputQueue::flush()
 
 #ifdef _OPENMP
     // Lock queue before flush
-    omp_set_lock(&_s_queue_lock);
+    _s_queue_lock.set();
 #endif // _OPENMP
 
     // Info goes to Standard output
@@ -305,12 +342,104 @@ void NOMAD::OutputQueue::flush()
     }
     _queue.clear();
 #ifdef _OPENMP
-    omp_unset_lock(&_s_queue_lock);
+    _s_queue_lock.unset();
 #endif // _OPENMP
 
 }
 
 
+void NOMAD::OutputQueue::startWriter(const size_t bufferSize)
+{
+    // Display what was added before, in order.
+    flush();
+
+    _ringBuffer = std::unique_ptr<NOMAD::RingBuffer<NOMAD::OutputInfo>>(new NOMAD::RingBuffer<NOMAD::OutputInfo>(bufferSize));
+    _nbAdded = 0;
+    _nbWritten = 0;
+    _nbDropped = 0;
+    _stopWriter = false;
+    _async = true;
+    _writer = std::thread(&NOMAD::OutputQueue::writerLoop, this);
+}
+
+
+void NOMAD::OutputQueue::stopWriter()
+{
+    if (!_writer.joinable())
+    {
+        return;
+    }
+
+    _stopWriter = true;
+    _writer.join();
+    _async = false;
+    _ringBuffer.reset();
+
+    if (_nbDropped > 0)
+    {
+        std::cout << "Warning: " << _nbDropped.load() << " messages were not displayed because the queue of the asynchronous display was full. Increase DISPLAY_ASYNC_BUFFER_SIZE to display them." << std::endl;
+    }
+}
+
+
+void NOMAD::OutputQueue::writerLoop()
+{
+    NOMAD::OutputInfo outputInfo("", "");
+    bool stop = false;
+    while (!stop)
+    {
+        // Read the flag before emptying the buffer: what was added before the
+        // stop request is displayed.
+        stop = _stopWriter.load();
+
+        bool written = false;
+        while (_ringBuffer->tryPop(outputInfo))
+        {
+            try
+            {
+                flushBlock(outputInfo);
+            }
+            catch (NOMAD::Exception& e)
+            {
+                // No one to catch it in this thread.
+                std::cerr << e.what() << std::endl;
+                _indentLevel = 0;
+            }
+            _nbWritten++;
+            written = true;
+        }
+
+        if (!written && !stop)
+        {
+            usleep(200);
+        }
+    }
+}
+
+
+void NOMAD::OutputQueue::addAsync(NOMAD::OutputInfo outputInfo)
+{
+    // Details can be dropped. The block starts and ends are kept for the
+    // indentation, and the stats are kept for the stats file.
+    const bool canDrop = (outputInfo.getOutputLevel() > NOMAD::OutputLevel::LEVEL_NORMAL
+                          && !outputInfo.isBlockStart()
+                          && !outputInfo.isBlockEnd()
+                          && nullptr == outputInfo.getStatsInfo());
+
+    while (!_ringBuffer->tryPush(std::move(outputInfo)))
+    {
+        if (canDrop)
+        {
+            _nbDropped++;
+            return;
+        }
+        // Slow down until the writer thread makes room.
+        usleep(50);
+    }
+    _nbAdded++;
+}
+
+
 void NOMAD::OutputQueue::startBlock()
 {
     std::cout << " " << _blockStart;
@@ -348,7 +477,6 @@ void NOMAD::OutputQueue::flushBlock(const NOMAD::OutputInfo &outputInfo)
         return;
     }
 
-    const NOMAD::ArrayOfString& msg = outputInfo.getMsg();
     if (outputLevel == NOMAD::OutputLevel::LEVEL_STATS)
     {
         flushStatsToStdout(statsInfo);
@@ -362,7 +490,10 @@ void NOMAD::OutputQueue::flushBlock(const NOMAD::OutputInfo &outputInfo)
             if (_indentLevel < 0)
             {
     #ifdef _OPENMP
-                omp_unset_lock(&_s_queue_lock);
+                if (!_async)
+                {
+                    _s_queue_lock.unset();
+                }
     #endif // _OPENMP
                 throw NOMAD::Exception(__FILE__, __LINE__, "OutputQueue has more block ends than block starts.");
             }
@@ -371,6 +502,8 @@ void NOMAD::OutputQueue::flushBlock(const NOMAD::OutputInfo &outputInfo)
         // Verify step level is high enough in the tree to be displayed.
         if (_indentLevel <= (int)_maxStepLevel)
         {
+            // A deferred message is formatted here, only when it is displayed.
+            const NOMAD::ArrayOfString& msg = outputInfo.getMsg();
             for (size_t i = 0; i < msg.size(); i++)
             {
                 indent(_indentLevel);
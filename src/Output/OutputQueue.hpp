@@ -47,6 +47,8 @@
 #ifndef __NOMAD_4_5_OUTPUTQUEUE__
 #define __NOMAD_4_5_OUTPUTQUEUE__
 
+#include <atomic>
+#include <thread>
 #include <vector>
 #ifdef _OPENMP
 // Using OpenMP.
@@ -59,6 +61,8 @@
 #include "../Param/DisplayParameters.hpp"
 #include "../Output/OutputInfo.hpp"
 #include "../Output/StatsInfo.hpp"
+#include "../Util/InstrumentedLock.hpp"
+#include "../Util/RingBuffer.hpp"
 
 #include "../nomad_nsbegin.hpp"
 
@@ -69,6 +73,11 @@
  The display is formatted with indentation of blocks of information. The display parameters (DisplayParameters) are attributes of the class provided by calling OutputQueue::initParameters. \n
 
  The display can be limited to a maximum block/step level. (OutputQueue::_maxStepLevel). \n
+
+ With parameter DISPLAY_ASYNC, the output information is not kept in the queue: it is put in a
+ bounded lock-free buffer (RingBuffer) and a writer thread displays it. Adding an output information
+ does not wait for the display. OutputQueue::Flush waits until the writer thread has displayed
+ everything that was added before the call. \n
  */
 class OutputQueue
 {
@@ -102,6 +111,24 @@ public:
         getInstance()->add(s, outputLevel);
     }
 
+    /// Add a message built by a function, only if the output level is displayed.
+    /**
+     The message is not formatted when the output level is not displayed:
+     use it instead of Add(const std::string&, OutputLevel) when building the
+     message is costly (display of points, conversions of numbers).
+     \param msgFormatter   Callable returning the message as a std::string -- \b IN.
+     \param outputLevel    The output level of the message -- \b IN.
+     */
+    template<typename MsgFormatter>
+    static void AddDeferred(const MsgFormatter& msgFormatter,
+                            OutputLevel outputLevel = OutputLevel::LEVEL_INFO)
+    {
+        if (GoodLevel(outputLevel))
+        {
+            getInstance()->add(msgFormatter(), outputLevel);
+        }
+    }
+
     void add(const StatsInfo& statsInfo);
     static void Add(const StatsInfo & statsInfo)
     {
@@ -160,7 +187,15 @@ public:
     void initStatsFile();
     const std::string& getStatsFileName() const { return _statsFile; }
 
-    void setTotalEval(const size_t totalEval) { if (totalEval > _totalEval) { _totalEval = totalEval; } }
+    /// Keep the max of the current and the given total number of evaluations. Lock-free.
+    void setTotalEval(const size_t totalEval)
+    {
+        size_t currentTotalEval = _totalEval.load();
+        while (totalEval > currentTotalEval
+               && !_totalEval.compare_exchange_weak(currentTotalEval, totalEval))
+        {
+        }
+    }
 
     void setStatsFileFormat(const DisplayStatsTypeList& statsFileFormat)
     {
@@ -168,6 +203,16 @@ public:
     }
     const DisplayStatsTypeList& getStatsFileFormat() const { return _statsFileFormat; }
 
+    /// Is the stats type used by DISPLAY_STATS or by the format of STATS_FILE?
+    /**
+     Used to avoid filling the StatsInfo members that are costly to copy
+     (blackbox outputs, points, names of steps) when they are not displayed.
+     */
+    bool usesStatsType(const DisplayStatsType& statsType) const
+    {
+        return _usedStatsTypes[static_cast<size_t>(statsType)];
+    }
+
     // Used by OutputInfo.
     const ArrayOfDouble& getSolFormat() const
     {
@@ -180,7 +225,7 @@ private:
     // NOTE It does not seem relevant for the lock to be static,
     // because OutputQueue is a singleton anyway. If staticity causes problems,
     // we could remove the static keyword.
-    DLL_UTIL_API static omp_lock_t      _s_queue_lock;
+    DLL_UTIL_API static InstrumentedLock      _s_queue_lock;
 #endif // _OPENMP
 
     DLL_UTIL_API static bool            _hasBeenInitialized;    ///< Flag for initialization (initialization cannot be performed more than once).
@@ -190,13 +235,22 @@ private:
     /// Queue of all the OutputInfo we have to print.
     std::vector<OutputInfo>             _queue;
 
+    /// Asynchronous display (DISPLAY_ASYNC): the OutputInfo are taken from the ring buffer by the writer thread.
+    bool                                        _async;
+    std::unique_ptr<RingBuffer<OutputInfo>>     _ringBuffer;
+    std::thread                                 _writer;
+    std::atomic<bool>                           _stopWriter;
+    std::atomic<size_t>                         _nbAdded;       ///< Number of OutputInfo put in the ring buffer
+    std::atomic<size_t>                         _nbWritten;     ///< Number of OutputInfo displayed by the writer thread
+    std::atomic<size_t>                         _nbDropped;     ///< Number of OutputInfo dropped because the ring buffer was full
+
     /// Display parameters
     std::shared_ptr<DisplayParameters>  _params;
 
     std::string                         _statsFile;
     std::ofstream                       _statsStream;
     bool                                _statsWritten;
-    size_t                              _totalEval;
+    std::atomic<size_t>                 _totalEval;
 
     /**
      Format for stats in a file (parameter STATS_FILE).
@@ -204,6 +258,9 @@ private:
      */
     DisplayStatsTypeList _statsFileFormat;
 
+    /// Stats types found in DISPLAY_STATS and in the format of STATS_FILE. Indexed by DisplayStatsType.
+    std::vector<bool> _usedStatsTypes;
+
     /**
      Keep track of the number of lines printed to output (DISPLAY_STATS).
      Used to print stats header regularly.
@@ -227,6 +284,15 @@ private:
     void startBlock();
     void endBlock();
 	DLL_UTIL_API void flush();
+
+    /// Start the writer thread of the asynchronous display.
+    void startWriter(const size_t bufferSize);
+    /// Display all the remaining OutputInfo and stop the writer thread.
+    void stopWriter();
+    /// Loop of the writer thread.
+    void writerLoop();
+    /// Put an OutputInfo in the ring buffer. When it is full, drop the OutputInfo or wait.
+    void addAsync(OutputInfo outputInfo);
     void flushBlock(const OutputInfo &outputInfo);
     void flushStatsToStatsFile(const StatsInfo *statsInfo);
     void flushStatsToStdout(const StatsInfo *statsInfo);
@@ -0,0 +1,281 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   OverheadAccounting.cpp
+ \brief  Algorithmic overhead per evaluation (parameter OVERHEAD_ACCOUNTING)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    OverheadAccounting.hpp
+ */
+#include "../Output/OverheadAccounting.hpp"
+#include "../Util/InstrumentedLock.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+
+std::atomic<bool> NOMAD::OverheadAccounting::_enabled(false);
+std::atomic<size_t> NOMAD::OverheadAccounting::_generation(0);
+std::atomic<int64_t> NOMAD::OverheadAccounting::_evalTime(0);
+std::atomic<size_t> NOMAD::OverheadAccounting::_nbEval(0);
+std::atomic<int64_t> NOMAD::OverheadAccounting::_overheadTime(0);
+std::map<std::string, NOMAD::OverheadAccounting::ScopeOverhead> NOMAD::OverheadAccounting::_scopeOverheads;
+
+
+namespace
+{
+    /// A scope begun on the current thread.
+    struct Frame
+    {
+        const void*     _owner;
+        std::string     _name;
+        int64_t         _start;     ///< In nanoseconds
+        int64_t         _childTime; ///< Time of the sub-scopes and of the evaluations, in nanoseconds
+    };
+
+    /// Scopes of the current thread, for a generation of the accounting.
+    struct FrameStack
+    {
+        size_t              _generation = 0;
+        std::vector<Frame>  _frames;
+    };
+
+    FrameStack& getFrameStack(const size_t generation)
+    {
+        static thread_local FrameStack frameStack;
+        if (frameStack._generation != generation)
+        {
+            // Scopes of a previous run.
+            frameStack._frames.clear();
+            frameStack._generation = generation;
+        }
+        return frameStack;
+    }
+
+    int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+
+void NOMAD::OverheadAccounting::start()
+{
+    _enabled.store(false);
+    {
+        NOMAD_CRITICAL(overheadAccounting);
+        _scopeOverheads.clear();
+        _evalTime.store(0);
+        _nbEval.store(0);
+        _overheadTime.store(0);
+        _generation++;
+    }
+    _enabled.store(true);
+}
+
+
+void NOMAD::OverheadAccounting::stop()
+{
+    _enabled.store(false);
+}
+
+
+void NOMAD::OverheadAccounting::beginScope(const void* owner, const std::string& name)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    FrameStack& frameStack = getFrameStack(_generation.load());
+    frameStack._frames.push_back({owner, name, now(), 0});
+}
+
+
+void NOMAD::OverheadAccounting::endScope(const void* owner)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    const int64_t end = now();
+    FrameStack& frameStack = getFrameStack(_generation.load());
+    auto& frames = frameStack._frames;
+
+    // Discard the scopes that were not ended.
+    auto it = std::find_if(frames.rbegin(), frames.rend(),
+                           [owner](const Frame& frame) { return frame._owner == owner; });
+    if (frames.rend() == it)
+    {
+        // Begun before the start of the accounting.
+        return;
+    }
+    frames.erase(it.base(), frames.end());
+
+    const Frame& frame = frames.back();
+    const int64_t duration = end - frame._start;
+    const int64_t selfTime = std::max<int64_t>(0, duration - frame._childTime);
+    _overheadTime += selfTime;
+    {
+        NOMAD_CRITICAL(overheadAccounting);
+        auto& scopeOverhead = _scopeOverheads[frame._name];
+        scopeOverhead._name = frame._name;
+        scopeOverhead._time += static_cast<double>(selfTime) / 1e9;
+        scopeOverhead._nbCalls++;
+    }
+    frames.pop_back();
+
+    if (!frames.empty())
+    {
+        frames.back()._childTime += duration;
+    }
+}
+
+
+void NOMAD::OverheadAccounting::addEvalTime(const double seconds, const size_t nbEval)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    const int64_t evalTime = static_cast<int64_t>(seconds * 1e9);
+    _evalTime += evalTime;
+    _nbEval += nbEval;
+
+    // The evaluation is not in the overhead of the current scope.
+    FrameStack& frameStack = getFrameStack(_generation.load());
+    if (!frameStack._frames.empty())
+    {
+        frameStack._frames.back()._childTime += evalTime;
+    }
+}
+
+
+double NOMAD::OverheadAccounting::getEvalTime()
+{
+    return static_cast<double>(_evalTime.load()) / 1e9;
+}
+
+
+double NOMAD::OverheadAccounting::getOverheadTime()
+{
+    return static_cast<double>(_overheadTime.load()) / 1e9;
+}
+
+
+NOMAD::Double NOMAD::OverheadAccounting::getOverheadPerEval()
+{
+    NOMAD::Double overheadPerEval;
+    const size_t nbEval = getNbEval();
+    if (nbEval > 0)
+    {
+        overheadPerEval = getOverheadTime() / static_cast<double>(nbEval);
+    }
+    return overheadPerEval;
+}
+
+
+std::vector<NOMAD::OverheadAccounting::ScopeOverhead> NOMAD::OverheadAccounting::getScopeOverheads()
+{
+    std::vector<ScopeOverhead> scopeOverheads;
+    {
+        NOMAD_CRITICAL(overheadAccounting);
+        for (const auto& nameOverhead : _scopeOverheads)
+        {
+            scopeOverheads.push_back(nameOverhead.second);
+        }
+    }
+    std::sort(scopeOverheads.begin(), scopeOverheads.end(),
+              [](const ScopeOverhead& o1, const ScopeOverhead& o2)
+              {
+                  return o1._time > o2._time;
+              });
+    return scopeOverheads;
+}
+
+
+std::vector<std::string> NOMAD::OverheadAccounting::getReport()
+{
+    const auto scopeOverheads = getScopeOverheads();
+    const size_t nbEval = getNbEval();
+    const double overheadTime = getOverheadTime();
+    const double evalTime = getEvalTime();
+    // Per evaluation, in milliseconds.
+    const double perEval = (nbEval > 0) ? 1e3 / static_cast<double>(nbEval) : 0.0;
+
+    std::vector<std::string> report;
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+    oss << "Evaluations: " << nbEval
+        << "  Evaluation time (ms): " << evalTime * 1e3
+        << "  Overhead (ms): " << overheadTime * 1e3
+        << "  Overhead per evaluation (ms): " << overheadTime * perEval;
+    report.push_back(oss.str());
+
+    size_t nameWidth = 4;
+    for (const auto& scopeOverhead : scopeOverheads)
+    {
+        nameWidth = std::max(nameWidth, scopeOverhead._name.size());
+    }
+    oss.str("");
+    oss << std::left << std::setw(static_cast<int>(nameWidth)) << "Step" << std::right
+        << std::setw(10) << "Calls" << std::setw(16) << "Overhead (ms)"
+        << std::setw(16) << "Per eval (ms)" << std::setw(10) << "Share";
+    report.push_back(oss.str());
+    for (const auto& scopeOverhead : scopeOverheads)
+    {
+        oss.str("");
+        oss << std::left << std::setw(static_cast<int>(nameWidth)) << scopeOverhead._name << std::right
+            << std::setw(10) << scopeOverhead._nbCalls
+            << std::setw(16) << scopeOverhead._time * 1e3
+            << std::setw(16) << scopeOverhead._time * perEval
+            << std::setw(9) << ((overheadTime > 0.0) ? 100.0 * scopeOverhead._time / overheadTime : 0.0) << "%";
+        report.push_back(oss.str());
+    }
+    return report;
+}
@@ -0,0 +1,195 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   OverheadAccounting.hpp
+ \brief  Algorithmic overhead per evaluation (parameter OVERHEAD_ACCOUNTING)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    OverheadAccounting.cpp
+ */
+#ifndef __NOMAD_4_5_OVERHEADACCOUNTING__
+#define __NOMAD_4_5_OVERHEADACCOUNTING__
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../Math/Double.hpp"
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Wall time spent by NOMAD itself, as opposed to the time in the evaluator.
+/**
+ With cheap blackboxes, the time of the algorithm (generation of the points,
+ projection on the mesh, sorting, cache, barrier, output) may exceed the time
+ of the evaluations. The accounting separates the wall time of the calls to
+ \c eval_block (and \c eval_x) from the rest of the time of the steps.
+
+ Each thread keeps the stack of the scopes (steps) it is in. When a scope
+ ends, its self time, that is its duration minus the duration of its sub-scopes
+ and of the evaluations done by the thread meanwhile, is added to the overhead
+ of the name of the scope (the step type). The overhead of a main thread
+ waiting for the evaluation threads is in the scope of the evaluator control.
+
+ The overhead is the sum over the main threads: with several main threads, it
+ may exceed the wall time of the run.
+
+ When the accounting is disabled, a scope costs a single atomic load.
+ */
+class DLL_UTIL_API OverheadAccounting
+{
+public:
+    /// Overhead of the scopes with the same name.
+    struct ScopeOverhead
+    {
+        std::string     _name;
+        double          _time;      ///< Self time, in seconds
+        size_t          _nbCalls;
+    };
+
+private:
+    static std::atomic<bool>        _enabled;
+    static std::atomic<size_t>      _generation;    ///< Incremented at each start(): the scopes begun before are ignored
+    static std::atomic<int64_t>     _evalTime;      ///< Time in the evaluator, in nanoseconds
+    static std::atomic<size_t>      _nbEval;        ///< Number of points evaluated
+    static std::atomic<int64_t>     _overheadTime;  ///< Sum of the self times, in nanoseconds
+    static std::map<std::string, ScopeOverhead> _scopeOverheads;
+
+public:
+    // No need for constructor. All is static.
+
+    /// Start the accounting. The previous measures are discarded.
+    static void start();
+
+    /// Stop the accounting. The measures are kept for the report.
+    static void stop();
+
+    static bool isEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+    /// Begin of a scope on the current thread.
+    /**
+     \param owner   Identifies the scope for endScope(), for instance the step -- \b IN.
+     \param name    Name under which the self time is accounted, for instance the step type -- \b IN.
+     */
+    static void beginScope(const void* owner, const std::string& name);
+
+    /// End of a scope on the current thread.
+    /**
+     The scopes begun after it on this thread and not ended (an exception was
+     thrown) are discarded. Nothing is done if the scope was begun before the
+     accounting started.
+     \param owner   As given to beginScope() -- \b IN.
+     */
+    static void endScope(const void* owner);
+
+    /// Time spent in the evaluator by the current thread.
+    /**
+     \param seconds     Wall time of the call to the evaluator -- \b IN.
+     \param nbEval      Number of points evaluated by the call -- \b IN.
+     */
+    static void addEvalTime(const double seconds, const size_t nbEval);
+
+    static size_t getNbEval() { return _nbEval.load(); }
+
+    /// Total time in the evaluator, in seconds.
+    static double getEvalTime();
+
+    /// Total overhead, in seconds.
+    static double getOverheadTime();
+
+    /// Overhead per evaluation, in seconds. Undefined before the first evaluation.
+    static Double getOverheadPerEval();
+
+    /// Overheads by name of scope, by decreasing time.
+    static std::vector<ScopeOverhead> getScopeOverheads();
+
+    /// Report: the totals, then one line per name of scope.
+    static std::vector<std::string> getReport();
+};
+
+
+/// Scope of the overhead accounting until the end of the current scope.
+/**
+ Nothing is done if the accounting is disabled when the scope starts.
+ */
+class DLL_UTIL_API OverheadScope
+{
+private:
+    const bool      _active;
+
+public:
+    /// Constructor
+    /**
+     \param name    Name under which the self time is accounted -- \b IN.
+     */
+    explicit OverheadScope(const std::string& name)
+      : _active(OverheadAccounting::isEnabled())
+    {
+        if (_active)
+        {
+            OverheadAccounting::beginScope(this, name);
+        }
+    }
+
+    ~OverheadScope()
+    {
+        if (_active)
+        {
+            OverheadAccounting::endScope(this);
+        }
+    }
+
+    OverheadScope(const OverheadScope&) = delete;
+    OverheadScope& operator=(const OverheadScope&) = delete;
+};
+
+#include "../nomad_nsend.hpp"
+
+#endif // __NOMAD_4_5_OVERHEADACCOUNTING__
@@ -73,6 +73,7 @@ NOMAD::StatsInfo::StatsInfo()
     _cacheSize(0),
     _iterNum(0),
     _time(0),
+    _overhead(),
     _meshIndex(),
     _meshSize(),
     _frameSize(),
@@ -269,6 +270,10 @@ NOMAD::DisplayStatsType NOMAD::StatsInfo::stringToDisplayStatsType(const std::st
     {
         ret = NOMAD::DisplayStatsType::DS_TAG;
     }
+    else if (s == "OVERHEAD")
+    {
+        ret = NOMAD::DisplayStatsType::DS_OVERHEAD;
+    }
     else
     {
         // Don't throw an exception.
@@ -355,6 +360,8 @@ std::string NOMAD::StatsInfo::displayStatsTypeToString(const NOMAD::DisplayStats
             return "TOTAL_MODEL_EVAL";
         case NOMAD::DisplayStatsType::DS_TAG:
             return "TAG";    
+        case NOMAD::DisplayStatsType::DS_OVERHEAD:
+            return "OVERHEAD";
         case NOMAD::DisplayStatsType::DS_USER:
             return "USER";
         case NOMAD::DisplayStatsType::DS_UNDEFINED:
@@ -566,6 +573,10 @@ std::string NOMAD::StatsInfo::display(const NOMAD::DisplayStatsTypeList& format,
         {
             out +=  NOMAD::itos(_tag);
         }
+        else if (NOMAD::DisplayStatsType::DS_OVERHEAD == statsType)
+        {
+            out += doubleFormat.empty() ? _overhead.tostring() : _overhead.display(doubleFormat);
+        }
         else if (NOMAD::DisplayStatsType::DS_USER == statsType)
         {
             // Display original string
@@ -110,6 +110,7 @@ enum class DisplayStatsType
     //DS_STAT_SUM   ,    ///< Stat sum
     //DS_STAT_AVG   ,    ///< Stat avg
     DS_TAG,             ///< Tag
+    DS_OVERHEAD   ,    ///< Algorithmic overhead per evaluation, in seconds (OVERHEAD_ACCOUNTING)
     DS_USER         ,  ///< User-defined string
     DS_UNDEFINED       ///< Undefined value
     //   (keep in last position)
@@ -144,6 +145,7 @@ private:
     size_t          _cacheSize;
     size_t          _iterNum;
     size_t          _time;
+    Double          _overhead;
     ArrayOfDouble   _meshIndex;
     ArrayOfDouble   _meshSize;
     ArrayOfDouble   _frameSize;
@@ -188,6 +190,7 @@ public:
     void setBlkEva(const size_t blkEva)             { _blkEva = blkEva; }
     void setBlkSize(const size_t blkSize)           { _blkSize = blkSize; }
     void setBBO(const std::string& bbo)             { _bbo = bbo; }
+    const std::string& getBBO() const               { return _bbo; }
     void setEval(const size_t eval)                 { _eval = eval; }
     void setNbRelativeSuccess(const size_t nbRelSuccess)   { _nbRelativeSuccess = nbRelSuccess; }
     void setPhaseOneSuccess(const size_t phaseOneSuccess)   { _PhaseOneSuccess = phaseOneSuccess; }
@@ -195,6 +198,7 @@ public:
     void setCacheSize(const size_t cacheSize)       { _cacheSize = cacheSize; }
     void setIterNum(const size_t iterNum)           { _iterNum = iterNum; }
     void setTime(const size_t time)                 { _time = time; }
+    void setOverhead(const Double& overhead)        { _overhead = overhead; }
     void setMeshIndex(const ArrayOfDouble& meshIndex) { _meshIndex = meshIndex; }
     void setMeshSize(const ArrayOfDouble& meshSize)   { _meshSize = meshSize; }
     void setFrameSize(const ArrayOfDouble& frameSize) { _frameSize = frameSize; }
@@ -204,6 +208,7 @@ public:
     void setModelEval(const size_t modelEval)       { _modelEval = modelEval; }
     void setTotalModelEval(const size_t totalModelEval) { _totalModelEval = totalModelEval; }
     void setSol(const Point& sol)                    { _sol = sol; }
+    const Point& getSol() const                     { return _sol; }
     void setSurrogateEval(const size_t surrogateEval) { _surrogateEval = surrogateEval; }
     void setThreadAlgo(const int threadAlgoNum)     { _threadAlgoNum = threadAlgoNum; }
     void setThreadNum(const int threadNum)          { _threadNum = threadNum; }
@@ -0,0 +1,277 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   Trace.cpp
+ \brief  Runtime tracing of the steps in Chrome trace format (parameter TRACE_FILE)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    Trace.hpp
+ */
+#include "../Output/Trace.hpp"
+#include "../Util/InstrumentedLock.hpp"
+#include "../Util/utils.hpp"
+
+#include <chrono>
+#include <fstream>
+
+
+// Number of events in a chunk of a thread buffer.
+static const size_t TRACE_CHUNK_SIZE = 4096;
+// Maximum number of chunks of a thread buffer. When it is reached, the next
+// events of the thread are dropped.
+static const size_t TRACE_MAX_CHUNKS = 256;
+
+
+/// Events of a thread.
+/**
+ Only the owner thread adds events. The chunks are allocated by the owner
+ thread before the events they hold are published by _size: the chunks
+ read by stop() are never modified.
+ */
+struct NOMAD::Trace::ThreadBuffer
+{
+    int                                     _threadNum;
+    std::vector<std::unique_ptr<Event[]>>   _chunks;
+    std::atomic<size_t>                     _size;      ///< Number of events published
+    std::atomic<size_t>                     _nbDropped;
+
+    explicit ThreadBuffer(const int threadNum)
+      : _threadNum(threadNum),
+        _chunks(TRACE_MAX_CHUNKS),
+        _size(0),
+        _nbDropped(0)
+    {
+    }
+};
+
+
+std::atomic<bool> NOMAD::Trace::_enabled(false);
+std::atomic<size_t> NOMAD::Trace::_generation(0);
+std::string NOMAD::Trace::_fileName;
+int64_t NOMAD::Trace::_startTime = 0;
+std::vector<std::shared_ptr<NOMAD::Trace::ThreadBuffer>> NOMAD::Trace::_buffers;
+
+
+namespace
+{
+    // Write a string as a JSON string.
+    void writeJSONString(std::ofstream& out, const std::string& s)
+    {
+        out << '"';
+        for (const char c : s)
+        {
+            if ('"' == c || '\\' == c)
+            {
+                out << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out << ' ';
+            }
+            else
+            {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+}
+
+
+void NOMAD::Trace::start(const std::string& fileName)
+{
+    _enabled.store(false);
+    {
+        NOMAD_CRITICAL(traceBuffersLock);
+        _buffers.clear();
+        _fileName = fileName;
+        _startTime = now();
+        // The threads register a new buffer at their next event.
+        _generation++;
+    }
+    _enabled.store(true);
+}
+
+
+bool NOMAD::Trace::stop()
+{
+    if (!_enabled.exchange(false))
+    {
+        return false;
+    }
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        NOMAD_CRITICAL(traceBuffersLock);
+        buffers.swap(_buffers);
+    }
+
+    std::ofstream out(_fileName);
+    if (out.fail())
+    {
+        return false;
+    }
+
+    size_t nbDropped = 0;
+    bool first = true;
+    out << "{\"traceEvents\":[";
+    for (size_t tid = 0; tid < buffers.size(); tid++)
+    {
+        const ThreadBuffer& buffer = *buffers[tid];
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid;
+        out << ",\"args\":{\"name\":\"Thread " << buffer._threadNum << "\"}}";
+
+        // The events published by the thread. Next ones, if any, are ignored.
+        const size_t size = buffer._size.load(std::memory_order_acquire);
+        for (size_t i = 0; i < size; i++)
+        {
+            const Event& event = buffer._chunks[i / TRACE_CHUNK_SIZE][i % TRACE_CHUNK_SIZE];
+            out << ",\n{\"ph\":\"" << event._phase << "\",\"pid\":0,\"tid\":" << tid;
+            out << ",\"ts\":" << event._ts - _startTime;
+            if ('E' != event._phase)
+            {
+                out << ",\"name\":";
+                writeJSONString(out, event._name);
+            }
+            out << ",\"cat\":\"" << event._category << "\"";
+            if ('X' == event._phase)
+            {
+                out << ",\"dur\":" << event._dur;
+            }
+            out << "}";
+        }
+        nbDropped += buffer._nbDropped.load();
+    }
+    out << "\n],\n\"displayTimeUnit\":\"ms\",\n";
+    out << "\"otherData\":{\"droppedEvents\":\"" << nbDropped << "\"}}" << std::endl;
+
+    return !out.fail();
+}
+
+
+void NOMAD::Trace::begin(const std::string& name, const char* category)
+{
+    record('B', std::string(name), category, now(), 0);
+}
+
+
+void NOMAD::Trace::end(const char* category)
+{
+    record('E', std::string(), category, now(), 0);
+}
+
+
+void NOMAD::Trace::complete(std::string&& name, const char* category, const int64_t ts, const int64_t dur)
+{
+    record('X', std::move(name), category, ts, dur);
+}
+
+
+int64_t NOMAD::Trace::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+void NOMAD::Trace::record(const char phase, std::string&& name, const char* category, const int64_t ts, const int64_t dur)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    ThreadBuffer* buffer = getThreadBuffer();
+    const size_t index = buffer->_size.load(std::memory_order_relaxed);
+    const size_t chunk = index / TRACE_CHUNK_SIZE;
+    if (chunk >= TRACE_MAX_CHUNKS)
+    {
+        buffer->_nbDropped++;
+        return;
+    }
+    if (nullptr == buffer->_chunks[chunk])
+    {
+        buffer->_chunks[chunk].reset(new Event[TRACE_CHUNK_SIZE]);
+    }
+
+    Event& event = buffer->_chunks[chunk][index % TRACE_CHUNK_SIZE];
+    event._phase = phase;
+    event._name = std::move(name);
+    event._category = category;
+    event._ts = ts;
+    event._dur = dur;
+
+    // Publish the event.
+    buffer->_size.store(index + 1, std::memory_order_release);
+}
+
+
+NOMAD::Trace::ThreadBuffer* NOMAD::Trace::getThreadBuffer()
+{
+    // The buffer of the thread is kept alive by the thread, even after stop()
+    // or a new start().
+    static thread_local size_t threadGeneration = 0;
+    static thread_local std::shared_ptr<ThreadBuffer> threadBuffer;
+
+    const size_t generation = _generation.load();
+    if (threadGeneration != generation || nullptr == threadBuffer)
+    {
+        threadBuffer = std::make_shared<ThreadBuffer>(NOMAD::getThreadNum());
+        threadGeneration = generation;
+        {
+            NOMAD_CRITICAL(traceBuffersLock);
+            // Not registered if tracing was restarted meanwhile: the events are lost.
+            if (_generation.load() == generation)
+            {
+                _buffers.push_back(threadBuffer);
+            }
+        }
+    }
+
+    return threadBuffer.get();
+}
@@ -0,0 +1,196 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   Trace.hpp
+ \brief  Runtime tracing of the steps in Chrome trace format (parameter TRACE_FILE)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    Trace.cpp
+ */
+#ifndef __NOMAD_4_5_TRACE__
+#define __NOMAD_4_5_TRACE__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Runtime tracing, written as a Chrome trace file.
+/**
+ Tracing is enabled at runtime by setting the parameter TRACE_FILE. The file
+ is in the JSON format of the Chrome trace viewer and Perfetto: open it with
+ chrome://tracing or https://ui.perfetto.dev to see, for each thread, where the
+ wall time goes between the steps (search methods, poll, model building) and
+ the evaluations.
+
+ Each thread records its events in its own buffer, without taking any lock.
+ A buffer is made of chunks of events that are never moved: the file is written
+ from the events published before the call to stop(). A thread registers its
+ buffer at its first event after start().
+
+ When tracing is disabled, an event costs a single atomic load.
+
+ \b Example:
+ \code
+ Trace::start("trace.json");
+ Trace::begin("Step", "step");
+ {
+     TraceScope scope("Cache find", "cache");
+     // ...
+ }
+ Trace::end("step");
+ Trace::stop();
+ \endcode
+ */
+class DLL_UTIL_API Trace
+{
+public:
+    /// An event, as in the Chrome trace format.
+    struct Event
+    {
+        char            _phase;     ///< 'B' begin, 'E' end, 'X' complete
+        std::string     _name;
+        const char*     _category;  ///< A string literal
+        int64_t         _ts;        ///< Time stamp, in microseconds
+        int64_t         _dur;       ///< Duration, in microseconds, for phase 'X'
+    };
+
+private:
+    struct ThreadBuffer;
+
+    static std::atomic<bool>        _enabled;
+    static std::atomic<size_t>      _generation;    ///< Incremented at each start(): the threads register a new buffer
+    static std::string              _fileName;
+    static int64_t                  _startTime;     ///< Time stamp of start(). The trace file starts at 0.
+    static std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+
+public:
+    // No need for constructor. All is static.
+
+    /// Start tracing. The events recorded before are discarded.
+    /**
+     \param fileName    The trace file, written by stop() -- \b IN.
+     */
+    static void start(const std::string& fileName);
+
+    /// Stop tracing and write the trace file.
+    /**
+     \return \c false if tracing was not started, or if the file cannot be written.
+     */
+    static bool stop();
+
+    static bool isEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+    static const std::string& getFileName() { return _fileName; }
+
+    /// Begin of a duration on the current thread.
+    static void begin(const std::string& name, const char* category);
+
+    /// End of the last duration begun on the current thread.
+    static void end(const char* category);
+
+    /// A complete duration on the current thread.
+    static void complete(std::string&& name, const char* category, const int64_t ts, const int64_t dur);
+
+    /// Time stamp of the events, in microseconds.
+    static int64_t now();
+
+private:
+    static void record(const char phase, std::string&& name, const char* category, const int64_t ts, const int64_t dur);
+    static ThreadBuffer* getThreadBuffer();
+};
+
+
+/// Duration of a scope, recorded as a complete event.
+/**
+ Nothing is done if tracing is disabled when the scope starts.
+ */
+class DLL_UTIL_API TraceScope
+{
+private:
+    const bool      _active;
+    const char*     _name;
+    const char*     _category;
+    int64_t         _start;
+
+public:
+    /// Constructor
+    /**
+     \param name        Name of the event. A string literal -- \b IN.
+     \param category    Category of the event. A string literal -- \b IN.
+     */
+    TraceScope(const char* name, const char* category)
+      : _active(Trace::isEnabled()),
+        _name(name),
+        _category(category),
+        _start(0)
+    {
+        if (_active)
+        {
+            _start = Trace::now();
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (_active)
+        {
+            Trace::complete(std::string(_name), _category, _start, Trace::now() - _start);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#include "../nomad_nsend.hpp"
+
+#endif // __NOMAD_4_5_TRACE__
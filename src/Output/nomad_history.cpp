@@ -0,0 +1,231 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   nomad_history.cpp
+ \brief  Conversion and query of binary history files (parameter HISTORY_FILE_BINARY)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    BinaryHistory.hpp
+ */
+
+#include "../Output/BinaryHistory.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+
+static void displayUsage(const char* exeName)
+{
+    std::cout << "Usage: " << exeName << " FILE [--info] [--csv] [--first N] [--count N] [--columns LIST]" << std::endl;
+    std::cout << "  FILE      : history file written with HISTORY_FILE_BINARY yes." << std::endl;
+    std::cout << "  --info    : display the number of records and of columns, and exit." << std::endl;
+    std::cout << "  --csv     : comma-separated values, with a header line. Default: one record per" << std::endl;
+    std::cout << "              line, values separated by spaces (SOL BBO), as the text history file." << std::endl;
+    std::cout << "  --first   : index of the first record (default: 0)." << std::endl;
+    std::cout << "  --count   : number of records (default: all)." << std::endl;
+    std::cout << "  --columns : comma-separated indexes of the columns (default: all). The columns" << std::endl;
+    std::cout << "              of the point (SOL) come first, followed by the blackbox outputs (BBO)." << std::endl;
+    std::cout << "Only the blocks of the records and the columns asked for are read." << std::endl;
+}
+
+
+static bool readSize(const char* arg, size_t& value)
+{
+    char* end = nullptr;
+    const unsigned long long v = std::strtoull(arg, &end, 10);
+    if (end == arg || '\0' != *end)
+    {
+        return false;
+    }
+    value = static_cast<size_t>(v);
+    return true;
+}
+
+
+/*------------------------------------------*/
+/*          nomad_history main function     */
+/*------------------------------------------*/
+int main(int argc, char ** argv)
+{
+    std::string fileName, columnsArg;
+    bool info = false, csv = false;
+    size_t first = 0, count = std::string::npos;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if ("--info" == arg)
+        {
+            info = true;
+        }
+        else if ("--csv" == arg)
+        {
+            csv = true;
+        }
+        else if ("--first" == arg && i + 1 < argc && readSize(argv[i+1], first))
+        {
+            i++;
+        }
+        else if ("--count" == arg && i + 1 < argc && readSize(argv[i+1], count))
+        {
+            i++;
+        }
+        else if ("--columns" == arg && i + 1 < argc)
+        {
+            columnsArg = argv[++i];
+        }
+        else if (fileName.empty() && '-' != arg[0])
+        {
+            fileName = arg;
+        }
+        else
+        {
+            displayUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (fileName.empty())
+    {
+        displayUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    NOMAD::BinaryHistoryReader reader;
+    std::string errMsg;
+    if (!reader.open(fileName, errMsg))
+    {
+        std::cerr << "Error: " << errMsg << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (info)
+    {
+        std::cout << "Records:     " << reader.getNbRecords() << std::endl;
+        std::cout << "SOL columns: " << reader.getNbSolColumns() << std::endl;
+        std::cout << "BBO columns: " << reader.getNbBBOColumns() << std::endl;
+        std::cout << "Block size:  " << reader.getBlockSize() << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    std::vector<size_t> columns;
+    if (columnsArg.empty())
+    {
+        for (size_t c = 0; c < reader.getNbColumns(); c++)
+        {
+            columns.push_back(c);
+        }
+    }
+    else
+    {
+        std::istringstream iss(columnsArg);
+        std::string token;
+        size_t c = 0;
+        while (std::getline(iss, token, ','))
+        {
+            if (!readSize(token.c_str(), c) || c >= reader.getNbColumns())
+            {
+                std::cerr << "Error: invalid column " << token << ". The file has " << reader.getNbColumns() << " columns." << std::endl;
+                return EXIT_FAILURE;
+            }
+            columns.push_back(c);
+        }
+    }
+
+    const char separator = csv ? ',' : ' ';
+    if (csv)
+    {
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            if (i > 0)
+            {
+                std::cout << separator;
+            }
+            if (columns[i] < reader.getNbSolColumns())
+            {
+                std::cout << "x" << columns[i];
+            }
+            else
+            {
+                std::cout << "bbo" << columns[i] - reader.getNbSolColumns();
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    // Exact decimal representation of the doubles.
+    std::cout << std::setprecision(17);
+
+    // Read one block at a time.
+    const size_t last = (first < reader.getNbRecords()) ? first + std::min(count, reader.getNbRecords() - first) : first;
+    std::vector<std::vector<double>> values;
+    for (size_t start = first; start < last; start += reader.getBlockSize())
+    {
+        const size_t nbRecords = std::min(reader.getBlockSize(), last - start);
+        if (!reader.read(start, nbRecords, columns, values))
+        {
+            std::cerr << "Error: cannot read records " << start << " to " << start + nbRecords - 1 << " of " << fileName << std::endl;
+            return EXIT_FAILURE;
+        }
+        for (size_t r = 0; r < nbRecords; r++)
+        {
+            for (size_t i = 0; i < columns.size(); i++)
+            {
+                if (i > 0)
+                {
+                    std::cout << separator;
+                }
+                std::cout << values[i][r];
+            }
+            std::cout << '\n';
+        }
+    }
+    std::cout << std::flush;
+
+    return EXIT_SUCCESS;
+}
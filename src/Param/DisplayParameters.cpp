@@ -109,6 +109,12 @@ void NOMAD::DisplayParameters::checkAndComply(
         throw NOMAD::InvalidParameter(__FILE__,__LINE__, "DISPLAY_HEADER must be positive. To disable headers, set DISPLAY_HEADER to INF.");
     }
 
+    // Verify DISPLAY_ASYNC_BUFFER_SIZE is positive
+    if (0 == getAttributeValueProtected<size_t>("DISPLAY_ASYNC_BUFFER_SIZE",false))
+    {
+        throw NOMAD::InvalidParameter(__FILE__,__LINE__, "DISPLAY_ASYNC_BUFFER_SIZE must be positive.");
+    }
+
     // Pb params must be checked before accessing its value
     size_t n = pbParams->getAttributeValue<size_t>("DIMENSION");
     if (n == 0)
@@ -212,6 +218,17 @@ void NOMAD::DisplayParameters::checkAndComply(
         throw NOMAD::InvalidParameter(__FILE__,__LINE__, "SOLUTION_FILE_FINAL must be enabled only with SOLUTION_FILE properly set.");
     }
 
+    /*------------------------------------------------------*/
+    /* Trace file                                           */
+    /*------------------------------------------------------*/
+    auto traceFileName = getAttributeValueProtected<std::string>("TRACE_FILE",false) ;
+    if (!traceFileName.empty())
+    {
+        auto seed = runParams->getAttributeValue<int>("SEED");
+        NOMAD::completeFileName(traceFileName, problemDir, addSeedToFileNames, seed);
+        setAttributeValue("TRACE_FILE", traceFileName);
+    }
+
     _toBeChecked = false;
 
 }
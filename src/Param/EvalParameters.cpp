@@ -116,6 +116,25 @@ void NOMAD::EvalParameters::checkAndComply(const std::shared_ptr<NOMAD::RunParam
     updateExeParam(runParams, "BB_EXE");
     updateExeParam(runParams, "SURROGATE_EXE");
 
+    // The staged and intermediate outputs of BB_EXE are read from its standard output.
+    if (   getAttributeValueProtected<bool>("BB_EVAL_STAGED", false)
+        && !getAttributeValueProtected<std::string>("BB_EXE", false).empty()
+        && !getAttributeValueProtected<bool>("BB_REDIRECTION", false))
+    {
+        throw NOMAD::InvalidParameter(__FILE__, __LINE__, "Parameter BB_EVAL_STAGED requires BB_REDIRECTION with BB_EXE.");
+    }
+    if (   getAttributeValueProtected<bool>("BB_EVAL_MULTI_FIDELITY", false)
+        && !getAttributeValueProtected<std::string>("BB_EXE", false).empty()
+        && !getAttributeValueProtected<bool>("BB_REDIRECTION", false))
+    {
+        throw NOMAD::InvalidParameter(__FILE__, __LINE__, "Parameter BB_EVAL_MULTI_FIDELITY requires BB_REDIRECTION with BB_EXE.");
+    }
+    const auto& truncationMargin = getAttributeValueProtected<NOMAD::Double>("BB_EVAL_TRUNCATION_MARGIN", false);
+    if (!truncationMargin.isDefined() || truncationMargin < 0.0)
+    {
+        throw NOMAD::InvalidParameter(__FILE__, __LINE__, "Parameter BB_EVAL_TRUNCATION_MARGIN must be nonnegative.");
+    }
+
 
     /*----------------*/
     /* BB_OUTPUT_TYPE */
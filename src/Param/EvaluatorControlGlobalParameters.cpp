@@ -242,6 +242,25 @@ void NOMAD::EvaluatorControlGlobalParameters::checkAndComply(const std::shared_p
     {
         throw NOMAD::InvalidParameter(__FILE__, __LINE__, "Parameter EVAL_SURROGATE_COST must be positive");
     }
+
+    auto hedgingPercentile = getAttributeValueProtected<size_t>("BB_HEDGING_PERCENTILE", false);
+    if (NOMAD::INF_SIZE_T != hedgingPercentile && (0 == hedgingPercentile || hedgingPercentile > 99))
+    {
+        throw NOMAD::InvalidParameter(__FILE__, __LINE__, "Parameter BB_HEDGING_PERCENTILE must be between 1 and 99, or INF");
+    }
+
+    if (   getAttributeValueProtected<bool>("DETERMINISTIC_PARALLEL", false)
+        && (   getAttributeValueProtected<bool>("BB_ADAPTIVE_BLOCK_SIZE", false)
+            || getAttributeValueProtected<bool>("EVAL_COST_AWARE_DISPATCH", false)))
+    {
+        throw NOMAD::InvalidParameter(__FILE__, __LINE__, "Parameter DETERMINISTIC_PARALLEL is incompatible with BB_ADAPTIVE_BLOCK_SIZE and EVAL_COST_AWARE_DISPATCH");
+    }
+
+    if (   getAttributeValueProtected<bool>("DETERMINISTIC_PARALLEL", false)
+        && getAttributeValueProtected<bool>("EVAL_OPPORTUNISTIC_CANCEL", false))
+    {
+        throw NOMAD::InvalidParameter(__FILE__, __LINE__, "Parameter DETERMINISTIC_PARALLEL is incompatible with EVAL_OPPORTUNISTIC_CANCEL");
+    }
     
     int nbThreadsParam = getAttributeValueProtected<int>("NB_THREADS_PARALLEL_EVAL",false);
 #ifdef _OPENMP
@@ -265,6 +284,11 @@ void NOMAD::EvaluatorControlGlobalParameters::checkAndComply(const std::shared_p
         std::string s = "NB_THREADS_PARALLEL_EVAL>1 but OpenMP is not available. Build Nomad with OpenMP enabled.";
         throw NOMAD::InvalidParameter(__FILE__, __LINE__, s);
     }
+    if (getAttributeValueProtected<size_t>("NB_THREADS_SURROGATE_EVAL",false) > 0)
+    {
+        std::string s = "NB_THREADS_SURROGATE_EVAL>0 but OpenMP is not available. Build Nomad with OpenMP enabled.";
+        throw NOMAD::InvalidParameter(__FILE__, __LINE__, s);
+    }
 #endif // _OPENMP
     
     
@@ -0,0 +1,287 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   ChildProcess.cpp
+ \brief  Run a system command and read its standard output, with stop control
+ \author Christophe Tribes
+ \date   October 2026
+ \see    ChildProcess.hpp
+ */
+#include "../Util/ChildProcess.hpp"
+#include "../Util/defines.hpp"  // For BUFFER_SIZE
+
+#ifdef _WIN32
+#define popen  _popen
+#define pclose _pclose
+#else
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Period at which the stop predicate is polled while the process is silent.
+static const int POLL_PERIOD_MS = 50;
+
+
+NOMAD::ChildProcess::ChildProcess(std::function<bool()> stopRequested)
+  : _stopRequested(std::move(stopRequested)),
+    _pending(),
+    _endOfOutput(false),
+#ifdef _WIN32
+    _file(nullptr)
+#else
+    _fd(-1),
+    _pid(-1)
+#endif
+{
+}
+
+
+NOMAD::ChildProcess::~ChildProcess()
+{
+#ifdef _WIN32
+    if (nullptr != _file)
+#else
+    if (_pid > 0)
+#endif
+    {
+        kill();
+        close();
+    }
+}
+
+
+#ifdef _WIN32
+
+bool NOMAD::ChildProcess::start(const std::string& cmd)
+{
+    _file = popen(cmd.c_str(), "r");
+    return (nullptr != _file);
+}
+
+
+NOMAD::ChildProcessReadStatus NOMAD::ChildProcess::readLine(std::string& line)
+{
+    char buffer[BUFFER_SIZE];
+    line.clear();
+    while (nullptr != fgets(buffer, sizeof(buffer), _file))
+    {
+        line += buffer;
+        if (!line.empty() && '\n' == line.back())
+        {
+            line.pop_back();
+            return NOMAD::ChildProcessReadStatus::LINE_READ;
+        }
+    }
+    if (!line.empty())
+    {
+        return NOMAD::ChildProcessReadStatus::LINE_READ;
+    }
+    return feof(_file) ? NOMAD::ChildProcessReadStatus::END_OF_OUTPUT
+                       : NOMAD::ChildProcessReadStatus::READ_ERROR;
+}
+
+
+void NOMAD::ChildProcess::kill()
+{
+    // Not supported: the command runs until completion.
+}
+
+
+int NOMAD::ChildProcess::close()
+{
+    int exitStatus = -1;
+    if (nullptr != _file)
+    {
+        exitStatus = pclose(_file);
+        _file = nullptr;
+    }
+    return exitStatus;
+}
+
+#else // POSIX
+
+bool NOMAD::ChildProcess::start(const std::string& cmd)
+{
+    int fds[2];
+    if (0 != pipe(fds))
+    {
+        return false;
+    }
+    // Do not leak the read end to processes forked by other threads,
+    // otherwise end of output is not detected until they terminate.
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return false;
+    }
+    if (0 == pid)
+    {
+        // Child: only async-signal-safe calls from here.
+        setpgid(0, 0);
+        dup2(fds[1], STDOUT_FILENO);
+        execl("/bin/sh", "sh", "-c", cmd.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    // Parent. Also set the process group here, to avoid a race with kill().
+    setpgid(pid, pid);
+    ::close(fds[1]);
+    _fd = fds[0];
+    _pid = static_cast<int>(pid);
+    _pending.clear();
+    _endOfOutput = false;
+
+    return true;
+}
+
+
+NOMAD::ChildProcessReadStatus NOMAD::ChildProcess::readLine(std::string& line)
+{
+    line.clear();
+    char buffer[BUFFER_SIZE];
+
+    while (true)
+    {
+        size_t posEol = _pending.find('\n');
+        if (std::string::npos != posEol)
+        {
+            line = _pending.substr(0, posEol);
+            _pending.erase(0, posEol + 1);
+            return NOMAD::ChildProcessReadStatus::LINE_READ;
+        }
+        if (_endOfOutput || _fd < 0)
+        {
+            if (_pending.empty())
+            {
+                return NOMAD::ChildProcessReadStatus::END_OF_OUTPUT;
+            }
+            // Last line without end-of-line
+            line.swap(_pending);
+            _pending.clear();
+            return NOMAD::ChildProcessReadStatus::LINE_READ;
+        }
+        if (_stopRequested && _stopRequested())
+        {
+            return NOMAD::ChildProcessReadStatus::STOPPED;
+        }
+
+        struct pollfd pfd;
+        pfd.fd = _fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int nbReady = poll(&pfd, 1, POLL_PERIOD_MS);
+        if (nbReady < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return NOMAD::ChildProcessReadStatus::READ_ERROR;
+        }
+        if (0 == nbReady)
+        {
+            // Nothing yet. Check stop predicate again.
+            continue;
+        }
+
+        ssize_t nbRead = read(_fd, buffer, sizeof(buffer));
+        if (nbRead > 0)
+        {
+            _pending.append(buffer, static_cast<size_t>(nbRead));
+        }
+        else if (0 == nbRead)
+        {
+            _endOfOutput = true;
+        }
+        else if (EINTR != errno && EAGAIN != errno)
+        {
+            return NOMAD::ChildProcessReadStatus::READ_ERROR;
+        }
+    }
+}
+
+
+void NOMAD::ChildProcess::kill()
+{
+    if (_pid > 0)
+    {
+        // Negative pid: signal the whole process group.
+        ::kill(-_pid, SIGKILL);
+    }
+}
+
+
+int NOMAD::ChildProcess::close()
+{
+    if (_fd >= 0)
+    {
+        ::close(_fd);
+        _fd = -1;
+    }
+
+    int exitStatus = -1;
+    if (_pid > 0)
+    {
+        while (waitpid(_pid, &exitStatus, 0) < 0 && EINTR == errno)
+        {
+        }
+        _pid = -1;
+    }
+    return exitStatus;
+}
+
+#endif // _WIN32
@@ -0,0 +1,130 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   ChildProcess.hpp
+ \brief  Run a system command and read its standard output, with stop control
+ \author Christophe Tribes
+ \date   October 2026
+ \see    ChildProcess.cpp
+ */
+#ifndef __NOMAD_4_5_CHILDPROCESS__
+#define __NOMAD_4_5_CHILDPROCESS__
+
+#include <cstdio>
+#include <functional>
+#include <string>
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Result of ChildProcess::readLine().
+enum class ChildProcessReadStatus
+{
+    LINE_READ,      ///< A complete line was read
+    END_OF_OUTPUT,  ///< The process closed its standard output
+    STOPPED,        ///< The stop predicate returned true before a line was available
+    READ_ERROR      ///< The output of the process could not be read
+};
+
+
+/// Class to run a command through the shell and read its standard output.
+/**
+ Replacement for popen/pclose that can be interrupted. The command is run by
+ \c /bin/sh in its own process group, so that kill() terminates the command and
+ all the processes it spawned (ex. a script calling the actual blackbox).
+
+ While waiting for output, the stop predicate given to the constructor is polled
+ regularly. When it returns \c true, readLine() returns
+ ChildProcessReadStatus::STOPPED and the caller is expected to call kill().
+
+ \note On Windows, _popen is used: the process group is not available and the
+ stop predicate is never polled.
+ */
+class DLL_UTIL_API ChildProcess
+{
+private:
+    std::function<bool()> _stopRequested;   ///< Polled while waiting for output. May be empty.
+    std::string     _pending;               ///< Output read but not yet returned as a line
+    bool            _endOfOutput;
+#ifdef _WIN32
+    FILE*           _file;
+#else
+    int             _fd;                    ///< Read end of the pipe to the standard output of the process
+    int             _pid;                   ///< Process id, also the process group id
+#endif
+
+public:
+    /// Constructor
+    /**
+     \param stopRequested   Predicate polled while waiting for output -- \b IN.
+     */
+    explicit ChildProcess(std::function<bool()> stopRequested = nullptr);
+
+    /// Destructor. Kills the process if it is still running and waits for it.
+    virtual ~ChildProcess();
+
+    ChildProcess(const ChildProcess&) = delete;
+    ChildProcess& operator=(const ChildProcess&) = delete;
+
+    /// Start the command. Return \c false if the process could not be created.
+    bool start(const std::string& cmd);
+
+    /// Read the next line of the standard output, without the trailing end-of-line.
+    ChildProcessReadStatus readLine(std::string& line);
+
+    /// Kill the process group of the command.
+    void kill();
+
+    /// Wait for the end of the process.
+    /**
+     \return The exit status of the command, in the same format as pclose(). Zero means success.
+     */
+    int close();
+};
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_CHILDPROCESS__
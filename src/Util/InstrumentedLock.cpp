@@ -0,0 +1,256 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   InstrumentedLock.cpp
+ \brief  OpenMP locks with an optional contention profile
+ \author Christophe Tribes
+ \date   October 2026
+ \see    InstrumentedLock.hpp
+ */
+#include "../Util/InstrumentedLock.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+
+std::atomic<bool> NOMAD::InstrumentedLock::_profileEnabled(false);
+
+
+namespace
+{
+    // Statistics by name of lock, and locks of the critical sections by
+    // name. They are created at the first use, and never destroyed: static
+    // locks may be used until the end of the program.
+    struct LockRegistry
+    {
+        std::mutex  _mutex;
+        std::map<std::string, std::unique_ptr<NOMAD::LockStats>> _stats;
+        std::map<std::string, std::unique_ptr<NOMAD::InstrumentedLock>> _namedLocks;
+    };
+
+    LockRegistry& getRegistry()
+    {
+        static LockRegistry* registry = new LockRegistry();
+        return *registry;
+    }
+
+    NOMAD::LockStats* getStats(const std::string& name)
+    {
+        LockRegistry& registry = getRegistry();
+        std::lock_guard<std::mutex> guard(registry._mutex);
+        auto& stats = registry._stats[name];
+        if (nullptr == stats)
+        {
+            stats.reset(new NOMAD::LockStats());
+            stats->_name = name;
+        }
+        return stats.get();
+    }
+
+    int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+
+NOMAD::InstrumentedLock::InstrumentedLock(const std::string& name)
+  : _stats(getStats(name)),
+    _profiled(false),
+    _acquireTime(0)
+{
+#ifdef _OPENMP
+    omp_init_lock(&_lock);
+#endif // _OPENMP
+}
+
+
+NOMAD::InstrumentedLock::~InstrumentedLock()
+{
+#ifdef _OPENMP
+    omp_destroy_lock(&_lock);
+#endif // _OPENMP
+}
+
+
+void NOMAD::InstrumentedLock::setProfiled()
+{
+#ifdef _OPENMP
+    const int64_t startTime = nowNs();
+    bool contended = false;
+    if (!omp_test_lock(&_lock))
+    {
+        contended = true;
+        omp_set_lock(&_lock);
+    }
+    _acquireTime = nowNs();
+    _profiled = true;
+
+    _stats->_nbAcquisitions++;
+    if (contended)
+    {
+        const uint64_t waitTime = static_cast<uint64_t>(_acquireTime - startTime);
+        _stats->_nbContended++;
+        _stats->_waitTime += waitTime;
+        uint64_t maxWaitTime = _stats->_maxWaitTime.load();
+        while (waitTime > maxWaitTime && !_stats->_maxWaitTime.compare_exchange_weak(maxWaitTime, waitTime))
+        {
+            // maxWaitTime was updated by compare_exchange_weak. Try again.
+        }
+    }
+#endif // _OPENMP
+}
+
+
+void NOMAD::InstrumentedLock::unsetProfiled()
+{
+#ifdef _OPENMP
+    _stats->_holdTime += static_cast<uint64_t>(nowNs() - _acquireTime);
+    _profiled = false;
+    omp_unset_lock(&_lock);
+#endif // _OPENMP
+}
+
+
+NOMAD::InstrumentedLock& NOMAD::InstrumentedLock::getNamedLock(const std::string& name)
+{
+    LockRegistry& registry = getRegistry();
+    std::unique_ptr<NOMAD::InstrumentedLock>* lock = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(registry._mutex);
+        lock = &registry._namedLocks[name];
+        if (nullptr != *lock)
+        {
+            return **lock;
+        }
+    }
+    // The constructor takes the registry mutex for the statistics.
+    std::unique_ptr<NOMAD::InstrumentedLock> newLock(new NOMAD::InstrumentedLock("critical(" + name + ")"));
+    std::lock_guard<std::mutex> guard(registry._mutex);
+    if (nullptr == *lock)
+    {
+        *lock = std::move(newLock);
+    }
+    return **lock;
+}
+
+
+void NOMAD::InstrumentedLock::enableProfile(const bool enable)
+{
+    if (enable)
+    {
+        LockRegistry& registry = getRegistry();
+        std::lock_guard<std::mutex> guard(registry._mutex);
+        for (auto& nameStats : registry._stats)
+        {
+            LockStats& stats = *nameStats.second;
+            stats._nbAcquisitions = 0;
+            stats._nbContended = 0;
+            stats._waitTime = 0;
+            stats._maxWaitTime = 0;
+            stats._holdTime = 0;
+        }
+    }
+    _profileEnabled = enable;
+}
+
+
+std::vector<std::string> NOMAD::InstrumentedLock::getContentionReport()
+{
+    std::vector<const LockStats*> allStats;
+    {
+        LockRegistry& registry = getRegistry();
+        std::lock_guard<std::mutex> guard(registry._mutex);
+        for (const auto& nameStats : registry._stats)
+        {
+            if (nameStats.second->_nbAcquisitions > 0)
+            {
+                allStats.push_back(nameStats.second.get());
+            }
+        }
+    }
+    std::sort(allStats.begin(), allStats.end(),
+              [](const LockStats* s1, const LockStats* s2)
+              {
+                  if (s1->_waitTime != s2->_waitTime)
+                  {
+                      return s1->_waitTime > s2->_waitTime;
+                  }
+                  return s1->_holdTime > s2->_holdTime;
+              });
+
+    size_t nameWidth = 4;
+    for (const auto stats : allStats)
+    {
+        nameWidth = std::max(nameWidth, stats->_name.size());
+    }
+
+    std::vector<std::string> report;
+    std::ostringstream oss;
+    oss << std::left << std::setw(static_cast<int>(nameWidth)) << "Lock" << std::right
+        << std::setw(14) << "Acquisitions" << std::setw(12) << "Contended"
+        << std::setw(14) << "Wait (ms)" << std::setw(14) << "Max wait (ms)" << std::setw(14) << "Hold (ms)";
+    report.push_back(oss.str());
+    for (const auto stats : allStats)
+    {
+        oss.str("");
+        oss << std::fixed << std::setprecision(3);
+        oss << std::left << std::setw(static_cast<int>(nameWidth)) << stats->_name << std::right
+            << std::setw(14) << stats->_nbAcquisitions.load()
+            << std::setw(12) << stats->_nbContended.load()
+            << std::setw(14) << static_cast<double>(stats->_waitTime.load()) / 1e6
+            << std::setw(14) << static_cast<double>(stats->_maxWaitTime.load()) / 1e6
+            << std::setw(14) << static_cast<double>(stats->_holdTime.load()) / 1e6;
+        report.push_back(oss.str());
+    }
+    return report;
+}
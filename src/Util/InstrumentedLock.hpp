@@ -0,0 +1,230 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   InstrumentedLock.hpp
+ \brief  OpenMP locks with an optional contention profile
+ \author Christophe Tribes
+ \date   October 2026
+ \see    InstrumentedLock.cpp
+ */
+#ifndef __NOMAD_4_5_INSTRUMENTEDLOCK__
+#define __NOMAD_4_5_INSTRUMENTEDLOCK__
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Contention statistics of the locks with the same name.
+struct LockStats
+{
+    std::string             _name;
+    std::atomic<uint64_t>   _nbAcquisitions {0};
+    std::atomic<uint64_t>   _nbContended {0};   ///< Acquisitions that had to wait
+    std::atomic<uint64_t>   _waitTime {0};      ///< Total time waiting for the lock, in nanoseconds
+    std::atomic<uint64_t>   _maxWaitTime {0};   ///< In nanoseconds
+    std::atomic<uint64_t>   _holdTime {0};      ///< Total time holding the lock, in nanoseconds
+};
+
+
+/// OpenMP lock, with an optional contention profile.
+/**
+ A drop-in replacement of \c omp_lock_t. When the profile is enabled
+ (parameter LOCK_CONTENTION_REPORT), the number of acquisitions, the time
+ waiting for the lock and the time holding it are added to the statistics of
+ the name of the lock. The locks with the same name share their statistics.
+ When the profile is disabled, set() costs an atomic load more than
+ \c omp_set_lock.
+
+ The critical sections (\c #pragma \c omp \c critical(name)) are replaced by
+ NOMAD_CRITICAL(name), which takes a lock shared by all the critical sections
+ with the same name.
+
+ Without OpenMP, the lock does nothing.
+ */
+class DLL_UTIL_API InstrumentedLock
+{
+private:
+    static std::atomic<bool> _profileEnabled;
+
+#ifdef _OPENMP
+    omp_lock_t      _lock;
+#endif // _OPENMP
+    LockStats*      _stats;         ///< Owned by the registry of statistics. Never deleted.
+    bool            _profiled;      ///< The current acquisition is profiled. Access by the holder only.
+    int64_t         _acquireTime;   ///< Access by the holder only.
+
+public:
+    /// Constructor
+    /**
+     \param name    Name of the lock, for the contention report -- \b IN.
+     */
+    explicit InstrumentedLock(const std::string& name);
+
+    /// Destructor
+    ~InstrumentedLock();
+
+    InstrumentedLock(const InstrumentedLock&) = delete;
+    InstrumentedLock& operator=(const InstrumentedLock&) = delete;
+
+    /// Wait for the lock and take it, as \c omp_set_lock.
+    void set()
+    {
+#ifdef _OPENMP
+        if (!_profileEnabled.load(std::memory_order_relaxed))
+        {
+            omp_set_lock(&_lock);
+            _profiled = false;
+            return;
+        }
+        setProfiled();
+#endif // _OPENMP
+    }
+
+    /// Release the lock, as \c omp_unset_lock.
+    void unset()
+    {
+#ifdef _OPENMP
+        if (_profiled)
+        {
+            unsetProfiled();
+            return;
+        }
+        omp_unset_lock(&_lock);
+#endif // _OPENMP
+    }
+
+    /// Take the lock if it is free, as \c omp_test_lock. Not counted in the profile.
+    /**
+     \return    \c true if the lock was taken.
+     */
+    bool test()
+    {
+#ifdef _OPENMP
+        if (omp_test_lock(&_lock))
+        {
+            _profiled = false;
+            return true;
+        }
+        return false;
+#else
+        return true;
+#endif // _OPENMP
+    }
+
+    /// The lock shared by the critical sections with this name.
+    /**
+     The lock is created at the first call, and never destroyed.
+     \param name    Name of the critical section -- \b IN.
+     */
+    static InstrumentedLock& getNamedLock(const std::string& name);
+
+    /// Enable or disable the profile. The statistics are reset when it is enabled.
+    static void enableProfile(const bool enable);
+
+    static bool isProfileEnabled() { return _profileEnabled.load(std::memory_order_relaxed); }
+
+    /// Contention report: one line per name of lock, by decreasing wait time, then hold time.
+    static std::vector<std::string> getContentionReport();
+
+private:
+    void setProfiled();
+    void unsetProfiled();
+};
+
+
+/// Take a lock for the duration of a scope.
+class DLL_UTIL_API InstrumentedLockGuard
+{
+private:
+    InstrumentedLock& _lock;
+
+public:
+    explicit InstrumentedLockGuard(InstrumentedLock& lock)
+      : _lock(lock)
+    {
+        _lock.set();
+    }
+
+    ~InstrumentedLockGuard()
+    {
+        _lock.unset();
+    }
+
+    InstrumentedLockGuard(const InstrumentedLockGuard&) = delete;
+    InstrumentedLockGuard& operator=(const InstrumentedLockGuard&) = delete;
+};
+
+#include "../nomad_nsend.hpp"
+
+
+/// Critical section until the end of the current scope. Replaces \c #pragma \c omp \c critical(name).
+/**
+ \b Example:
+ \code
+ {
+     NOMAD_CRITICAL(cacheUpdate);
+     // Only one thread at a time
+ }
+ \endcode
+ */
+#ifdef _OPENMP
+#define NOMAD_CRITICAL(name) \
+    static NOMAD::InstrumentedLock& nomadCriticalLock_##name = NOMAD::InstrumentedLock::getNamedLock(#name); \
+    NOMAD::InstrumentedLockGuard nomadCriticalGuard_##name(nomadCriticalLock_##name)
+#else
+#define NOMAD_CRITICAL(name)
+#endif // _OPENMP
+
+#endif // __NOMAD_4_5_INSTRUMENTEDLOCK__
@@ -0,0 +1,155 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   MemoryFootprint.cpp
+ \brief  Estimate of the memory held by the subsystems (parameter MEMORY_STATS_FREQUENCY)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    MemoryFootprint.hpp
+ */
+#include "../Util/InstrumentedLock.hpp"
+#include "../Util/MemoryFootprint.hpp"
+
+#include <algorithm>
+
+
+std::map<size_t, NOMAD::MemoryFootprint::Entry> NOMAD::MemoryFootprint::_entries;
+size_t NOMAD::MemoryFootprint::_nextId = 0;
+NOMAD::MemoryFootprint::Callback NOMAD::MemoryFootprint::_callback;
+
+
+// The subsystems always displayed, in this order.
+static const std::vector<std::string> MAIN_SUBSYSTEMS = { "cache",
+                                                          "barriers",
+                                                          "sgtelibTrainingSets",
+                                                          "evaluatorControl",
+                                                          "outputQueue" };
+
+
+size_t NOMAD::MemoryFootprint::add(const std::string& name, Estimator estimator)
+{
+    NOMAD_CRITICAL(memoryFootprint);
+    const size_t id = _nextId++;
+    _entries[id] = {name, std::move(estimator)};
+    return id;
+}
+
+
+void NOMAD::MemoryFootprint::remove(const size_t id)
+{
+    // getUsage() calls the estimators under the same lock.
+    NOMAD_CRITICAL(memoryFootprint);
+    _entries.erase(id);
+}
+
+
+std::vector<NOMAD::MemoryUsage> NOMAD::MemoryFootprint::getUsage()
+{
+    std::vector<MemoryUsage> usage;
+    for (const auto& name : MAIN_SUBSYSTEMS)
+    {
+        usage.push_back({name, 0, 0});
+    }
+    const size_t nbMainSubsystems = usage.size();
+
+    {
+        NOMAD_CRITICAL(memoryFootprint);
+        for (const auto& idEntry : _entries)
+        {
+            const Entry& entry = idEntry.second;
+            auto it = std::find_if(usage.begin(), usage.end(),
+                                   [&entry](const MemoryUsage& u) { return u._name == entry._name; });
+            if (usage.end() == it)
+            {
+                usage.push_back({entry._name, 0, 0});
+                it = usage.end() - 1;
+            }
+            it->_bytes += entry._estimator();
+            it->_nbObjects++;
+        }
+    }
+
+    std::sort(usage.begin() + nbMainSubsystems, usage.end(),
+              [](const MemoryUsage& u1, const MemoryUsage& u2) { return u1._name < u2._name; });
+
+    return usage;
+}
+
+
+void NOMAD::MemoryFootprint::setCallback(Callback callback)
+{
+    NOMAD_CRITICAL(memoryFootprintCallback);
+    _callback = std::move(callback);
+}
+
+
+std::string NOMAD::MemoryFootprint::report(const size_t bbe)
+{
+    const auto usage = getUsage();
+    {
+        NOMAD_CRITICAL(memoryFootprintCallback);
+        if (_callback)
+        {
+            _callback(bbe, usage);
+        }
+    }
+    return display(usage);
+}
+
+
+std::string NOMAD::MemoryFootprint::display(const std::vector<MemoryUsage>& usage)
+{
+    std::string s = "Memory (bytes):";
+    size_t total = 0;
+    for (const auto& u : usage)
+    {
+        s += " " + u._name + "=" + std::to_string(u._bytes);
+        total += u._bytes;
+    }
+    s += " total=" + std::to_string(total);
+    return s;
+}
@@ -0,0 +1,182 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   MemoryFootprint.hpp
+ \brief  Estimate of the memory held by the subsystems (parameter MEMORY_STATS_FREQUENCY)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    MemoryFootprint.cpp
+ */
+#ifndef __NOMAD_4_5_MEMORYFOOTPRINT__
+#define __NOMAD_4_5_MEMORYFOOTPRINT__
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Memory held by the objects of a subsystem.
+struct MemoryUsage
+{
+    std::string     _name;          ///< Name of the subsystem, for instance "cache"
+    size_t          _bytes;         ///< Estimate, in bytes
+    size_t          _nbObjects;     ///< Number of live objects of the subsystem
+};
+
+
+/// Registry of the estimators of the memory held by the subsystems.
+/**
+ The cache, the barriers, the training sets of the sgtelib models, the
+ evaluator control and the output queue register an estimator of the bytes
+ they hold. The estimates add the sizes of the containers and of the points
+ they hold: they do not include the overhead of the memory allocator, and the
+ points shared by several subsystems are counted in each of them.
+
+ The usage may be read at any time with getUsage(). When the parameter
+ MEMORY_STATS_FREQUENCY is set, report() is called every that many blackbox
+ evaluations: it displays a stats line and calls the callback, if any.
+
+ \b Example, in library mode:
+ \code
+ MemoryFootprint::setCallback([](const size_t bbe, const std::vector<MemoryUsage>& usage)
+ {
+     // Log the usage, detect growth...
+ });
+ \endcode
+ */
+class DLL_UTIL_API MemoryFootprint
+{
+public:
+    /// Estimate of the bytes held by an object.
+    typedef std::function<size_t()> Estimator;
+
+    /// Called by report(), with the number of blackbox evaluations and the usage.
+    typedef std::function<void(const size_t bbe, const std::vector<MemoryUsage>& usage)> Callback;
+
+private:
+    struct Entry
+    {
+        std::string     _name;
+        Estimator       _estimator;
+    };
+
+    static std::map<size_t, Entry>  _entries;   ///< Estimators by identifier
+    static size_t                   _nextId;
+    static Callback                 _callback;
+
+public:
+    // No need for constructor. All is static.
+
+    /// Register an estimator.
+    /**
+     \param name        Name of the subsystem, without spaces. The estimates of the same name are added -- \b IN.
+     \param estimator   Estimator of the bytes held by the object -- \b IN.
+     \return            Identifier, for remove().
+     */
+    static size_t add(const std::string& name, Estimator estimator);
+
+    /// Unregister an estimator. After it returns, the estimator is not running and will not be called.
+    static void remove(const size_t id);
+
+    /// Current usage, by name of subsystem.
+    /**
+     The subsystems are always in the same order: cache, barriers, sgtelib,
+     evaluator control, output queue, then the other names in alphabetical order.
+     */
+    static std::vector<MemoryUsage> getUsage();
+
+    /// Set the callback of report(). An empty function removes it.
+    static void setCallback(Callback callback);
+
+    /// Compute the usage, call the callback and return the stats line.
+    /**
+     \param bbe     Number of blackbox evaluations -- \b IN.
+     \return        The stats line, for instance "Memory (bytes): cache=12345 barriers=678 ... total=13023".
+     */
+    static std::string report(const size_t bbe);
+
+    /// Stats line of the usage.
+    static std::string display(const std::vector<MemoryUsage>& usage);
+};
+
+
+/// Registration of an estimator for the lifetime of an object.
+/**
+ Declare it as the last member of the class: it is destroyed first, before
+ the members read by the estimator.
+ */
+class DLL_UTIL_API MemoryFootprintRegistration
+{
+private:
+    size_t _id;
+
+public:
+    /// Constructor
+    /**
+     \param name        Name of the subsystem -- \b IN.
+     \param estimator   Estimator of the bytes held by the object -- \b IN.
+     */
+    MemoryFootprintRegistration(const std::string& name, MemoryFootprint::Estimator estimator)
+      : _id(MemoryFootprint::add(name, std::move(estimator)))
+    {
+    }
+
+    ~MemoryFootprintRegistration()
+    {
+        MemoryFootprint::remove(_id);
+    }
+
+    MemoryFootprintRegistration(const MemoryFootprintRegistration&) = delete;
+    MemoryFootprintRegistration& operator=(const MemoryFootprintRegistration&) = delete;
+};
+
+#include "../nomad_nsend.hpp"
+
+#endif // __NOMAD_4_5_MEMORYFOOTPRINT__
@@ -0,0 +1,220 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   RingBuffer.hpp
+ \brief  Bounded lock-free queue with many producers and one consumer
+ \author Christophe Tribes
+ \date   October 2026
+ */
+#ifndef __NOMAD_4_5_RINGBUFFER__
+#define __NOMAD_4_5_RINGBUFFER__
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "../nomad_nsbegin.hpp"
+
+/// Bounded queue with many producers and one consumer.
+/**
+ The elements are kept in a circular array. Each cell has a sequence number
+ telling if it is free for the producer of a given position, or filled for
+ the consumer of this position. Producers reserve a position with a
+ compare-and-swap on the tail and never wait for each other; the consumer
+ does not take any lock.
+
+ The capacity is rounded up to a power of 2. When the queue is full,
+ tryPush() returns \c false: the caller decides to drop the element or to
+ try again later.
+
+ \b Example:
+ \code
+ RingBuffer<std::string> ring(1024);
+ ring.tryPush("text");  // Any thread
+ std::string s;
+ while (ring.tryPop(s)) // A single thread
+ {
+     std::cout << s << std::endl;
+ }
+ \endcode
+ */
+template<typename T>
+class RingBuffer
+{
+private:
+    struct Cell
+    {
+        std::atomic<size_t> _sequence;
+        alignas(T) unsigned char _storage[sizeof(T)];
+
+        T* get() { return reinterpret_cast<T*>(_storage); }
+    };
+
+    size_t                      _mask;
+    std::unique_ptr<Cell[]>     _cells;
+
+    // Head and tail are on different cache lines: producers and consumer
+    // do not invalidate each other's line.
+    alignas(64) std::atomic<size_t> _tail;  ///< Next position for a producer
+    alignas(64) std::atomic<size_t> _head;  ///< Next position for the consumer. Only the consumer modifies it.
+
+public:
+    /// Constructor
+    /**
+     \param capacity    Minimum number of elements in the queue -- \b IN.
+     */
+    explicit RingBuffer(const size_t capacity)
+      : _mask(0),
+        _cells(),
+        _tail(0),
+        _head(0)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        _mask = size - 1;
+        _cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; i++)
+        {
+            _cells[i]._sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /// Destructor. The elements not taken are destroyed.
+    ~RingBuffer()
+    {
+        for (size_t pos = _head.load(); ; pos++)
+        {
+            Cell& cell = _cells[pos & _mask];
+            if (cell._sequence.load() != pos + 1)
+            {
+                break;
+            }
+            cell.get()->~T();
+        }
+    }
+
+    size_t getCapacity() const { return _mask + 1; }
+
+    /// Approximate number of elements in the queue.
+    size_t size() const
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        const size_t head = _head.load(std::memory_order_relaxed);
+        return (tail > head) ? tail - head : 0;
+    }
+
+    /// Add an element. Thread-safe.
+    /**
+     \param value   The element, moved in the queue if there is room -- \b IN.
+     \return        \c false if the queue is full. The value is not moved.
+     */
+    bool tryPush(T&& value)
+    {
+        size_t pos = _tail.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell& cell = _cells[pos & _mask];
+            const size_t sequence = cell._sequence.load(std::memory_order_acquire);
+            if (sequence == pos)
+            {
+                // The cell is free for this position. Reserve it.
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    new (cell.get()) T(std::move(value));
+                    cell._sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // pos was updated by compare_exchange_weak. Try again.
+            }
+            else if (sequence < pos)
+            {
+                // The cell still holds the element of the previous turn: full.
+                return false;
+            }
+            else
+            {
+                // Another producer took this position.
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Take the oldest element. Must be called by a single thread.
+    /**
+     \param value   The element taken -- \b OUT.
+     \return        \c false if the queue is empty, or if the oldest element is
+                    still being written by its producer.
+     */
+    bool tryPop(T& value)
+    {
+        const size_t pos = _head.load(std::memory_order_relaxed);
+        Cell& cell = _cells[pos & _mask];
+        if (cell._sequence.load(std::memory_order_acquire) != pos + 1)
+        {
+            return false;
+        }
+
+        value = std::move(*cell.get());
+        cell.get()->~T();
+        _head.store(pos + 1, std::memory_order_relaxed);
+        // The cell is free for the producer of the next turn.
+        cell._sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#include "../nomad_nsend.hpp"
+
+#endif // __NOMAD_4_5_RINGBUFFER__
@@ -0,0 +1,452 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   Socket.cpp
+ \brief  Line-oriented stream sockets (TCP or Unix-domain)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    Socket.hpp
+ */
+#include "../Util/Socket.hpp"
+#include "../Util/defines.hpp"  // For BUFFER_SIZE
+
+#include <chrono>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+namespace {
+
+    const std::string UNIX_PREFIX = "unix:";
+
+    // Split "host:port". Host may be empty.
+    bool splitHostPort(const std::string& address, std::string& host, std::string& port, std::string& errMsg)
+    {
+        size_t pos = address.find_last_of(':');
+        if (std::string::npos == pos || pos + 1 == address.size())
+        {
+            errMsg = "Invalid socket address \"" + address + "\": expecting host:port or unix:path";
+            return false;
+        }
+        host = address.substr(0, pos);
+        port = address.substr(pos + 1);
+        return true;
+    }
+
+    bool makeUnixAddress(const std::string& path, struct sockaddr_un& addr, std::string& errMsg)
+    {
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(addr.sun_path))
+        {
+            errMsg = "Invalid Unix socket path \"" + path + "\"";
+            return false;
+        }
+        strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        return true;
+    }
+
+    void setSocketOptions(int fd, bool isTcp)
+    {
+        int one = 1;
+        if (isTcp)
+        {
+            // Messages are small: send them right away.
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+#ifdef SO_NOSIGPIPE
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    }
+
+}
+#endif // _WIN32
+
+
+NOMAD::Socket::Socket()
+  : _fd(-1),
+    _pending(),
+    _unixPath()
+{
+}
+
+
+NOMAD::Socket::Socket(int fd)
+  : _fd(fd),
+    _pending(),
+    _unixPath()
+{
+}
+
+
+NOMAD::Socket::~Socket()
+{
+    close();
+}
+
+
+#ifdef _WIN32
+
+bool NOMAD::Socket::connect(const std::string& address, std::string& errMsg)
+{
+    errMsg = "Sockets are not supported on Windows";
+    return false;
+}
+
+
+bool NOMAD::Socket::listen(const std::string& address, std::string& errMsg)
+{
+    errMsg = "Sockets are not supported on Windows";
+    return false;
+}
+
+
+std::unique_ptr<NOMAD::Socket> NOMAD::Socket::accept(const int timeoutMs)
+{
+    return nullptr;
+}
+
+
+bool NOMAD::Socket::sendLine(const std::string& line)
+{
+    return false;
+}
+
+
+NOMAD::SocketReadStatus NOMAD::Socket::readLine(std::string& line, const int timeoutMs)
+{
+    return NOMAD::SocketReadStatus::READ_ERROR;
+}
+
+
+void NOMAD::Socket::close()
+{
+    _fd = -1;
+}
+
+#else // POSIX
+
+bool NOMAD::Socket::connect(const std::string& address, std::string& errMsg)
+{
+    close();
+    _pending.clear();
+
+    if (0 == address.compare(0, UNIX_PREFIX.size(), UNIX_PREFIX))
+    {
+        struct sockaddr_un addr;
+        if (!makeUnixAddress(address.substr(UNIX_PREFIX.size()), addr, errMsg))
+        {
+            return false;
+        }
+        _fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (_fd < 0 || 0 != ::connect(_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)))
+        {
+            errMsg = "Cannot connect to " + address + ": " + strerror(errno);
+            close();
+            return false;
+        }
+        setSocketOptions(_fd, false);
+        return true;
+    }
+
+    std::string host, port;
+    if (!splitHostPort(address, host, port, errMsg))
+    {
+        return false;
+    }
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* result = nullptr;
+    int err = getaddrinfo(host.empty() ? "localhost" : host.c_str(), port.c_str(), &hints, &result);
+    if (0 != err)
+    {
+        errMsg = "Cannot resolve " + address + ": " + gai_strerror(err);
+        return false;
+    }
+    for (struct addrinfo* rp = result; nullptr != rp; rp = rp->ai_next)
+    {
+        _fd = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
+        if (_fd < 0)
+        {
+            continue;
+        }
+        if (0 == ::connect(_fd, rp->ai_addr, rp->ai_addrlen))
+        {
+            break;
+        }
+        close();
+    }
+    freeaddrinfo(result);
+
+    if (_fd < 0)
+    {
+        errMsg = "Cannot connect to " + address + ": " + strerror(errno);
+        return false;
+    }
+    setSocketOptions(_fd, true);
+    return true;
+}
+
+
+bool NOMAD::Socket::listen(const std::string& address, std::string& errMsg)
+{
+    close();
+
+    if (0 == address.compare(0, UNIX_PREFIX.size(), UNIX_PREFIX))
+    {
+        const std::string path = address.substr(UNIX_PREFIX.size());
+        struct sockaddr_un addr;
+        if (!makeUnixAddress(path, addr, errMsg))
+        {
+            return false;
+        }
+        // Remove a socket file left by a previous daemon.
+        unlink(path.c_str());
+        _fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (_fd < 0
+            || 0 != bind(_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr))
+            || 0 != ::listen(_fd, 16))
+        {
+            errMsg = "Cannot listen on " + address + ": " + strerror(errno);
+            close();
+            return false;
+        }
+        _unixPath = path;
+        return true;
+    }
+
+    std::string host, port;
+    if (!splitHostPort(address, host, port, errMsg))
+    {
+        return false;
+    }
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    struct addrinfo* result = nullptr;
+    int err = getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result);
+    if (0 != err)
+    {
+        errMsg = "Cannot resolve " + address + ": " + gai_strerror(err);
+        return false;
+    }
+    for (struct addrinfo* rp = result; nullptr != rp; rp = rp->ai_next)
+    {
+        _fd = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
+        if (_fd < 0)
+        {
+            continue;
+        }
+        int one = 1;
+        setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (0 == bind(_fd, rp->ai_addr, rp->ai_addrlen) && 0 == ::listen(_fd, 16))
+        {
+            break;
+        }
+        close();
+    }
+    freeaddrinfo(result);
+
+    if (_fd < 0)
+    {
+        errMsg = "Cannot listen on " + address + ": " + strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+
+std::unique_ptr<NOMAD::Socket> NOMAD::Socket::accept(const int timeoutMs)
+{
+    if (_fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = _fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, timeoutMs) <= 0)
+    {
+        return nullptr;
+    }
+
+    int fd = ::accept(_fd, nullptr, nullptr);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    setSocketOptions(fd, _unixPath.empty());
+
+    return std::unique_ptr<NOMAD::Socket>(new NOMAD::Socket(fd));
+}
+
+
+bool NOMAD::Socket::sendLine(const std::string& line)
+{
+    if (_fd < 0)
+    {
+        return false;
+    }
+
+    int flags = 0;
+#ifdef MSG_NOSIGNAL
+    flags = MSG_NOSIGNAL;   // Lost connection must not kill the process.
+#endif
+    const std::string msg = line + "\n";
+    size_t sent = 0;
+    while (sent < msg.size())
+    {
+        ssize_t n = send(_fd, msg.data() + sent, msg.size() - sent, flags);
+        if (n < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+
+NOMAD::SocketReadStatus NOMAD::Socket::readLine(std::string& line, const int timeoutMs)
+{
+    line.clear();
+    if (_fd < 0)
+    {
+        return NOMAD::SocketReadStatus::CLOSED;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    char buffer[BUFFER_SIZE];
+
+    while (true)
+    {
+        size_t posEol = _pending.find('\n');
+        if (std::string::npos != posEol)
+        {
+            line = _pending.substr(0, posEol);
+            _pending.erase(0, posEol + 1);
+            return NOMAD::SocketReadStatus::LINE_READ;
+        }
+
+        int waitMs = -1;
+        if (timeoutMs >= 0)
+        {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            waitMs = std::max(0, static_cast<int>(remaining.count()));
+        }
+
+        struct pollfd pfd;
+        pfd.fd = _fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int nbReady = poll(&pfd, 1, waitMs);
+        if (nbReady < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return NOMAD::SocketReadStatus::READ_ERROR;
+        }
+        if (0 == nbReady)
+        {
+            return NOMAD::SocketReadStatus::TIMEOUT;
+        }
+
+        ssize_t nbRead = recv(_fd, buffer, sizeof(buffer), 0);
+        if (nbRead > 0)
+        {
+            _pending.append(buffer, static_cast<size_t>(nbRead));
+        }
+        else if (0 == nbRead)
+        {
+            return NOMAD::SocketReadStatus::CLOSED;
+        }
+        else if (EINTR != errno && EAGAIN != errno)
+        {
+            return NOMAD::SocketReadStatus::READ_ERROR;
+        }
+    }
+}
+
+
+void NOMAD::Socket::close()
+{
+    if (_fd >= 0)
+    {
+        ::close(_fd);
+        _fd = -1;
+    }
+    if (!_unixPath.empty())
+    {
+        unlink(_unixPath.c_str());
+        _unixPath.clear();
+    }
+}
+
+#endif // _WIN32
@@ -0,0 +1,148 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   Socket.hpp
+ \brief  Line-oriented stream sockets (TCP or Unix-domain)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    Socket.cpp
+ */
+#ifndef __NOMAD_4_5_SOCKET__
+#define __NOMAD_4_5_SOCKET__
+
+#include <memory>
+#include <string>
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Result of Socket::readLine().
+enum class SocketReadStatus
+{
+    LINE_READ,  ///< A complete line was read
+    TIMEOUT,    ///< No complete line was available before the timeout
+    CLOSED,     ///< The peer closed the connection
+    READ_ERROR  ///< The socket could not be read
+};
+
+
+/// Class for a stream socket exchanging lines of text.
+/**
+ Used for the communication between the SocketEvaluator and the
+ \c nomad_worker daemons. An address is either:
+ - \c unix:path for a Unix-domain socket,
+ - \c host:port for a TCP socket. To listen on all interfaces, use \c :port.
+
+ Messages are sent as lines ending with \c '\\n'.
+
+ \note Not available on Windows: connect() and listen() return \c false.
+ */
+class DLL_UTIL_API Socket
+{
+private:
+    int         _fd;        ///< File descriptor of the socket, -1 if closed
+    std::string _pending;   ///< Data received but not yet returned as a line
+    std::string _unixPath;  ///< For a listening Unix-domain socket: file to remove on close
+
+public:
+    /// Constructor of a closed socket
+    Socket();
+
+    /// Constructor from an open file descriptor
+    explicit Socket(int fd);
+
+    /// Destructor. Closes the socket.
+    virtual ~Socket();
+
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+
+    /// Connect to a listening socket.
+    /**
+     \param address     Address of the listening socket -- \b IN.
+     \param errMsg      Reason of the failure, if any -- \b OUT.
+     \return            \c true if the connection is established.
+     */
+    bool connect(const std::string& address, std::string& errMsg);
+
+    /// Listen for connections.
+    /**
+     \param address     Address to listen on -- \b IN.
+     \param errMsg      Reason of the failure, if any -- \b OUT.
+     \return            \c true if the socket is listening.
+     */
+    bool listen(const std::string& address, std::string& errMsg);
+
+    /// Wait for a connection on a listening socket.
+    /**
+     \param timeoutMs   Timeout in milliseconds. Negative for no timeout -- \b IN.
+     \return            The connected socket, or \c nullptr if no connection was made.
+     */
+    std::unique_ptr<Socket> accept(const int timeoutMs = -1);
+
+    /// Send a line. The end-of-line is added.
+    /**
+     \return \c false if the line could not be sent (connection lost).
+     */
+    bool sendLine(const std::string& line);
+
+    /// Read a line, without the trailing end-of-line.
+    /**
+     \param line        The line read -- \b OUT.
+     \param timeoutMs   Timeout in milliseconds. Zero to only check for an available line. Negative for no timeout -- \b IN.
+     */
+    SocketReadStatus readLine(std::string& line, const int timeoutMs);
+
+    bool isOpen() const { return (_fd >= 0); }
+
+    void close();
+};
+
+typedef std::shared_ptr<Socket> SocketPtr;
+
+#include "../nomad_nsend.hpp"
+#endif // __NOMAD_4_5_SOCKET__
@@ -0,0 +1,392 @@
+/*---------------------------------------------------------------------------------*/
+/*  NOMAD - Nonlinear Optimization by Mesh Adaptive Direct Search -                */
+/*                                                                                 */
+/*  NOMAD - Version 4 has been created and developed by                            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  The copyright of NOMAD - version 4 is owned by                                 */
+/*                 Charles Audet               - Polytechnique Montreal            */
+/*                 Sebastien Le Digabel        - Polytechnique Montreal            */
+/*                 Viviane Rochon Montplaisir  - Polytechnique Montreal            */
+/*                 Christophe Tribes           - Polytechnique Montreal            */
+/*                                                                                 */
+/*  NOMAD 4 has been funded by Rio Tinto, Hydro-Québec, Huawei-Canada,             */
+/*  NSERC (Natural Sciences and Engineering Research Council of Canada),           */
+/*  InnovÉÉ (Innovation en Énergie Électrique) and IVADO (The Institute            */
+/*  for Data Valorization)                                                         */
+/*                                                                                 */
+/*  NOMAD v3 was created and developed by Charles Audet, Sebastien Le Digabel,     */
+/*  Christophe Tribes and Viviane Rochon Montplaisir and was funded by AFOSR       */
+/*  and Exxon Mobil.                                                               */
+/*                                                                                 */
+/*  NOMAD v1 and v2 were created and developed by Mark Abramson, Charles Audet,    */
+/*  Gilles Couture, and John E. Dennis Jr., and were funded by AFOSR and           */
+/*  Exxon Mobil.                                                                   */
+/*                                                                                 */
+/*  Contact information:                                                           */
+/*    Polytechnique Montreal - GERAD                                               */
+/*    C.P. 6079, Succ. Centre-ville, Montreal (Quebec) H3C 3A7 Canada              */
+/*    e-mail: nomad@gerad.ca                                                       */
+/*                                                                                 */
+/*  This program is free software: you can redistribute it and/or modify it        */
+/*  under the terms of the GNU Lesser General Public License as published by       */
+/*  the Free Software Foundation, either version 3 of the License, or (at your     */
+/*  option) any later version.                                                     */
+/*                                                                                 */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT    */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or          */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License    */
+/*  for more details.                                                              */
+/*                                                                                 */
+/*  You should have received a copy of the GNU Lesser General Public License       */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.           */
+/*                                                                                 */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad           */
+/*---------------------------------------------------------------------------------*/
+/**
+ \file   nomad_worker.cpp
+ \brief  Worker daemon for distributed evaluations (parameter BB_WORKERS)
+ \author Christophe Tribes
+ \date   October 2026
+ \see    SocketEvaluator.hpp
+ */
+
+#include "../Eval/SocketEvaluator.hpp"
+#include "../Util/ChildProcess.hpp"
+#include "../Util/fileutils.hpp"
+#include "../Util/MicroSleep.hpp"
+#include "../Util/Socket.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <dlfcn.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+/// Signature of the evaluation function of a plugin.
+/**
+ \param x       The point to evaluate, with the same format as a line of the BB_EXE input file -- \b IN.
+ \param bbo     The blackbox outputs, with the same format as BB_EXE outputs -- \b OUT.
+ \param bboSize Size of the bbo buffer -- \b IN.
+ \return        Zero on success.
+ */
+typedef int (*PluginEvalFunction)(const char* x, char* bbo, int bboSize);
+
+static const char* PLUGIN_EVAL_FUNCTION_NAME = "nomad_worker_eval";
+static const int   PLUGIN_BBO_SIZE = 65536;
+
+
+/// Communication with the master while a job is running.
+class JobMonitor
+{
+private:
+    NOMAD::Socket&  _master;
+    const size_t    _jobId;
+    std::chrono::steady_clock::time_point _lastHeartbeat;
+    bool            _cancelled;
+    bool            _lost;
+
+public:
+    JobMonitor(NOMAD::Socket& master, const size_t jobId)
+      : _master(master),
+        _jobId(jobId),
+        _lastHeartbeat(std::chrono::steady_clock::now()),
+        _cancelled(false),
+        _lost(false)
+    {}
+
+    bool isLost() const { return _lost; }
+
+    /// Send heartbeats, and check for a cancellation or a lost master.
+    bool stopRequested()
+    {
+        if (_cancelled || _lost)
+        {
+            return true;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - _lastHeartbeat >= std::chrono::seconds(NOMAD::SocketEvaluator::WORKER_HEARTBEAT_PERIOD))
+        {
+            _lastHeartbeat = now;
+            if (!_master.sendLine(NOMAD::SocketEvaluator::MSG_HEARTBEAT))
+            {
+                _lost = true;
+                return true;
+            }
+        }
+
+        std::string line;
+        auto readStatus = _master.readLine(line, 0);
+        if (NOMAD::SocketReadStatus::LINE_READ == readStatus)
+        {
+            std::istringstream iss(line);
+            std::string keyword;
+            size_t jobId = 0;
+            if ((iss >> keyword >> jobId) && NOMAD::SocketEvaluator::MSG_CANCEL == keyword && jobId == _jobId)
+            {
+                _cancelled = true;
+            }
+        }
+        else if (NOMAD::SocketReadStatus::TIMEOUT != readStatus)
+        {
+            _lost = true;
+        }
+
+        return (_cancelled || _lost);
+    }
+};
+
+
+/// Run the blackbox executable on the points. Return false if the job was stopped.
+static bool runBBExe(const std::string& bbExe,
+                     const std::string& inputFile,
+                     const std::vector<std::string>& inputs,
+                     JobMonitor& monitor,
+                     std::vector<std::string>& outputs,
+                     int& exitStatus)
+{
+    std::ofstream xfile(inputFile, std::ios::out);
+    for (const auto& input : inputs)
+    {
+        xfile << input << std::endl;
+    }
+    xfile.close();
+
+    NOMAD::ChildProcess process([&monitor]() { return monitor.stopRequested(); });
+    if (!process.start(bbExe + " " + inputFile))
+    {
+        std::cerr << "Error: could not run " << bbExe << std::endl;
+        exitStatus = 1;
+        return true;
+    }
+
+    bool stopped = false;
+    std::string line;
+    NOMAD::ChildProcessReadStatus readStatus;
+    while (NOMAD::ChildProcessReadStatus::LINE_READ == (readStatus = process.readLine(line)))
+    {
+        outputs.push_back(line);
+    }
+    if (NOMAD::ChildProcessReadStatus::STOPPED == readStatus)
+    {
+        process.kill();
+        stopped = true;
+    }
+    exitStatus = process.close();
+    remove(inputFile.c_str());
+
+    return !stopped;
+}
+
+
+/// Run the plugin on the points, one at a time. Return false if the job was stopped.
+/**
+ The plugin function cannot be interrupted: a cancelled job stops after the
+ current point.
+ */
+static bool runPlugin(PluginEvalFunction evalFunction,
+                      const std::vector<std::string>& inputs,
+                      JobMonitor& monitor,
+                      std::vector<std::string>& outputs,
+                      int& exitStatus)
+{
+    exitStatus = 0;
+    for (const auto& input : inputs)
+    {
+        std::vector<char> bbo(PLUGIN_BBO_SIZE, '\0');
+        std::atomic<bool> done(false);
+        int status = 0;
+        std::thread evalThread([&]() {
+            status = evalFunction(input.c_str(), bbo.data(), PLUGIN_BBO_SIZE);
+            done = true;
+        });
+        while (!done)
+        {
+            monitor.stopRequested();
+            usleep(50000);
+        }
+        evalThread.join();
+
+        bbo[PLUGIN_BBO_SIZE - 1] = '\0';
+        outputs.push_back(std::string(bbo.data()));
+        if (0 != status)
+        {
+            exitStatus = status;
+        }
+        if (monitor.stopRequested())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/// Serve a master until it disconnects.
+static void serve(NOMAD::Socket& master,
+                  const std::string& bbExe,
+                  PluginEvalFunction evalFunction,
+                  const std::string& inputFile)
+{
+    while (true)
+    {
+        std::string line;
+        if (NOMAD::SocketReadStatus::LINE_READ != master.readLine(line, -1))
+        {
+            return;
+        }
+
+        std::istringstream iss(line);
+        std::string keyword;
+        size_t jobId = 0, nbPoints = 0;
+        if (!(iss >> keyword) || NOMAD::SocketEvaluator::MSG_EVAL != keyword || !(iss >> jobId >> nbPoints))
+        {
+            // CANCEL of a job already done, or unknown message.
+            continue;
+        }
+
+        std::vector<std::string> inputs;
+        for (size_t i = 0; i < nbPoints; i++)
+        {
+            std::string input;
+            if (NOMAD::SocketReadStatus::LINE_READ != master.readLine(input, -1))
+            {
+                return;
+            }
+            inputs.push_back(input);
+        }
+
+        JobMonitor monitor(master, jobId);
+        std::vector<std::string> outputs;
+        int exitStatus = 0;
+        bool completed = (nullptr != evalFunction)
+                            ? runPlugin(evalFunction, inputs, monitor, outputs, exitStatus)
+                            : runBBExe(bbExe, inputFile, inputs, monitor, outputs, exitStatus);
+        if (monitor.isLost())
+        {
+            return;
+        }
+        if (!completed)
+        {
+            outputs.clear();
+            exitStatus = -1;
+        }
+
+        bool sent = master.sendLine(std::string(NOMAD::SocketEvaluator::MSG_RESULT) + " " + std::to_string(jobId)
+                                    + " " + std::to_string(exitStatus) + " " + std::to_string(outputs.size()));
+        for (size_t i = 0; sent && i < outputs.size(); i++)
+        {
+            sent = master.sendLine(outputs[i]);
+        }
+        if (!sent)
+        {
+            return;
+        }
+    }
+}
+
+
+static void displayUsage(const char* exeName)
+{
+    std::cout << "Usage: " << exeName << " ADDRESS (--bb-exe \"command\" | --plugin library) [--tmp-dir directory]" << std::endl;
+    std::cout << "  ADDRESS is host:port, :port (all interfaces) or unix:path." << std::endl;
+    std::cout << "  --bb-exe  : blackbox executable, called with an input file as for BB_EXE." << std::endl;
+    std::cout << "  --plugin  : shared library with function" << std::endl;
+    std::cout << "              extern \"C\" int " << PLUGIN_EVAL_FUNCTION_NAME << "(const char* x, char* bbo, int bboSize)" << std::endl;
+    std::cout << "  --tmp-dir : directory for the input files of the blackbox executable (default: /tmp)." << std::endl;
+    std::cout << "Use parameter BB_WORKERS with the list of addresses to send evaluations to the workers." << std::endl;
+}
+
+
+/*------------------------------------------*/
+/*          nomad_worker main function      */
+/*------------------------------------------*/
+int main(int argc, char ** argv)
+{
+    std::string address, bbExe, pluginName, tmpDir = "/tmp";
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if ("--bb-exe" == arg && i + 1 < argc)
+        {
+            bbExe = argv[++i];
+        }
+        else if ("--plugin" == arg && i + 1 < argc)
+        {
+            pluginName = argv[++i];
+        }
+        else if ("--tmp-dir" == arg && i + 1 < argc)
+        {
+            tmpDir = argv[++i];
+        }
+        else if (address.empty() && '-' != arg[0])
+        {
+            address = arg;
+        }
+        else
+        {
+            displayUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (address.empty() || bbExe.empty() == pluginName.empty())
+    {
+        displayUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    PluginEvalFunction evalFunction = nullptr;
+    if (!pluginName.empty())
+    {
+        void* plugin = dlopen(pluginName.c_str(), RTLD_NOW);
+        if (nullptr == plugin)
+        {
+            std::cerr << "Error: cannot load plugin " << pluginName << ": " << dlerror() << std::endl;
+            return EXIT_FAILURE;
+        }
+        evalFunction = reinterpret_cast<PluginEvalFunction>(dlsym(plugin, PLUGIN_EVAL_FUNCTION_NAME));
+        if (nullptr == evalFunction)
+        {
+            std::cerr << "Error: function " << PLUGIN_EVAL_FUNCTION_NAME << " not found in plugin " << pluginName << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // A lost master must not terminate the worker.
+    signal(SIGPIPE, SIG_IGN);
+
+    NOMAD::Socket listener;
+    std::string errMsg;
+    if (!listener.listen(address, errMsg))
+    {
+        std::cerr << "Error: cannot listen on " << address << ": " << errMsg << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    NOMAD::ensureDirPath(tmpDir);
+    const std::string inputFile = tmpDir + "nomadworker." + std::to_string(getpid()) + ".input";
+
+    // One master at a time.
+    while (true)
+    {
+        auto master = listener.accept();
+        if (nullptr == master)
+        {
+            continue;
+        }
+        if (master->sendLine(NOMAD::SocketEvaluator::MSG_HELLO))
+        {
+            serve(*master, bbExe, evalFunction, inputFile);
+        }
+        master->close();
+    }
+
+    return EXIT_SUCCESS;
+}